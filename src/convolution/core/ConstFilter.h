@@ -0,0 +1,103 @@
+#ifndef CONVOLUTION_CORE_CONSTFILTER_H
+#define CONVOLUTION_CORE_CONSTFILTER_H
+
+#include <convolution/core/Filter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/math.h>
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace convolution {
+namespace core {
+
+/// \class ConstFilter
+/// \brief Implements a single channel 2D filter whose weights are known at compile time
+///
+///  The ConstFilter is a regular core::Filter and can be used with the Convolver, but in addition
+///  provides a direct convolution kernel that is generated from the constexpr weights:
+///    - zero taps are removed entirely
+///    - weights are multiplied as constants, which the compiler reduces to shifts for powers of two
+///    - all taps of the filter are fully unrolled
+///  The Convolver uses the direct kernel for single channel images through core::IDirectFilter, as long as the
+///  accumulator can't overflow for any image.
+///
+///  The weights are provided in row-major order and applied as cross-correlation, which matches
+///  the convention used by the Convolver.
+///
+/// \tparam T(typename) the data type used for the elements of the filter
+/// \tparam kHeight(uint32_t) filter height
+/// \tparam kWidth(uint32_t) filter width
+/// \tparam alignment(uint32_t) allows to force alignment of the column buffer
+/// \tparam kWeights(T...) the kHeight * kWidth filter weights in row-major order
+template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t alignment, T... kWeights>
+class ConstFilter : public Filter<T, kHeight, kWidth, 1, 1, alignment>,
+                    public IDirectFilter<uint8_t, AccumulatorT<uint8_t, T>>,
+                    public IDirectFilter<uint16_t, AccumulatorT<uint16_t, T>>,
+                    public IDirectFilter<float, AccumulatorT<float, T>> {
+ public:
+  using BaseT = Filter<T, kHeight, kWidth, 1, 1, alignment>;
+  static constexpr uint32_t kNumTaps = kHeight * kWidth;
+  static constexpr std::array<T, kNumTaps> kElements = {kWeights...};
+
+  static_assert(sizeof...(kWeights) == kNumTaps, "Number of weights doesn't match filter dimensions");
+
+  /// returns the number of non-zero taps, i.e. the number of multiply-accumulate operations per pixel
+  static constexpr uint32_t numNonZeroTaps() { return ((kWeights != 0 ? 1 : 0) + ...); }
+
+ private:
+  template <typename R, uint32_t idx, typename D>
+  static inline R tap(const D *src, const uint32_t stride);
+
+  template <typename R, typename D, size_t... idx>
+  static inline R accumulate(const D *src, const uint32_t stride, std::index_sequence<idx...>);
+
+  template <typename R, typename D>
+  static inline R accumulateClipped(const D *src, const int32_t x, const int32_t y, const int32_t width, const int32_t height);
+
+  template <typename R, typename D>
+  static constexpr bool fits();
+
+  template <typename R, typename D>
+  static bool applyIfFits(const D *src, R *dst, const uint32_t width, const uint32_t height);
+
+ public:
+  ConstFilter() : BaseT(typename BaseT::StorageT{kWeights...}) {}
+
+  template <typename R, typename D>
+  static void apply(const D *src, R *dst, const uint32_t width, const uint32_t height, const uint32_t channels = 1);
+
+  bool applyDirect(const uint8_t *src, AccumulatorT<uint8_t, T> *dst, const uint32_t width, const uint32_t height) const override { return applyIfFits(src, dst, width, height); }
+  bool applyDirect(const uint16_t *src, AccumulatorT<uint16_t, T> *dst, const uint32_t width, const uint32_t height) const override { return applyIfFits(src, dst, width, height); }
+  bool applyDirect(const float *src, AccumulatorT<float, T> *dst, const uint32_t width, const uint32_t height) const override { return applyIfFits(src, dst, width, height); }
+};
+
+/// 3x3 binomial blur, the result is scaled by 16
+template <typename T, uint32_t alignment = 1>
+using Binomial3x3 = ConstFilter<T, 3, 3, alignment, 1, 2, 1, 2, 4, 2, 1, 2, 1>;
+
+/// 5x5 binomial blur, the result is scaled by 256
+template <typename T, uint32_t alignment = 1>
+using Binomial5x5 = ConstFilter<T, 5, 5, alignment, 1, 4, 6, 4, 1, 4, 16, 24, 16, 4, 6, 24, 36, 24, 6, 4, 16, 24, 16, 4, 1, 4, 6, 4, 1>;
+
+/// 3x3 Laplacian, requires a signed weight type
+template <typename T, uint32_t alignment = 1>
+using Laplacian3x3 = ConstFilter<T, 3, 3, alignment, 0, 1, 0, 1, -4, 1, 0, 1, 0>;
+
+/// 3x3 horizontal Sobel operator, requires a signed weight type
+template <typename T, uint32_t alignment = 1>
+using SobelX3x3 = ConstFilter<T, 3, 3, alignment, -1, 0, 1, -2, 0, 2, -1, 0, 1>;
+
+/// 3x3 vertical Sobel operator, requires a signed weight type
+template <typename T, uint32_t alignment = 1>
+using SobelY3x3 = ConstFilter<T, 3, 3, alignment, -1, -2, -1, 0, 0, 0, 1, 2, 1>;
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/ConstFilter.inl>
+
+#endif  // CONVOLUTION_CORE_CONSTFILTER_H
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cstdint>
+
+namespace convolution {
+namespace core {
+
+/// \brief contribution of a single filter tap, resolved at compile time
+/// \tparam R(typename) accumulator type
+/// \tparam idx(uint32_t) row-major index of the tap in the filter
+/// \param src(const D *) image data at the top-left tap of the filter
+/// \param stride(const uint32_t) image width in pixels
+template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t alignment, T... kWeights>
+template <typename R, uint32_t idx, typename D>
+inline R ConstFilter<T, kHeight, kWidth, alignment, kWeights...>::tap(const D *src, const uint32_t stride) {
+  constexpr T weight = kElements[idx];
+  if constexpr (weight == 0) {
+    return R(0);
+  } else {
+    // multiplying by the constant lets the compiler emit shifts for powers of two, without shifting negative values
+    return static_cast<R>(src[(idx / kWidth) * stride + idx % kWidth]) * static_cast<R>(weight);
+  }
+}
+
+template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t alignment, T... kWeights>
+template <typename R, typename D, size_t... idx>
+inline R ConstFilter<T, kHeight, kWidth, alignment, kWeights...>::accumulate(const D *src, const uint32_t stride, std::index_sequence<idx...>) {
+  return (R(0) + ... + tap<R, idx>(src, stride));
+}
+
+/// \brief accumulate all taps of the filter centered at (x, y), taps outside of the image are treated as zero
+template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t alignment, T... kWeights>
+template <typename R, typename D>
+inline R ConstFilter<T, kHeight, kWidth, alignment, kWeights...>::accumulateClipped(const D *src, const int32_t x, const int32_t y, const int32_t width, const int32_t height) {
+  constexpr int32_t leftPadding = (kWidth - 1) / 2;
+  constexpr int32_t topPadding = (kHeight - 1) / 2;
+  R sum = 0;
+  for (uint32_t fy = 0; fy < kHeight; ++fy) {
+    const int32_t sy = y - topPadding + fy;
+    if (sy < 0 || sy >= height) {
+      continue;
+    }
+    for (uint32_t fx = 0; fx < kWidth; ++fx) {
+      const int32_t sx = x - leftPadding + fx;
+      if (sx >= 0 && sx < width) {
+        sum += static_cast<R>(src[(int64_t)sy * width + sx]) * static_cast<R>(kElements[fy * kWidth + fx]);
+      }
+    }
+  }
+  return sum;
+}
+
+/// \brief returns true if the accumulator R can't overflow for any image of data type D
+/// Every partial sum of the taps lies between the sums of the negative and the positive weights scaled by the largest pixel value.
+template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t alignment, T... kWeights>
+template <typename R, typename D>
+constexpr bool ConstFilter<T, kHeight, kWidth, alignment, kWeights...>::fits() {
+  if constexpr (std::is_floating_point_v<R>) {
+    return true;
+  } else if constexpr (std::is_floating_point_v<D>) {
+    return false;
+  } else {
+    const double positive = (0.0 + ... + (kWeights > 0 ? static_cast<double>(kWeights) : 0.0)) * std::numeric_limits<D>::max();
+    const double negative = (0.0 + ... + (kWeights < 0 ? static_cast<double>(kWeights) : 0.0)) * std::numeric_limits<D>::max();
+    return positive <= static_cast<double>(std::numeric_limits<R>::max()) && negative >= static_cast<double>(std::numeric_limits<R>::lowest());
+  }
+}
+
+/// \brief apply the direct kernel to a single channel image, unless the accumulator R may overflow
+/// \return bool true if dst holds the output, false if the kernel hasn't been applied
+template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t alignment, T... kWeights>
+template <typename R, typename D>
+bool ConstFilter<T, kHeight, kWidth, alignment, kWeights...>::applyIfFits(const D *src, R *dst, const uint32_t width, const uint32_t height) {
+  if constexpr (fits<R, D>()) {
+    apply<R>(src, dst, width, height);
+    return true;
+  } else {
+    return false;
+  }
+}
+
+/// \brief convolve a planar image with the filter, each channel is convolved independently
+/// \tparam R(typename) the C++ type used for the output and the accumulator
+/// \tparam D(typename) the C++ type used for the image data
+/// \param src(const D *) planar image buffer with channels * height * width elements
+/// \param dst(R *) planar output buffer with channels * height * width elements
+/// \param width(const uint32_t) image width in pixels
+/// \param height(const uint32_t) image height in pixels
+/// \param channels(const uint32_t) number of image channels
+template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t alignment, T... kWeights>
+template <typename R, typename D>
+void ConstFilter<T, kHeight, kWidth, alignment, kWeights...>::apply(const D *src, R *dst, const uint32_t width, const uint32_t height, const uint32_t channels) {
+  constexpr int32_t leftPadding = (kWidth - 1) / 2;
+  constexpr int32_t topPadding = (kHeight - 1) / 2;
+  const int32_t w = width;
+  const int32_t h = height;
+
+  // the range of positions for which all taps are inside of the image
+  const int32_t xBegin = std::min<int32_t>(leftPadding, w);
+  const int32_t xEnd = std::max<int32_t>(xBegin, w - leftPadding);
+  const int32_t yBegin = std::min<int32_t>(topPadding, h);
+  const int32_t yEnd = std::max<int32_t>(yBegin, h - topPadding);
+
+  for (uint32_t c = 0; c < channels; ++c) {
+    const D *plane = src + (uint64_t)c * width * height;
+    R *out = dst + (uint64_t)c * width * height;
+
+    for (int32_t y = 0; y < h; ++y) {
+      R *outLine = out + (int64_t)y * w;
+      if (y < yBegin || y >= yEnd) {
+        for (int32_t x = 0; x < w; ++x) {
+          outLine[x] = accumulateClipped<R>(plane, x, y, w, h);
+        }
+        continue;
+      }
+
+      const D *window = plane + (int64_t)(y - topPadding) * w - leftPadding;
+      int32_t x = 0;
+      for (; x < xBegin; ++x) {
+        outLine[x] = accumulateClipped<R>(plane, x, y, w, h);
+      }
+      for (; x < xEnd; ++x) {
+        outLine[x] = accumulate<R>(window + x, width, std::make_index_sequence<kNumTaps>());
+      }
+      for (; x < w; ++x) {
+        outLine[x] = accumulateClipped<R>(plane, x, y, w, h);
+      }
+    }
+  }
+}
+
+}  // namespace core
+}  // namespace convolution
@@ -0,0 +1,104 @@
+#ifndef CONVOLUTION_CORE_CONVOLUTIONCACHE_H
+#define CONVOLUTION_CORE_CONVOLUTIONCACHE_H
+
+#include <convolution/core/ConvolutionParams.h>
+#include <convolution/core/Convolver.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/hash.h>
+#include <convolution/core/img2col.h>
+#include <convolution/core/logging.h>
+#include <convolution/io/Image.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace convolution {
+namespace core {
+
+/// \brief parameters of the ConvolutionCache
+struct CacheParams {
+  size_t memoryBytes = size_t(256) << 20;  ///< capacity of the in-memory tier in bytes, outputs larger than the capacity are not kept in memory
+  fs::path directory;                      ///< directory of the on-disk tier storing the outputs as raw tensors, empty to disable the tier
+};
+
+/// \brief content address of a convolution, combining the hash of the input image and of the filter
+struct CacheKey {
+  uint64_t image = 0;   ///< hash of the pixels, size and layout of the input image
+  uint64_t filter = 0;  ///< hash of the weights and shape of the filter and of the convolution parameters
+
+  bool operator==(const CacheKey &rhs) const { return image == rhs.image && filter == rhs.filter; }
+};
+
+/// \brief hash functor of CacheKey for unordered containers
+struct CacheKeyHash {
+  size_t operator()(const CacheKey &key) const { return key.image ^ mix(key.filter); }
+};
+
+/// \class ConvolutionCache
+/// \brief content-addressed cache of convolution results in front of the Convolver
+///
+///  Each request is identified by the hash of the input pixels and the hash of the filter weights and shape. Repeated
+///  requests return the cached output without running img2col and the multiplication. Outputs are kept in a
+///  least-recently-used memory tier of bounded size and, if a directory is configured, as raw tensors on disk, which
+///  survive the process and are promoted into the memory tier when they are hit.
+///  The cache is not thread safe.
+///
+/// \tparam alignment(uint32_t) specifies the alignment of the column and filter buffer in support of the MxPxP multiplier to be used
+/// \tparam WeightT(typename) the C++ type used for the filter weights
+/// \tparam DataT(typename) the C++ type used for the image data
+template <uint32_t alignment, typename WeightT = uint8_t, typename DataT = uint8_t>
+class ConvolutionCache {
+ public:
+  using ConvolverT = Convolver<alignment, WeightT, DataT>;  ///< the convolver used on cache misses
+  using ImageT = typename ConvolverT::ImageT;                ///< the image type used for the input and output
+
+ private:
+  /// \brief cached output of a single convolution
+  struct Entry {
+    CacheKey key;   ///< content address of the convolution
+    ImageT output;  ///< planar output image with one channel per output channel of the filter
+  };
+  using LruT = std::list<Entry>;  ///< entries ordered from the most to the least recently used
+
+  CacheParams cacheParams;                                                    ///< capacity of the memory tier and directory of the disk tier
+  LruT lru;                                                                   ///< entries of the memory tier
+  std::unordered_map<CacheKey, typename LruT::iterator, CacheKeyHash> index;  ///< lookup of the entries of the memory tier
+  size_t bytes = 0;                                                           ///< size of the outputs in the memory tier
+  uint64_t memoryHits = 0;                                                    ///< number of requests served from the memory tier
+  uint64_t diskHits = 0;                                                      ///< number of requests served from the disk tier
+  uint64_t cacheMisses = 0;                                                   ///< number of requests convolved
+
+ protected:
+  CacheKey makeKey(const IFilter<WeightT> &filter, const ImageT &image, const ConvolutionParams &p) const;
+  fs::path filePath(const CacheKey &key) const;
+  bool readFile(const CacheKey &key, const uint32_t width, const uint32_t height, const uint32_t channels, ImageT &output) const;
+  void insert(const CacheKey &key, ImageT &&output);
+  static void copyOutput(const ImageT &src, ImageT &dst);
+
+ public:
+  explicit ConvolutionCache(const CacheParams &params = CacheParams());
+
+  bool operator()(std::shared_ptr<IFilter<WeightT>> filter, const ImageT &image, ImageT &output, const ConvolutionParams &p = ConvolutionParams());
+  void clear();
+
+  uint64_t hits() const { return memoryHits + diskHits; }  ///< returns the number of requests served from the cache
+  uint64_t numMemoryHits() const { return memoryHits; }    ///< returns the number of requests served from the memory tier
+  uint64_t numDiskHits() const { return diskHits; }        ///< returns the number of requests served from the disk tier
+  uint64_t misses() const { return cacheMisses; }          ///< returns the number of requests which have been convolved
+  size_t numEntries() const { return lru.size(); }         ///< returns the number of outputs in the memory tier
+  size_t memoryUsage() const { return bytes; }             ///< returns the size of the outputs in the memory tier in bytes
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/ConvolutionCache.inl>
+
+#endif  // CONVOLUTION_CORE_CONVOLUTIONCACHE_H
@@ -0,0 +1,185 @@
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <utility>
+
+namespace convolution {
+namespace core {
+
+/// \brief construct a ConvolutionCache
+/// \param params(const CacheParams &) capacity of the memory tier and directory of the disk tier, which is created if required
+template <uint32_t alignment, typename WeightT, typename DataT>
+ConvolutionCache<alignment, WeightT, DataT>::ConvolutionCache(const CacheParams &params) : cacheParams(params) {
+  if (!cacheParams.directory.empty()) {
+    std::error_code error;
+    fs::create_directories(cacheParams.directory, error);
+    if (error) {
+      spdlog::critical("Failed to create the cache directory {}: {}", cacheParams.directory.c_str(), error.message());
+      throw std::runtime_error("Failed to create the cache directory");
+    }
+  }
+}
+
+/// \brief convolve the image with the filter, or return the cached output of an identical request
+/// \param filter(std::shared_ptr<IFilter<WeightT>>) filter used for the convolution
+/// \param image(const ImageT &) input image, its channels must match the input channels of the filter
+/// \param output(ImageT &) receives a planar copy of the output with one channel per output channel of the filter
+/// \param p(const ConvolutionParams &) stride and dilation of the convolution
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool ConvolutionCache<alignment, WeightT, DataT>::operator()(std::shared_ptr<IFilter<WeightT>> filter, const ImageT &image, ImageT &output, const ConvolutionParams &p) {
+  if (!image.getImageBuffer() || image.getImageBuffer()->empty()) {
+    spdlog::error("Image is empty, failed to convolve the image.");
+    return false;
+  }
+
+  const CacheKey key = makeKey(*filter, image, p);
+  auto it = index.find(key);
+  if (it != index.end()) {
+    lru.splice(lru.begin(), lru, it->second);
+    copyOutput(it->second->output, output);
+    ++memoryHits;
+    return true;
+  }
+
+  const uint32_t outWidth = getOutputSize(image.width(), p.strideX);
+  const uint32_t outHeight = getOutputSize(image.height(), p.strideY);
+  const uint32_t numOutputChannels = filter->numOutputChannels();
+  ImageT result;
+  if (readFile(key, outWidth, outHeight, numOutputChannels, result)) {
+    // the file mapping is replaced by a copy in memory when the output is promoted into the memory tier
+    ImageT promoted;
+    copyOutput(result, promoted);
+    copyOutput(promoted, output);
+    insert(key, std::move(promoted));
+    ++diskHits;
+    return true;
+  }
+
+  ConvolverT conv(filter, p);
+  conv.setImage(image);
+  if (!conv.convolve()) {
+    return false;
+  }
+  result = ImageT(outWidth, outHeight, numOutputChannels);
+  if (!conv.store(result, 0, 0)) {
+    return false;
+  }
+  ++cacheMisses;
+
+  // the file is renamed once complete, so that concurrent processes sharing the directory never read partial outputs
+  if (!cacheParams.directory.empty()) {
+    const fs::path path = filePath(key);
+    fs::path tmpPath = path;
+    tmpPath += ".tmp";
+    std::error_code error;
+    if (result.writeRaw(tmpPath)) {
+      fs::rename(tmpPath, path, error);
+    }
+    if (error) {
+      spdlog::warn("Failed to store the output in the cache directory {}: {}", cacheParams.directory.c_str(), error.message());
+    }
+  }
+
+  copyOutput(result, output);
+  insert(key, std::move(result));
+  return true;
+}
+
+/// \brief remove all outputs from the memory tier and reset the counters, the disk tier is kept
+template <uint32_t alignment, typename WeightT, typename DataT>
+void ConvolutionCache<alignment, WeightT, DataT>::clear() {
+  lru.clear();
+  index.clear();
+  bytes = 0;
+  memoryHits = 0;
+  diskHits = 0;
+  cacheMisses = 0;
+}
+
+/// \brief compute the content address of convolving the image with the filter
+/// The image hash covers the size and layout of the image, the filter hash the shape of the filter and the sampling
+/// parameters, and both the data and weight types, so that requests with identical buffers of a different interpretation
+/// don't collide, e.g. int8_t and uint8_t weights sharing the disk tier. The filter is hashed in the aligned column buffer
+/// format, which is the buffer read by the convolution.
+template <uint32_t alignment, typename WeightT, typename DataT>
+CacheKey ConvolutionCache<alignment, WeightT, DataT>::makeKey(const IFilter<WeightT> &filter, const ImageT &image, const ConvolutionParams &p) const {
+  const uint64_t types = typeIdentity<DataT>() | (typeIdentity<WeightT>() << 16);
+
+  const uint32_t imageShape[4] = {image.width(), image.height(), image.channels(), static_cast<uint32_t>(image.layout())};
+  const uint64_t imageSize = image.pixels() * image.channels() * sizeof(DataT);
+
+  const uint32_t filterShape[9] = {filter.height(), filter.width(), filter.numInputChannels(), filter.numOutputChannels(), filter.numGroups(), p.strideX, p.strideY, p.dilationX, p.dilationY};
+  const uint64_t K = getAlignedSize<uint32_t, alignment>(filter.height() * filter.width() * filter.numInputChannels());
+  const uint64_t N = getAlignedSize<uint32_t, alignment>(filter.numOutputChannels() / filter.numGroups());
+  const uint64_t filterSize = filter.numGroups() * K * N * sizeof(WeightT);
+
+  CacheKey key;
+  key.image = hash(image.getImageBuffer()->data(), imageSize, hash(imageShape, sizeof(imageShape), types));
+  key.filter = hash(filter.getColumnBuffer(), filterSize, hash(filterShape, sizeof(filterShape), types));
+  return key;
+}
+
+/// \brief returns the path of the raw tensor storing the output of key in the disk tier
+template <uint32_t alignment, typename WeightT, typename DataT>
+fs::path ConvolutionCache<alignment, WeightT, DataT>::filePath(const CacheKey &key) const {
+  char name[48];
+  std::snprintf(name, sizeof(name), "%016" PRIx64 "%016" PRIx64 ".raw", key.image, key.filter);
+  return cacheParams.directory / name;
+}
+
+/// \brief read the output of key from the disk tier, outputs which don't match the expected size are ignored
+/// \return bool true if the output has been read, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool ConvolutionCache<alignment, WeightT, DataT>::readFile(const CacheKey &key, const uint32_t width, const uint32_t height, const uint32_t channels, ImageT &output) const {
+  if (cacheParams.directory.empty()) {
+    return false;
+  }
+
+  const fs::path path = filePath(key);
+  std::error_code error;
+  if (!fs::exists(path, error) || !output.readRaw(path)) {
+    return false;
+  }
+
+  if (output.width() != width || output.height() != height || output.channels() != channels) {
+    spdlog::warn("Cached output {} {}x{}x{} doesn't match the expected size {}x{}x{}.", path.c_str(), output.width(), output.height(), output.channels(), width, height, channels);
+    return false;
+  }
+  return true;
+}
+
+/// \brief insert the output into the memory tier and evict the least recently used outputs exceeding the capacity
+template <uint32_t alignment, typename WeightT, typename DataT>
+void ConvolutionCache<alignment, WeightT, DataT>::insert(const CacheKey &key, ImageT &&output) {
+  const size_t size = output.pixels() * output.channels() * sizeof(DataT);
+  if (size > cacheParams.memoryBytes) {
+    return;
+  }
+
+  lru.push_front(Entry{key, std::move(output)});
+  index[key] = lru.begin();
+  bytes += size;
+
+  while (bytes > cacheParams.memoryBytes) {
+    const Entry &last = lru.back();
+    bytes -= last.output.pixels() * last.output.channels() * sizeof(DataT);
+    index.erase(last.key);
+    lru.pop_back();
+  }
+}
+
+/// \brief copy the planar output src into dst, the buffer of dst is reused if it has the same size
+template <uint32_t alignment, typename WeightT, typename DataT>
+void ConvolutionCache<alignment, WeightT, DataT>::copyOutput(const ImageT &src, ImageT &dst) {
+  if (!dst.getImageBuffer() || dst.getImageBuffer().use_count() > 1 || dst.width() != src.width() || dst.height() != src.height() || dst.channels() != src.channels() || dst.layout() != src.layout()) {
+    dst = ImageT(src.width(), src.height(), src.channels(), src.layout());
+  }
+  std::copy_n(src.getImageBuffer()->data(), src.pixels() * src.channels(), dst.getImageBuffer()->data());
+}
+
+}  // namespace core
+}  // namespace convolution
@@ -0,0 +1,39 @@
+#ifndef CONVOLUTION_CORE_CONVOLUTIONPARAMS_H
+#define CONVOLUTION_CORE_CONVOLUTIONPARAMS_H
+
+#include <cstdint>
+
+namespace convolution {
+namespace core {
+
+/// \brief statistics of the output channels collected by each convolution, see Convolver::getStats()
+enum class Statistics {
+  kNone,       ///< no statistics
+  kRange,      ///< minimum, maximum and sum of each output channel
+  kHistogram,  ///< kRange and a histogram of each output channel over the range the filter can produce
+};
+
+/// \brief sampling parameters of the convolution, and the engine selection and output settings of the Convolver
+/// The output pixel (ox, oy) is centered at the input pixel (ox * strideX, oy * strideY) and the filter taps
+/// are spaced dilationX and dilationY pixels apart.
+struct ConvolutionParams {
+  uint32_t strideX = 1;                       ///< horizontal distance between output pixels in the input image
+  uint32_t strideY = 1;                       ///< vertical distance between output pixels in the input image
+  uint32_t dilationX = 1;                     ///< horizontal distance between filter taps
+  uint32_t dilationY = 1;                     ///< vertical distance between filter taps
+  float sparseDensity = 0.5;                  ///< filters with a lower fraction of non-zero weights in the aligned filter only apply those, 0 always multiplies all weights
+  bool boxFilters = true;                     ///< filters with constant weights over the filter window sum the window instead of multiplying all weights
+  Statistics statistics = Statistics::kNone;  ///< statistics of the output channels collected while the output is stored
+};
+
+inline bool operator==(const ConvolutionParams &lhs, const ConvolutionParams &rhs) {
+  return lhs.strideX == rhs.strideX && lhs.strideY == rhs.strideY && lhs.dilationX == rhs.dilationX && lhs.dilationY == rhs.dilationY && lhs.sparseDensity == rhs.sparseDensity &&
+         lhs.boxFilters == rhs.boxFilters && lhs.statistics == rhs.statistics;
+}
+
+inline bool operator!=(const ConvolutionParams &lhs, const ConvolutionParams &rhs) { return !(lhs == rhs); }
+
+}  // namespace core
+}  // namespace convolution
+
+#endif  // CONVOLUTION_CORE_CONVOLUTIONPARAMS_H
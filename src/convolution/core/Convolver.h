@@ -1,49 +1,128 @@
 #ifndef CONVOLUTION_CORE_CONVOLVER_H
 #define CONVOLUTION_CORE_CONVOLVER_H
 
+#include <convolution/core/ConvolutionParams.h>
 #include <convolution/core/Filter.h>
+#include <convolution/core/box.h>
+#include <convolution/core/img2col.h>
 #include <convolution/core/logging.h>
+#include <convolution/core/pointwise.h>
+#include <convolution/core/sparse.h>
+#include <convolution/core/stats.h>
 #include <convolution/io/Image.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <thread>
+#include <limits>
+#include <string>
+#include <optional>
+#include <type_traits>
 #include <vector>
 
 namespace convolution {
 namespace core {
 
+/// \brief reduction applied to each pooling window of the convolution output
+enum class Pooling {
+  kMax,      ///< maximum of the window
+  kAverage,  ///< average of the window, truncated for integral outputs
+};
+
+/// \brief parameters of the output files written by Convolver::write
+struct OutputParams {
+  uint32_t channelsPerFile = 1;  ///< consecutive output channels packed into a single PNG file, 1 to 4
+  uint32_t threads = 0;          ///< number of files encoded in parallel, 0 uses one thread per hardware thread
+  io::PngParams png;             ///< compression level and row filters of the PNG encoder
+  bool normalize = false;        ///< rescale each output channel from its minimum and maximum to the image data range instead of narrowing
+};
+
 /// \class Convolver
-/// \brief A class to convolve 8Bit image data with an 8Bit 4D filter using a 16Bit accumulator
+/// \brief A class to convolve image data with a 4D filter
+/// The accumulator type is selected by core::Accumulator, integral results are narrowed to the image data type on output.
 /// \tparam alignment(uint32_t) specifies the alignment of the column and filter buffer in support of the MxPxP multiplier to be used
-template <uint32_t alignment>
+/// \tparam WeightT(typename) the C++ type used for the filter weights, e.g. uint8_t, int8_t, uint16_t or float
+/// \tparam DataT(typename) the C++ type used for the image data, uint8_t, uint16_t or float
+template <uint32_t alignment, typename WeightT = uint8_t, typename DataT = uint8_t>
 class Convolver {
  public:
-  using ColumnDataT = uint8_t;                             ///< the C++ type used to represent a single input channel pixel
+  using ImageT = io::BasicImage<DataT>;                    ///< the image type used for input and output
+  using ColumnDataT = DataT;                               ///< the C++ type used to represent a single input channel pixel
+  using FilterDataT = WeightT;                             ///< the C++ type used to represent a single filter weight
   using ColumnBufferT = std::vector<ColumnDataT>;          ///< the storage format used by the input column buffer
   using ColumnBufferPtr = std::shared_ptr<ColumnBufferT>;  ///< shared pointer to the column buffer
 
-  using TransformDataT = uint16_t;                               ///< the C++ type used to represent a single output channel pixel
+  using TransformDataT = AccumulatorT<DataT, WeightT>;           ///< the C++ type used to represent a single output channel pixel
   using TransformBufferT = std::vector<TransformDataT>;          ///< the storage format used by the output transform buffer
   using TransformBufferPtr = std::shared_ptr<TransformBufferT>;  ///< shared pointer to the transform buffer
 
  private:
   ColumnBufferPtr colBufferPtr = std::make_shared<ColumnBufferT>();              ///< the column buffer is used to store the result of transforming the image into column format
   TransformBufferPtr transformBufferPtr = std::make_shared<TransformBufferT>();  ///< the transform buffer is used to store the results of multiplying the column buffer with the filter
-  std::shared_ptr<IFilter<ColumnDataT>> filterPtr;                               ///< filter used for the convolution
-  io::Image img;                                                                 ///< image used for the convolution
+  std::shared_ptr<IFilter<FilterDataT>> filterPtr;                               ///< filter used for the convolution
+  ImageT img;                                                                    ///< image used for the convolution
+  ConvolutionParams params;                                                      ///< stride and dilation of the convolution
+  ColumnShape shape;                                                             ///< image and filter dimensions resolved for the current image
+  std::optional<Region> region;                                                  ///< output region to transform, the whole output if not set
+  std::vector<FilterDataT> interleavedFilter;                                    ///< filter permuted to the column buffer order of interleaved images
+  std::vector<FilterDataT> multBuffer;                                           ///< scratch buffer of core::mult
+  ColumnBufferT columnScratch;                                                   ///< scratch buffer of the column buffer transpose
+  TransformBufferT transformScratch;                                             ///< scratch buffer of the transform buffer transpose
+  TransformBufferT groupBuffer;                                                  ///< output of a single filter group of grouped convolutions
+  std::vector<SparseFilter<FilterDataT>> sparseGroups;                           ///< non-zero weights of each filter group
+  bool sparse = false;                                                           ///< the last convolution applied the non-zero weights only
+  std::vector<FilterDataT> channelWeights;                                       ///< weight of each pair of channels of box filters
+  std::vector<int64_t> rowSums;                                                  ///< scratch buffer of the row sums of box filters
+  std::vector<int64_t> boxSums;                                                  ///< scratch buffer of the window sums of box filters
+  bool boxFilter = false;                                                        ///< the last convolution summed the filter windows of a box filter
+  bool directKernel = false;                                                     ///< the last convolution used the direct kernel of the filter
+  std::vector<ChannelStats<TransformDataT>> outputStats;                         ///< statistics of the output channels of the last convolution
 
  protected:
+  void updateShape();
+
   template <core::MatrixOrder order = core::MatrixOrder::kRowMajor>
-  bool img2col();
+  bool img2col(const uint32_t group = 0);
 
-  bool read(const fs::path &path);
+  bool validate(const Region &r) const;
+  bool convolvePointwise();
+  bool convolveDirect(const IDirectFilter<ColumnDataT, TransformDataT> &direct);
+  bool convolveBox();
+  bool compressFilter(const FilterDataT *filterBuffer);
+  void resetStats();
+  void collectStats(const TransformDataT *data, const uint32_t numPixels);
+
+  static ColumnDataT narrow(const TransformDataT value);
 
-  uint32_t calcColumnBufferOffset(const uint32_t ix, const uint32_t iy, const uint32_t ic, const uint32_t fx, const uint32_t fy) const;
+  uint64_t calcColumnBufferOffset(const uint32_t ix, const uint32_t iy, const uint32_t ic, const uint32_t fx, const uint32_t fy) const;
 
+  const FilterDataT *getFilterBuffer();
   ColumnBufferPtr getColumnBuffer() const;
   TransformBufferPtr getTransformBuffer() const;
 
  public:
-  explicit Convolver(std::shared_ptr<IFilter<ColumnDataT>> f) : filterPtr(f), img() {}
-  void operator()(const fs::path &path);
+  explicit Convolver(std::shared_ptr<IFilter<FilterDataT>> f, const ConvolutionParams &p = ConvolutionParams());
+  void operator()(const fs::path &path, const OutputParams &outputParams = OutputParams());
+
+  bool read(const fs::path &path);
+  void setImage(const ImageT &image);
+
+  bool convolve();
+  bool convolve(const Region &r);
+  bool convolve(const std::vector<Region> &regions, std::vector<TransformBufferT> &outputs);
+  bool convolve(const Pooling pooling, const uint32_t poolSize = 2);
+
+  bool store(ImageT &out, const uint32_t x, const uint32_t y, const bool normalize = false) const;
+  bool write(const fs::path &prefix, const OutputParams &params = OutputParams()) const;
+
+  bool isSparse() const { return sparse; }        ///< returns true if the last convolution applied the non-zero weights of the filter only
+  bool isBox() const { return boxFilter; }         ///< returns true if the last convolution summed the filter windows of a box filter
+  bool isDirect() const { return directKernel; }  ///< returns true if the last convolution used the direct kernel of the filter, see core::IDirectFilter
+
+  /// \brief returns the statistics of the output channels of the last convolution, empty unless ConvolutionParams::statistics requests them
+  const std::vector<ChannelStats<TransformDataT>> &getStats() const { return outputStats; }
 };
 
 }  // namespace core
@@ -1,29 +1,68 @@
 namespace convolution {
 namespace core {
 
+/// \brief construct a Convolver for the filter and sampling parameters provided
+/// \param f(std::shared_ptr<IFilter<FilterDataT>>) filter used for the convolution
+/// \param p(const ConvolutionParams &) stride and dilation of the convolution
+template <uint32_t alignment, typename WeightT, typename DataT>
+Convolver<alignment, WeightT, DataT>::Convolver(std::shared_ptr<IFilter<FilterDataT>> f, const ConvolutionParams &p) : filterPtr(f), img(), params(p) {
+  if (params.strideX == 0 || params.strideY == 0 || params.dilationX == 0 || params.dilationY == 0) {
+    spdlog::critical("Stride {}x{} and dilation {}x{} must be positive.", params.strideX, params.strideY, params.dilationX, params.dilationY);
+    throw std::invalid_argument("Stride and dilation must be positive");
+  }
+}
+
 /// \brief calculate an offset into the column buffer
 /// \see http://15418.courses.cs.cmu.edu/fall2017/lecture/dnn/slide_023
-/// \param img_x(const uint32_t) pixel position along the horizontal width of the image in row-major format
-/// \param img_y(const uint32_t) pixel position along the vertical height of the image in row-major format
+/// \param img_x(const uint32_t) output pixel position along the horizontal width of the image in row-major format
+/// \param img_y(const uint32_t) output pixel position along the vertical height of the image in row-major format
 /// \param img_c(const uint32_t) pixel channel
 /// \param filter_x(const uint32_t) filter position along the horizontal width of the filter in row-major format
 /// \param filter_y(const uint32_t) filter position along the vertical height of the filter in row-major format
 /// \return the offset into the column buffer
-template <uint32_t alignment>
-uint32_t Convolver<alignment>::calcColumnBufferOffset(const uint32_t img_x, const uint32_t img_y, const uint32_t img_c, const uint32_t filter_x, const uint32_t filter_y) const {
-  const uint32_t pixelIndex = img.width() * img_y + img_x;
-  const uint32_t filterSize = filterPtr->width() * filterPtr->height();
-  const uint32_t columBufferWidthAligned = core::getAlignedSize<uint32_t, alignment>(filterSize * img.channels());
-  return pixelIndex * columBufferWidthAligned + img_c * filterSize + filterPtr->width() * filter_y + filter_x;
+template <uint32_t alignment, typename WeightT, typename DataT>
+uint64_t Convolver<alignment, WeightT, DataT>::calcColumnBufferOffset(const uint32_t img_x, const uint32_t img_y, const uint32_t img_c, const uint32_t filter_x, const uint32_t filter_y) const {
+  const uint64_t pixelIndex = static_cast<uint64_t>(shape.outWidth) * img_y + img_x;
+  if (shape.interleaved) {
+    return pixelIndex * shape.columnBufferWidthAligned + (shape.filterWidth * filter_y + filter_x) * shape.imgChannels + img_c;
+  }
+  return pixelIndex * shape.columnBufferWidthAligned + img_c * shape.filterSize() + shape.filterWidth * filter_y + filter_x;
+}
+
+/// \brief resolve the image and filter dimensions once per image
+/// The output dimensions cover the active region if set, or the whole output image otherwise.
+/// All hot loops use the cached shape instead of querying the filter through the IFilter interface.
+template <uint32_t alignment, typename WeightT, typename DataT>
+void Convolver<alignment, WeightT, DataT>::updateShape() {
+  const IFilter<FilterDataT> &filter = *filterPtr;
+  shape.imgWidth = img.width();
+  shape.imgHeight = img.height();
+  shape.imgChannels = filter.numInputChannels();
+  shape.filterWidth = filter.width();
+  shape.filterHeight = filter.height();
+  shape.leftPadding = filter.leftPadding() * params.dilationX;
+  shape.topPadding = filter.topPadding() * params.dilationY;
+  shape.strideX = params.strideX;
+  shape.strideY = params.strideY;
+  shape.dilationX = params.dilationX;
+  shape.dilationY = params.dilationY;
+  shape.outOffsetX = region ? region->x : 0;
+  shape.outOffsetY = region ? region->y : 0;
+  shape.outWidth = region ? region->width : getOutputSize(shape.imgWidth, params.strideX);
+  shape.outHeight = region ? region->height : getOutputSize(shape.imgHeight, params.strideY);
+  shape.columnBufferWidthAligned = core::getAlignedSize<uint32_t, alignment>(shape.filterSize() * shape.imgChannels);
+  shape.interleaved = img.layout() == io::Layout::kInterleaved;
 }
 
 /// \brief convert a multi-channel image into column buffer format suitable to support convolution
+/// For grouped filters the column buffer only covers the input channels of a single group.
 /// \see http://15418.courses.cs.cmu.edu/fall2017/lecture/dnn/slide_023
 /// \tparam order(core::MatrixOrder) the matrix order to be used by the column buffer in support of the matrix-matrix multiplication
+/// \param group(const uint32_t) the filter group to transform
 /// \return bool true on success, false otherwise
-template <uint32_t alignment>
+template <uint32_t alignment, typename WeightT, typename DataT>
 template <core::MatrixOrder order>
-bool Convolver<alignment>::img2col() {
+bool Convolver<alignment, WeightT, DataT>::img2col(const uint32_t group) {
   auto imgBufferPtr = img.getImageBuffer();
 
   if (!imgBufferPtr) {
@@ -36,135 +75,729 @@ bool Convolver<alignment>::img2col() {
     return false;
   }
 
-  IFilter<ColumnDataT> &filter = *filterPtr;
+  // the channels of a group are not contiguous in interleaved pixels, grouped filters require a planar image
+  const uint32_t numGroups = filterPtr->numGroups();
+  if (numGroups > 1 && img.layout() == io::Layout::kInterleaved) {
+    spdlog::debug("Converting interleaved image into planar layout for {} filter groups.", numGroups);
+    img.convert(io::Layout::kPlanar);
+    imgBufferPtr = img.getImageBuffer();
+  }
 
-  const uint32_t imgWidth = img.width();
-  const uint32_t imgHeight = img.height();
-  const uint32_t imgChannels = img.channels();
-  const uint32_t filterWidth = filter.width();
-  const uint32_t filterHeight = filter.height();
-  const uint32_t paddingWidth = filter.leftPadding();
-  const uint32_t paddingHeight = filter.topPadding();
-  const uint32_t columnBufferWidth = filterWidth * filterHeight * img.channels();
-  const uint32_t columnBufferHeight = img.pixels();
-  const uint32_t columnBufferWidthAligned = core::getAlignedSize<uint32_t, alignment>(columnBufferWidth);
+  updateShape();
 
-  // create and clear a line buffer with sufficient space for left and right padding
-  std::vector<ColumnDataT> lineBuffer(imgWidth + filterWidth - 1);
-  std::fill(lineBuffer.begin(), lineBuffer.end(), 0);
+  if (img.channels() != numGroups * shape.imgChannels) {
+    spdlog::error("Image channels ({}) don't match filter input channels {}x{}.", img.channels(), numGroups, shape.imgChannels);
+    return false;
+  }
+
+  if (group >= numGroups) {
+    spdlog::error("Filter group {} is out of range [0,{}].", group, numGroups - 1);
+    return false;
+  }
+
+  const uint32_t columnBufferHeight = shape.outputPixels();
+  const uint32_t columnBufferWidthAligned = shape.columnBufferWidthAligned;
 
   // resize and clear the column buffer
-  colBufferPtr->resize(columnBufferHeight * columnBufferWidthAligned);
+  colBufferPtr->resize(static_cast<size_t>(columnBufferHeight) * columnBufferWidthAligned);
   std::fill(colBufferPtr->begin(), colBufferPtr->end(), 0);
 
+  // dispatch to a kernel specialized for the filter shape, or the generic kernel otherwise
+  Img2ColKernel<ColumnDataT> kernel = selectImg2ColKernel<ColumnDataT>(shape);
+  kernel(shape, imgBufferPtr->data() + static_cast<uint64_t>(group) * shape.imgChannels * shape.pixels(), colBufferPtr->data());
+
+  // in case kColumnMajor format is requested we need to transpose the column buffer
+  if constexpr (order == core::MatrixOrder::kColumnMajor) {
+    const uint32_t N = columnBufferWidthAligned;
+    const uint32_t M = shape.outputPixels();
+    columnScratch.resize(colBufferPtr->size());
+    core::transpose<ColumnDataT, core::MatrixOrder::kRowMajor>(M, N, colBufferPtr->data(), columnScratch.data());
+  }
+
+  return true;
+}
+
+/// \brief convolve the image previously read with the filter
+/// The result is stored in the transform buffer in row-major order, with one row of aligned output channels per output pixel.
+/// Only the output pixels selected by the stride are computed.
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::convolve() {
+  // the engine flags describe the last convolution, each engine sets its own below
+  sparse = false;
+  boxFilter = false;
+  directKernel = false;
+
+  // pointwise filters are applied to the planar image directly, without column buffer and transposes
+  if (filterPtr->height() == 1 && filterPtr->width() == 1 && filterPtr->numGroups() == 1) {
+    return convolvePointwise();
+  }
+
+  // filters with a direct kernel, e.g. a core::ConstFilter, convolve single channel images without column buffer and multiplication
+  if (const auto *direct = dynamic_cast<const IDirectFilter<ColumnDataT, TransformDataT> *>(filterPtr.get()); direct && convolveDirect(*direct)) {
+    return true;
+  }
+
+  // box filters sum the filter window of each input channel, with a cost independent of the filter size, integral sums are exact
+  boxFilter = std::is_integral_v<TransformDataT> && params.boxFilters && filterPtr->template getChannelWeights<alignment>(channelWeights);
+  if (boxFilter) {
+    return convolveBox();
+  }
+
+  // transform the image data into column buffer format using column-major order in support of core::mult()
+  if (!img2col<core::MatrixOrder::kColumnMajor>()) {
+    return false;
+  }
+
+  const FilterDataT *filterBuffer = getFilterBuffer();
+
+  // the filter may change between convolutions, compressing it costs O(KxN) compared to O(MxKxN) of the multiplication
+  sparse = compressFilter(filterBuffer);
+
+  const uint32_t numGroups = filterPtr->numGroups();
+  const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+  const uint32_t M = shape.outputPixels();
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(numOutputChannels);
+  const uint32_t K = core::getAlignedSize<uint32_t, alignment>(shape.filterSize() * filterPtr->numInputChannels());
+
+  // resize and clear the transform buffer
+  auto output = getTransformBuffer();
+  output->resize(static_cast<size_t>(M) * N);
+  std::fill(output->begin(), output->end(), 0);
+
+  // overflow detection is only available for integral accumulators
+  constexpr bool useOverflowDetection = std::is_integral_v<TransformDataT>;
+  // the scratch buffers are kept between convolutions, so that repeated convolutions of the same size don't allocate
+  multBuffer.resize(2 * static_cast<size_t>(N) * alignment);
+  auto multiply = [&](const uint32_t n, TransformDataT *c, const FilterDataT *b, const uint32_t group) {
+    bool didNotOverflow = true;
+    if (sparse) {
+      didNotOverflow = core::sparseMult<TransformDataT, ColumnDataT, FilterDataT, useOverflowDetection>(M, c, colBufferPtr->data(), sparseGroups[group]);
+    } else {
+      didNotOverflow = core::mult<TransformDataT, ColumnDataT, core::MatrixOrder::kColumnMajor, core::MatrixOrder::kColumnMajor, core::MatrixOrder::kRowMajor, alignment, useOverflowDetection>(M, n, K, c, colBufferPtr->data(), b, multBuffer.data());
+    }
+    if (!didNotOverflow) {
+      spdlog::critical("Overflow detected in core::mult");
+      throw "Overflow detected in core::mult";
+    }
+  };
+
+  if (numGroups == 1) {
+    multiply(N, output->data(), filterBuffer, 0);
+  } else {
+    // grouped convolution: each group multiplies its own column buffer with its own KxNg block of the filter
+    const uint32_t outputChannelsPerGroup = numOutputChannels / numGroups;
+    const uint32_t Ng = core::getAlignedSize<uint32_t, alignment>(outputChannelsPerGroup);
+    groupBuffer.resize(static_cast<size_t>(M) * Ng);
+
+    for (uint32_t group = 0; group < numGroups; ++group) {
+      if (group > 0 && !img2col<core::MatrixOrder::kColumnMajor>(group)) {
+        return false;
+      }
+      std::fill(groupBuffer.begin(), groupBuffer.end(), 0);
+      multiply(Ng, groupBuffer.data(), filterBuffer + group * K * Ng, group);
+
+      // copy the output channels of the group into the column-major transform buffer
+      for (uint32_t oc = 0; oc < outputChannelsPerGroup; ++oc) {
+        std::copy_n(groupBuffer.data() + static_cast<uint64_t>(oc) * M, M, output->data() + static_cast<uint64_t>(group * outputChannelsPerGroup + oc) * M);
+      }
+    }
+  }
+
+  transformScratch.resize(output->size());
+  if (params.statistics == Statistics::kNone) {
+    core::transpose<TransformDataT, core::MatrixOrder::kColumnMajor>(M, N, output->data(), transformScratch.data());
+    return true;
+  }
+
+  // the statistics are collected by the transpose, which reads each output channel contiguously from the column-major output
+  resetStats();
+  for (uint32_t n = 0; n < N; ++n) {
+    const TransformDataT *src = output->data() + static_cast<uint64_t>(n) * M;
+    TransformDataT *dst = transformScratch.data() + n;
+    if (n < numOutputChannels) {
+      ChannelStats<TransformDataT> &stats = outputStats[n];
+      for (uint32_t m = 0; m < M; ++m) {
+        stats.add(src[m]);
+        dst[static_cast<uint64_t>(m) * N] = src[m];
+      }
+    } else {
+      for (uint32_t m = 0; m < M; ++m) {
+        dst[static_cast<uint64_t>(m) * N] = src[m];
+      }
+    }
+  }
+  output->swap(transformScratch);
+  return true;
+}
+
+/// \brief convolve the image previously read with a 1x1 filter
+/// The filter is a small color matrix applied to each output pixel, which core::pointwise streams through the planar
+/// image channels once and writes directly into the transform buffer, in the same layout as convolve().
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::convolvePointwise() {
+  auto imgBufferPtr = img.getImageBuffer();
+  if (!imgBufferPtr || imgBufferPtr->empty()) {
+    spdlog::error("Image buffer is empty, failed to convolve the image.");
+    return false;
+  }
+
+  updateShape();
+  if (img.channels() != shape.imgChannels) {
+    spdlog::error("Image channels ({}) don't match filter input channels {}.", img.channels(), shape.imgChannels);
+    return false;
+  }
+
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(filterPtr->numOutputChannels());
+
+  // resize and clear the transform buffer
+  auto output = getTransformBuffer();
+  output->resize(static_cast<size_t>(shape.outputPixels()) * N);
+  std::fill(output->begin(), output->end(), 0);
+
+  constexpr bool useOverflowDetection = std::is_integral_v<TransformDataT>;
+  if (!core::pointwise<TransformDataT, ColumnDataT, FilterDataT, alignment, useOverflowDetection>(shape, imgBufferPtr->data(), filterPtr->getColumnBuffer(), N, output->data())) {
+    spdlog::critical("Overflow detected in core::pointwise");
+    throw "Overflow detected in core::pointwise";
+  }
+
+  if (params.statistics != Statistics::kNone) {
+    resetStats();
+    collectStats(output->data(), shape.outputPixels());
+  }
+  return true;
+}
+
+/// \brief convolve the image previously read with the direct kernel of the filter
+/// The kernel covers the whole output of a single channel image with a stride and dilation of 1 and writes a planar
+/// output, which is spread into the rows of aligned output channels of the transform buffer.
+/// \param direct(const IDirectFilter<ColumnDataT, TransformDataT> &) the direct kernel of the filter
+/// \return bool true if the kernel has been applied, false if the image or parameters require convolve() instead
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::convolveDirect(const IDirectFilter<ColumnDataT, TransformDataT> &direct) {
+  auto imgBufferPtr = img.getImageBuffer();
+  if (region || img.channels() != 1 || !imgBufferPtr || imgBufferPtr->empty() || params.strideX != 1 || params.strideY != 1 || params.dilationX != 1 || params.dilationY != 1) {
+    return false;
+  }
+
+  updateShape();
+  const uint32_t M = shape.outputPixels();
+  transformScratch.resize(M);
+  if (!direct.applyDirect(imgBufferPtr->data(), transformScratch.data(), shape.imgWidth, shape.imgHeight)) {
+    return false;
+  }
+
   // resize and clear the transform buffer
-  transformBufferPtr->resize(img.pixels() * core::getAlignedSize<uint32_t, alignment>(filter.numOutputChannels()));
-  std::fill(transformBufferPtr->begin(), transformBufferPtr->end(), 0);
-
-  // iterate over each channel
-  for (uint32_t img_c = 0; img_c < imgChannels; ++img_c) {
-    // iterate over image line-by-line vertically
-    for (uint32_t img_y = 0; img_y < imgHeight; ++img_y) {
-      // copy current image line into the lineBuffer and add horizontal padding
-      uint32_t imgOffset = img.calcImageBufferOffset(0, img_y, img_c);
-      memcpy(lineBuffer.data() + paddingWidth, imgBufferPtr->data() + imgOffset, imgWidth);
-      auto bgn = lineBuffer.begin();
-      // iterate over the current image line pixel-by-pixel horizontally
-      for (uint32_t img_x = 0; img_x < imgWidth; ++img_x, ++bgn) {
-        // iterate vertical over the filter
-        for (uint32_t filter_y = 0; filter_y < filterHeight; ++filter_y) {
-          // each filter_y position corresponds to a single copy of the data at position bgn into the column buffer
-          // calculate the destination line in the image for the current copy
-          const int32_t dst_y = img_y - paddingHeight + filter_y;
-          if (dst_y >= 0 && dst_y < (int32_t)imgHeight) {
-            auto wIt = (*colBufferPtr).begin() + calcColumnBufferOffset(img_x, dst_y, img_c, 0, filterHeight - filter_y - 1);
-            std::copy(bgn, bgn + filterWidth, wIt);
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(1);
+  auto output = getTransformBuffer();
+  output->resize(static_cast<size_t>(M) * N);
+  std::fill(output->begin(), output->end(), 0);
+  for (uint32_t m = 0; m < M; ++m) {
+    (*output)[static_cast<uint64_t>(m) * N] = transformScratch[m];
+  }
+
+  directKernel = true;
+  if (params.statistics != Statistics::kNone) {
+    resetStats();
+    collectStats(output->data(), M);
+  }
+  return true;
+}
+
+/// \brief convolve the image previously read with a box filter, whose weights are constant over the filter window
+/// core::box sums the filter window of each input channel with running sums and writes the weighted window sums
+/// directly into the transform buffer, in the same layout as convolve(), without column buffer and transposes.
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::convolveBox() {
+  auto imgBufferPtr = img.getImageBuffer();
+  if (!imgBufferPtr || imgBufferPtr->empty()) {
+    spdlog::error("Image buffer is empty, failed to convolve the image.");
+    return false;
+  }
+
+  updateShape();
+  const uint32_t numGroups = filterPtr->numGroups();
+  if (img.channels() != numGroups * shape.imgChannels) {
+    spdlog::error("Image channels ({}) don't match filter input channels {}x{}.", img.channels(), numGroups, shape.imgChannels);
+    return false;
+  }
+
+  const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(numOutputChannels);
+
+  // resize and clear the transform buffer
+  auto output = getTransformBuffer();
+  output->resize(static_cast<size_t>(shape.outputPixels()) * N);
+  std::fill(output->begin(), output->end(), 0);
+
+  // the window sums are only exact for integral accumulators, convolve() doesn't use box filters otherwise
+  if constexpr (std::is_integral_v<TransformDataT>) {
+    if (!core::box<TransformDataT, ColumnDataT, FilterDataT, true>(shape, numGroups, imgBufferPtr->data(), channelWeights.data(), numOutputChannels, N, output->data(), rowSums, boxSums)) {
+      spdlog::critical("Overflow detected in core::box");
+      throw "Overflow detected in core::box";
+    }
+  }
+
+  if (params.statistics != Statistics::kNone) {
+    resetStats();
+    collectStats(output->data(), shape.outputPixels());
+  }
+  return true;
+}
+
+/// \brief check that the region is non-empty and inside of the output of the image previously read
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::validate(const Region &r) const {
+  const uint32_t outWidth = getOutputSize(img.width(), params.strideX);
+  const uint32_t outHeight = getOutputSize(img.height(), params.strideY);
+
+  if (r.width == 0 || r.height == 0 || r.x + r.width > outWidth || r.y + r.height > outHeight) {
+    spdlog::error("Region {}x{}+{}+{} is empty or exceeds the output {}x{}.", r.width, r.height, r.x, r.y, outWidth, outHeight);
+    return false;
+  }
+  return true;
+}
+
+/// \brief convolve only the output region provided with the image previously read
+/// The region only transforms its own output pixels, the halo of input pixels required by the filter is gathered
+/// from the surrounding image, so that the result matches the corresponding pixels of the whole image convolution.
+/// The cost is proportional to the area of the region rather than the image size.
+/// The result is stored in the transform buffer in row-major order, with one row of aligned output channels per region pixel.
+/// \param r(const Region &) region in output pixel coordinates, must be non-empty and inside of the output
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::convolve(const Region &r) {
+  if (!validate(r)) {
+    return false;
+  }
+
+  // the region is cleared on overflow as well, so that later convolutions cover the whole output again
+  region = r;
+  bool success = false;
+  try {
+    success = convolve();
+  } catch (...) {
+    region.reset();
+    throw;
+  }
+  region.reset();
+  return success;
+}
+
+/// \brief convolve only the output regions provided with the image previously read
+/// \see convolve(const Region &)
+/// \param regions(const std::vector<Region> &) regions in output pixel coordinates, must be non-empty and inside of the output
+/// \param outputs(std::vector<TransformBufferT> &) receives one buffer per region in row-major order, with one row of
+/// aligned output channels per region pixel
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::convolve(const std::vector<Region> &regions, std::vector<TransformBufferT> &outputs) {
+  if (!std::all_of(regions.begin(), regions.end(), [this](const Region &r) { return validate(r); })) {
+    return false;
+  }
+
+  outputs.clear();
+  outputs.reserve(regions.size());
+
+  for (const Region &r : regions) {
+    if (!convolve(r)) {
+      return false;
+    }
+    outputs.push_back(*transformBufferPtr);
+  }
+  return true;
+}
+
+/// \brief convolve the image previously read and pool the output in the same pass
+/// The output is convolved in bands of poolSize rows which are reduced as soon as they are produced, so that neither the
+/// column buffer nor the transform buffer for the whole output resolution is allocated. Windows at the right and bottom
+/// border may be partial and only reduce the pixels they contain.
+/// The pooled result is stored in the transform buffer in row-major order, with one row of aligned output channels per
+/// pooled pixel, i.e. getOutputSize(outputWidth, poolSize) x getOutputSize(outputHeight, poolSize) pixels.
+/// \param pooling(const Pooling) reduction applied to each window
+/// \param poolSize(const uint32_t) width and height of the pooling window, which is also its stride
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::convolve(const Pooling pooling, const uint32_t poolSize) {
+  if (poolSize == 0) {
+    spdlog::error("Pooling size must be positive.");
+    return false;
+  }
+
+  const uint32_t outWidth = getOutputSize(img.width(), params.strideX);
+  const uint32_t outHeight = getOutputSize(img.height(), params.strideY);
+  const uint32_t pooledWidth = getOutputSize(outWidth, poolSize);
+  const uint32_t pooledHeight = getOutputSize(outHeight, poolSize);
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(filterPtr->numOutputChannels());
+
+  // the sum of a window is accumulated in the widest type to avoid overflow of the transform data type
+  using SumT = std::conditional_t<std::is_floating_point_v<TransformDataT>, double, std::conditional_t<std::is_signed_v<TransformDataT>, int64_t, uint64_t>>;
+  TransformBufferT pooled(static_cast<size_t>(pooledWidth) * pooledHeight * N);
+  std::vector<SumT> sums(pooledWidth * N);
+
+  // the statistics describe the pooled output, the bands don't collect their own
+  const Statistics statistics = params.statistics;
+  params.statistics = Statistics::kNone;
+
+  bool success = true;
+  for (uint32_t py = 0; py < pooledHeight && success; ++py) {
+    const uint32_t bandHeight = std::min(poolSize, outHeight - py * poolSize);
+    region = Region{0, py * poolSize, outWidth, bandHeight};
+    if (!convolve()) {
+      success = false;
+      break;
+    }
+
+    const TransformDataT *band = transformBufferPtr->data();
+    TransformDataT *dst = pooled.data() + static_cast<uint64_t>(py) * pooledWidth * N;
+    std::fill(sums.begin(), sums.end(), 0);
+
+    for (uint32_t y = 0; y < bandHeight; ++y) {
+      for (uint32_t x = 0; x < outWidth; ++x) {
+        const uint32_t px = x / poolSize;
+        const TransformDataT *src = band + (static_cast<uint64_t>(y) * outWidth + x) * N;
+        if (pooling == Pooling::kMax) {
+          const bool first = y == 0 && x % poolSize == 0;
+          for (uint32_t oc = 0; oc < N; ++oc) {
+            dst[px * N + oc] = first ? src[oc] : std::max(dst[px * N + oc], src[oc]);
           }
+        } else {
+          for (uint32_t oc = 0; oc < N; ++oc) {
+            sums[px * N + oc] += src[oc];
+          }
+        }
+      }
+    }
+
+    if (pooling == Pooling::kAverage) {
+      for (uint32_t px = 0; px < pooledWidth; ++px) {
+        const uint32_t count = bandHeight * std::min(poolSize, outWidth - px * poolSize);
+        for (uint32_t oc = 0; oc < N; ++oc) {
+          dst[px * N + oc] = static_cast<TransformDataT>(sums[px * N + oc] / count);
         }
       }
     }
   }
 
-  // in case kColumnMajor format is requested we need to transpose the column buffer
-  if constexpr (order == core::MatrixOrder::kColumnMajor) {
-    const uint32_t N = columnBufferWidthAligned;
-    const uint32_t M = img.pixels();
-    core::transpose<ColumnDataT, core::MatrixOrder::kRowMajor>(M, N, colBufferPtr->data());
+  region.reset();
+  params.statistics = statistics;
+  if (success) {
+    // store() and write() use the shape of the pooled output rather than the one of the last band
+    transformBufferPtr->swap(pooled);
+    shape.outOffsetX = 0;
+    shape.outOffsetY = 0;
+    shape.outWidth = pooledWidth;
+    shape.outHeight = pooledHeight;
+    if (statistics != Statistics::kNone) {
+      resetStats();
+      collectStats(transformBufferPtr->data(), pooledWidth * pooledHeight);
+    }
   }
+  return success;
+}
+
+/// \brief narrow a single output channel pixel to the image data type
+/// Floating point images keep the result, unsigned results are truncated and signed results are clamped to the range of the image data type.
+template <uint32_t alignment, typename WeightT, typename DataT>
+typename Convolver<alignment, WeightT, DataT>::ColumnDataT Convolver<alignment, WeightT, DataT>::narrow(const TransformDataT value) {
+  if constexpr (std::is_floating_point_v<ColumnDataT>) {
+    return static_cast<ColumnDataT>(value);
+  } else if constexpr (std::is_signed_v<TransformDataT>) {
+    return static_cast<ColumnDataT>(std::clamp<TransformDataT>(value, std::numeric_limits<ColumnDataT>::min(), std::numeric_limits<ColumnDataT>::max()));
+  } else {
+    return static_cast<ColumnDataT>(value);
+  }
+}
 
+/// \brief narrow the output channels of the last convolution into the planar or interleaved image provided
+/// \param out(ImageT &) image receiving the output channels, with at least as many channels as the filter has output channels
+/// \param x(const uint32_t) horizontal position in the image to store the left-most output pixel of the last convolution
+/// \param y(const uint32_t) vertical position in the image to store the top-most output pixel of the last convolution
+/// \param normalize(const bool) rescale each output channel from its minimum and maximum to the image data range, requires statistics
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::store(ImageT &out, const uint32_t x, const uint32_t y, const bool normalize) const {
+  const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(numOutputChannels);
+
+  if (out.channels() < numOutputChannels || x + shape.outWidth > out.width() || y + shape.outHeight > out.height()) {
+    spdlog::error("Output {}x{}x{} doesn't fit into image {}x{}x{} at {}x{}.", shape.outWidth, shape.outHeight, numOutputChannels, out.width(), out.height(), out.channels(), x, y);
+    return false;
+  }
+
+  if (transformBufferPtr->size() < static_cast<size_t>(shape.outputPixels()) * N) {
+    spdlog::error("Transform buffer is empty, convolve the image before storing the output.");
+    return false;
+  }
+
+  if (normalize && outputStats.size() != numOutputChannels) {
+    spdlog::error("Normalizing the output requires the statistics of the output channels, see ConvolutionParams::statistics.");
+    return false;
+  }
+
+  auto imageBuffer = out.getImageBuffer();
+  const uint32_t stride = out.pixelStride();
+  for (uint32_t oc = 0; oc < numOutputChannels; ++oc) {
+    for (uint32_t img_y = 0; img_y < shape.outHeight; ++img_y) {
+      const TransformDataT *src = transformBufferPtr->data() + static_cast<uint64_t>(shape.outWidth) * img_y * N + oc;
+      DataT *dst = imageBuffer->data() + out.calcImageBufferOffset(x, y + img_y, oc);
+      if (normalize) {
+        for (uint32_t img_x = 0; img_x < shape.outWidth; ++img_x) {
+          dst[img_x * stride] = outputStats[oc].template normalize<DataT>(src[img_x * N]);
+        }
+      } else {
+        for (uint32_t img_x = 0; img_x < shape.outWidth; ++img_x) {
+          dst[img_x * stride] = narrow(src[img_x * N]);
+        }
+      }
+    }
+  }
   return true;
 }
 
+/// \brief encode the output channels of the last convolution into PNG files
+/// The files are encoded in parallel, each directly from the transform buffer, i.e. the output channels are narrowed
+/// row by row into the interleaved rows passed to the encoder. File i contains the output channels
+/// [i * channelsPerFile, (i + 1) * channelsPerFile) and is written to <prefix>_<i>.png.
+/// Normalized output rescales each output channel from the minimum and maximum collected by the last convolution,
+/// rather than truncating it, which only costs the rescale of each pixel while it is narrowed.
+/// \param prefix(const fs::path &) path and file name prefix of the output files
+/// \param params(const OutputParams &) channels per file, number of threads, normalization and PNG encoder parameters
+/// \return bool true if all files were written, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::write(const fs::path &prefix, const OutputParams &params) const {
+  if constexpr (std::is_floating_point_v<DataT>) {
+    spdlog::error("Floating point output can't be written to PNG files.");
+    return false;
+  } else {
+    const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+    const uint32_t N = core::getAlignedSize<uint32_t, alignment>(numOutputChannels);
+
+    if (params.channelsPerFile < 1 || params.channelsPerFile > 4) {
+      spdlog::error("{} channels per file are not supported, use 1 to 4.", params.channelsPerFile);
+      return false;
+    }
+
+    if (transformBufferPtr->size() < static_cast<size_t>(shape.outputPixels()) * N) {
+      spdlog::error("Transform buffer is empty, convolve the image before writing the output.");
+      return false;
+    }
+
+    if (params.normalize && outputStats.size() != numOutputChannels) {
+      spdlog::error("Normalizing the output requires the statistics of the output channels, see ConvolutionParams::statistics.");
+      return false;
+    }
+
+    const uint32_t numFiles = (numOutputChannels + params.channelsPerFile - 1) / params.channelsPerFile;
+    const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    const uint32_t numThreads = std::min(numFiles, params.threads ? params.threads : hardwareThreads);
+
+    auto encode = [&](const uint32_t file) {
+      const uint32_t firstChannel = file * params.channelsPerFile;
+      const uint32_t channels = std::min(params.channelsPerFile, numOutputChannels - firstChannel);
+      const fs::path path = prefix.string() + "_" + std::to_string(file) + ".png";
+
+      auto writer = io::PngWriter::create(path, shape.outWidth, shape.outHeight, channels, 8 * sizeof(DataT), params.png);
+      if (!writer) {
+        return false;
+      }
+
+      std::vector<DataT> row(static_cast<size_t>(shape.outWidth) * channels);
+      for (uint32_t img_y = 0; img_y < shape.outHeight; ++img_y) {
+        const TransformDataT *src = transformBufferPtr->data() + static_cast<uint64_t>(shape.outWidth) * img_y * N + firstChannel;
+        for (uint32_t img_x = 0; img_x < shape.outWidth; ++img_x) {
+          for (uint32_t c = 0; c < channels; ++c) {
+            row[img_x * channels + c] = params.normalize ? outputStats[firstChannel + c].template normalize<DataT>(src[img_x * N + c]) : narrow(src[img_x * N + c]);
+          }
+        }
+        if (!writer->writeRow(row.data())) {
+          return false;
+        }
+      }
+      return writer->finish();
+    };
+
+    // the threads pick the next file to encode until all files are written
+    std::atomic<uint32_t> nextFile = 0;
+    std::atomic<bool> success = true;
+    auto worker = [&]() {
+      for (uint32_t file = nextFile++; file < numFiles; file = nextFile++) {
+        if (!encode(file)) {
+          success = false;
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t t = 1; t < numThreads; ++t) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    spdlog::info("Write {} output channels {}x{} to {} PNG files using {} threads", numOutputChannels, shape.outWidth, shape.outHeight, numFiles, std::max(numThreads, 1u));
+    return success;
+  }
+}
+
 /// \brief Execute the convolution operator using the image provided at path
 /// Writes a monochrome image for each output channel of the filter being used
 /// \param path (const fs:path &) image location on disk
-template <uint32_t alignment>
-void Convolver<alignment>::operator()(const fs::path &path) {
+/// \param outputParams (const OutputParams &) parameters of the output files, e.g. the normalization of the output channels
+template <uint32_t alignment, typename WeightT, typename DataT>
+void Convolver<alignment, WeightT, DataT>::operator()(const fs::path &path, const OutputParams &outputParams) {
   if (!img.read(path)) {
     spdlog::error("Image file {} not found.", path.c_str());
     return;
   }
 
-  // transform the image data into column buffer format using column-major order in support of core::mult()
-  img2col<core::MatrixOrder::kColumnMajor>();
+  if (!convolve()) {
+    return;
+  }
 
-  ColumnDataT *colBuffer = getColumnBuffer()->data();
-  ColumnDataT *filterBuffer = filterPtr->getColumnBuffer();
+  // write an image for each output channel of the filter
+  if constexpr (std::is_integral_v<DataT>) {
+    write(path.parent_path() / path.stem(), outputParams);
+  } else {
+    const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+    ImageT out(shape.outWidth, shape.outHeight, numOutputChannels);
+    if (!store(out, 0, 0, outputParams.normalize)) {
+      return;
+    }
 
-  const uint32_t M = img.width() * img.height();
-  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(filterPtr->numOutputChannels());
-  const uint32_t K = core::getAlignedSize<uint32_t, alignment>(filterPtr->height() * filterPtr->width() * filterPtr->numInputChannels());
+    for (uint32_t oc = 0; oc < numOutputChannels; ++oc) {
+      auto filename = std::string(path.stem().c_str()) + "_" + std::to_string(oc) + ".png";
+      fs::path oPath = path.parent_path() / filename;
+      out.write(oPath, oc);
+    }
+  }
+}
 
-  auto output = getTransformBuffer();
-  std::fill(output->begin(), output->end(), 0);
+/// \brief compress the filter to its non-zero weights if their fraction is below ConvolutionParams::sparseDensity
+/// The dense multiplication applies all weights of the aligned filter, including the padding, while core::sparseMult
+/// only applies the non-zero weights, e.g. of identity-like or pruned filters, with bit-identical results. The
+/// density is therefore measured against the aligned filter, i.e. the work done by the dense multiplication.
+/// \param filterBuffer(const FilterDataT *) filter in the order of the column buffer, one KxNg block per group
+/// \return bool true if the sparse filter is to be used, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::compressFilter(const FilterDataT *filterBuffer) {
+  if (params.sparseDensity <= 0) {
+    return false;
+  }
 
-  bool didNotOverflow = core::mult<TransformDataT, ColumnDataT, core::MatrixOrder::kColumnMajor, core::MatrixOrder::kColumnMajor, core::MatrixOrder::kRowMajor, alignment, true>(M, N, K, output->data(), colBuffer, filterBuffer);
-  if (!didNotOverflow) {
-    spdlog::critical("Overflow detected in core::mult");
-    throw "Overflow detected in core::mult";
+  const uint32_t numGroups = filterPtr->numGroups();
+  const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+  const uint32_t K = core::getAlignedSize<uint32_t, alignment>(shape.filterSize() * filterPtr->numInputChannels());
+  const uint32_t Ng = core::getAlignedSize<uint32_t, alignment>(numOutputChannels / numGroups);
+
+  sparseGroups.resize(numGroups);
+  size_t numTaps = 0;
+  for (uint32_t group = 0; group < numGroups; ++group) {
+    core::compress(filterBuffer + static_cast<uint64_t>(group) * K * Ng, K, Ng, sparseGroups[group]);
+    numTaps += sparseGroups[group].numTaps();
   }
 
-  core::transpose<TransformDataT, core::MatrixOrder::kColumnMajor>(M, N, output->data());
+  const uint64_t numWeights = static_cast<uint64_t>(numGroups) * K * Ng;
+  return numTaps < params.sparseDensity * numWeights;
+}
 
-  // lambda for address calculation into the output buffer
-  auto addr = [&](const uint32_t img_x, const uint32_t img_y, const uint32_t oc) {
-    const uint32_t pixelIndex = img.width() * img_y + img_x;
-    return pixelIndex * core::getAlignedSize<uint32_t, alignment>(filterPtr->numOutputChannels()) + oc;
-  };
+/// \brief clear the statistics of the output channels before the output of a convolution is stored
+/// The histogram covers the range the filter can produce from image data in [0, max], i.e. the sums of its negative
+/// and positive weights times the maximum of the image data type, so that the bins are fixed before the convolution.
+template <uint32_t alignment, typename WeightT, typename DataT>
+void Convolver<alignment, WeightT, DataT>::resetStats() {
+  const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+  outputStats.resize(numOutputChannels);
 
-  // write an 8Bit image for each output channel of the filter
-  for (uint32_t oc = 0; oc < filterPtr->numOutputChannels(); ++oc) {
-    auto filename = std::string(path.stem().c_str()) + "_" + std::to_string(oc) + ".png";
-    fs::path oPath = path.parent_path() / filename;
+  // floating point images have no maximum to bound the output by
+  const bool withHistogram = params.statistics == Statistics::kHistogram && std::is_integral_v<DataT>;
+  if (!withHistogram) {
+    for (auto &stats : outputStats) {
+      stats.reset(false);
+    }
+    return;
+  }
 
-    auto imageBuffer = img.getImageBuffer();
+  const uint32_t numGroups = filterPtr->numGroups();
+  const uint32_t outputChannelsPerGroup = numOutputChannels / numGroups;
+  const uint32_t numWeights = filterPtr->height() * filterPtr->width() * filterPtr->numInputChannels();
+  const uint32_t K = core::getAlignedSize<uint32_t, alignment>(numWeights);
+  const uint32_t Ng = core::getAlignedSize<uint32_t, alignment>(outputChannelsPerGroup);
+  const FilterDataT *filterBuffer = filterPtr->getColumnBuffer();
+  const double dataMax = static_cast<double>(std::numeric_limits<DataT>::max());
 
-    for (uint32_t img_y = 0; img_y < img.height(); ++img_y) {
-      for (uint32_t img_x = 0; img_x < img.width(); ++img_x) {
-        uint32_t read = addr(img_x, img_y, oc);
-        uint32_t write = img.calcImageBufferOffset(img_x, img_y, 0);
-        (*imageBuffer)[write] = (*transformBufferPtr)[read];
-      }
+  for (uint32_t oc = 0; oc < numOutputChannels; ++oc) {
+    const FilterDataT *weights = filterBuffer + static_cast<uint64_t>(oc / outputChannelsPerGroup) * K * Ng + oc % outputChannelsPerGroup;
+    double negative = 0;
+    double positive = 0;
+    for (uint32_t k = 0; k < numWeights; ++k) {
+      const double weight = static_cast<double>(weights[static_cast<uint64_t>(k) * Ng]);
+      (weight < 0 ? negative : positive) += weight;
     }
+    outputStats[oc].reset(true, negative * dataMax, positive * dataMax);
+  }
+}
+
+/// \brief collect the statistics of the output channels from a row-major output with one row of aligned output channels per pixel
+/// \param data(const TransformDataT *) output of the convolution
+/// \param numPixels(const uint32_t) number of output pixels
+template <uint32_t alignment, typename WeightT, typename DataT>
+void Convolver<alignment, WeightT, DataT>::collectStats(const TransformDataT *data, const uint32_t numPixels) {
+  const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(numOutputChannels);
+  for (uint32_t p = 0; p < numPixels; ++p, data += N) {
+    for (uint32_t oc = 0; oc < numOutputChannels; ++oc) {
+      outputStats[oc].add(data[oc]);
+    }
+  }
+}
 
-    img.write(oPath, oc);
+/// \brief returns the filter in column buffer format, with the rows in the order of the column buffer of the current image
+/// The column buffer of interleaved images stores the taps of all channels of a pixel next to each other, the rows of
+/// the filter are permuted accordingly into a buffer which is reused between convolutions.
+template <uint32_t alignment, typename WeightT, typename DataT>
+const typename Convolver<alignment, WeightT, DataT>::FilterDataT *Convolver<alignment, WeightT, DataT>::getFilterBuffer() {
+  const FilterDataT *filterBuffer = filterPtr->getColumnBuffer();
+  if (!shape.interleaved || shape.filterSize() == 1) {
+    return filterBuffer;
   }
+
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(filterPtr->numOutputChannels());
+  const uint32_t K = shape.columnBufferWidthAligned;
+  const uint32_t filterSize = shape.filterSize();
+  interleavedFilter.assign(static_cast<size_t>(K) * N, 0);
+  for (uint32_t c = 0; c < shape.imgChannels; ++c) {
+    for (uint32_t tap = 0; tap < filterSize; ++tap) {
+      std::copy_n(filterBuffer + static_cast<uint64_t>(c * filterSize + tap) * N, N, interleavedFilter.data() + static_cast<uint64_t>(tap * shape.imgChannels + c) * N);
+    }
+  }
+  return interleavedFilter.data();
 }
 
-template <uint32_t alignment>
-typename Convolver<alignment>::ColumnBufferPtr Convolver<alignment>::getColumnBuffer() const {
+template <uint32_t alignment, typename WeightT, typename DataT>
+typename Convolver<alignment, WeightT, DataT>::ColumnBufferPtr Convolver<alignment, WeightT, DataT>::getColumnBuffer() const {
   return colBufferPtr;
 }
 
-template <uint32_t alignment>
-typename Convolver<alignment>::TransformBufferPtr Convolver<alignment>::getTransformBuffer() const {
+template <uint32_t alignment, typename WeightT, typename DataT>
+typename Convolver<alignment, WeightT, DataT>::TransformBufferPtr Convolver<alignment, WeightT, DataT>::getTransformBuffer() const {
   return transformBufferPtr;
 }
 
-template <uint32_t alignment>
-bool Convolver<alignment>::read(const fs::path &path) {
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Convolver<alignment, WeightT, DataT>::read(const fs::path &path) {
   return img.read(path);
 }
 
+/// \brief use the image provided for the following convolutions, the image buffer is shared rather than copied
+template <uint32_t alignment, typename WeightT, typename DataT>
+void Convolver<alignment, WeightT, DataT>::setImage(const ImageT &image) {
+  img = image;
+}
+
 }  // namespace core
 }  // namespace convolution
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef CONVOLUTION_CORE_DYNAMICFILTER_H
+#define CONVOLUTION_CORE_DYNAMICFILTER_H
+
+#include <convolution/core/Filter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/math.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \class DynamicFilter
+/// \brief Implements a 4D filter whose dimensions are provided at runtime
+///
+///  The DynamicFilter provides the same column buffer layout as core::Filter, but allows to
+///  construct filters from configuration data without recompiling, where:
+///    K = height * width * inputChannels
+///    N = outputChannels
+///  where K and N can be padded to be aligned to the alignment parameter specified
+///
+/// \see core::Filter
+/// \tparam T(typename) the data type used for the elements of the filter
+/// \tparam alignment(uint32_t) allows to force alignment of the column buffer
+template <typename T, uint32_t alignment = 1>
+class DynamicFilter : public IFilter<T> {
+ public:
+  using StorageT = std::vector<T>;
+  using StoragePtr = std::shared_ptr<StorageT>;
+
+ private:
+  uint32_t filterHeight = 0;          ///< filter height in pixels
+  uint32_t filterWidth = 0;           ///< filter width in pixels
+  uint32_t inputChannels = 0;         ///< number of input channels
+  uint32_t outputChannels = 0;        ///< number of output channels
+  StoragePtr filterBuffer = nullptr;  ///< the input filter buffer
+  StoragePtr colBuffer = nullptr;     ///< the column buffer
+
+ protected:
+  void validate() const;
+  void filterToColumn();
+
+ public:
+  DynamicFilter(uint32_t height, uint32_t width, uint32_t numInputChannels = 1, uint32_t numOutputChannels = 1);
+  DynamicFilter(uint32_t height, uint32_t width, uint32_t numInputChannels, uint32_t numOutputChannels, const StorageT &elements);
+  DynamicFilter(const DynamicFilter &rhs) = delete;
+  DynamicFilter &operator=(const DynamicFilter &rhs) = delete;
+  DynamicFilter(DynamicFilter &&rhs) = default;
+  DynamicFilter &operator=(DynamicFilter &&rhs) = default;
+  ~DynamicFilter() = default;
+
+  const T *getFilterBuffer() const { return filterBuffer->data(); }
+  T *getFilterBuffer() { return filterBuffer->data(); }
+
+  const T *getColumnBuffer() const { return colBuffer->data(); }
+  T *getColumnBuffer() { return colBuffer->data(); }
+
+  uint32_t numElements() const { return filterHeight * filterWidth * inputChannels * outputChannels; }  ///< returns the number of filter elements
+  uint32_t numElementsAligned() const;                                                                  ///< returns the number of elements in the aligned column buffer
+
+  T at(uint32_t hIdx, uint32_t wIdx, uint32_t icIdx, uint32_t ocIdx) const;
+  void set(uint32_t hIdx, uint32_t wIdx, uint32_t icIdx, uint32_t ocIdx, T value);
+
+  virtual uint32_t height() const override { return filterHeight; }
+  virtual uint32_t width() const override { return filterWidth; }
+  virtual uint32_t numInputChannels() const override { return inputChannels; }
+  virtual uint32_t numOutputChannels() const override { return outputChannels; }
+
+  virtual uint32_t leftPadding() const override { return (filterWidth - 1) / 2; }
+  virtual uint32_t rightPadding() const override { return (filterWidth - 1) / 2; }
+  virtual uint32_t topPadding() const override { return (filterHeight - 1) / 2; }
+  virtual uint32_t bottomPadding() const override { return (filterHeight - 1) / 2; }
+
+  /// address calculation into the filter buffer
+  uint32_t calcFilterBufferOffset(const uint32_t fx, const uint32_t fy, const uint32_t ic, uint32_t oc) const;
+
+  /// address calculation into the column buffer
+  uint32_t calcColumnBufferOffset(const uint32_t fx, const uint32_t fy, const uint32_t ic, uint32_t oc) const;
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/DynamicFilter.inl>
+
+#endif  // CONVOLUTION_CORE_DYNAMICFILTER_H
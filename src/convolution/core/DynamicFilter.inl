@@ -0,0 +1,88 @@
+#include <cstdint>
+
+namespace convolution {
+namespace core {
+
+template <typename T, uint32_t alignment>
+DynamicFilter<T, alignment>::DynamicFilter(uint32_t height, uint32_t width, uint32_t numInputChannels, uint32_t numOutputChannels)
+    : filterHeight(height), filterWidth(width), inputChannels(numInputChannels), outputChannels(numOutputChannels) {
+  validate();
+  filterBuffer = std::make_shared<StorageT>(numElements());
+  colBuffer = std::make_shared<StorageT>(numElementsAligned());
+}
+
+template <typename T, uint32_t alignment>
+DynamicFilter<T, alignment>::DynamicFilter(uint32_t height, uint32_t width, uint32_t numInputChannels, uint32_t numOutputChannels, const StorageT &elements)
+    : filterHeight(height), filterWidth(width), inputChannels(numInputChannels), outputChannels(numOutputChannels) {
+  validate();
+  if (numElements() != elements.size()) {
+    spdlog::critical("Filter input data size ({}) doesn't match filter dimensions {}x{}x{}x{}", elements.size(), filterHeight, filterWidth, inputChannels, outputChannels);
+    throw std::out_of_range("Filter input data size doesn't match filter dimensions");
+  }
+  filterBuffer = std::make_shared<StorageT>(elements);
+  colBuffer = std::make_shared<StorageT>(numElementsAligned());
+  filterToColumn();
+}
+
+template <typename T, uint32_t alignment>
+void DynamicFilter<T, alignment>::validate() const {
+  if (numElements() == 0) {
+    spdlog::critical("Filter dimensions {}x{}x{}x{} are ill-defined.", filterHeight, filterWidth, inputChannels, outputChannels);
+    throw std::invalid_argument("Filter dimensions are ill-defined.");
+  }
+  if (filterWidth % 2 != 1 || filterHeight % 2 != 1) {
+    spdlog::critical("Filter dimensions {}x{} must be odd.", filterHeight, filterWidth);
+    throw std::invalid_argument("Filter width and height must be odd");
+  }
+}
+
+template <typename T, uint32_t alignment>
+uint32_t DynamicFilter<T, alignment>::numElementsAligned() const {
+  return core::getAlignedSize<uint32_t, alignment>(filterHeight * filterWidth * inputChannels) * core::getAlignedSize<uint32_t, alignment>(outputChannels);
+}
+
+template <typename T, uint32_t alignment>
+T DynamicFilter<T, alignment>::at(uint32_t hIdx, uint32_t wIdx, uint32_t icIdx, uint32_t ocIdx) const {
+  return (*filterBuffer)[calcFilterBufferOffset(wIdx, hIdx, icIdx, ocIdx)];
+}
+
+/// \brief set a single filter element and update the column buffer accordingly
+template <typename T, uint32_t alignment>
+void DynamicFilter<T, alignment>::set(uint32_t hIdx, uint32_t wIdx, uint32_t icIdx, uint32_t ocIdx, T value) {
+  if (hIdx >= filterHeight || wIdx >= filterWidth || icIdx >= inputChannels || ocIdx >= outputChannels) {
+    spdlog::critical("Filter index ({},{},{},{}) is out of range {}x{}x{}x{}", hIdx, wIdx, icIdx, ocIdx, filterHeight, filterWidth, inputChannels, outputChannels);
+    throw std::out_of_range("Filter index is out of range.");
+  }
+  (*filterBuffer)[calcFilterBufferOffset(wIdx, hIdx, icIdx, ocIdx)] = value;
+  (*colBuffer)[calcColumnBufferOffset(wIdx, hIdx, icIdx, ocIdx)] = value;
+}
+
+template <typename T, uint32_t alignment>
+void DynamicFilter<T, alignment>::filterToColumn() {
+  for (uint32_t oc = 0; oc < outputChannels; ++oc) {
+    for (uint32_t ic = 0; ic < inputChannels; ++ic) {
+      for (uint32_t fy = 0; fy < filterHeight; ++fy) {
+        for (uint32_t fx = 0; fx < filterWidth; ++fx) {
+          uint32_t read = calcFilterBufferOffset(fx, fy, ic, oc);
+          uint32_t write = calcColumnBufferOffset(fx, fy, ic, oc);
+          (*colBuffer)[write] = (*filterBuffer)[read];
+        }
+      }
+    }
+  }
+}
+
+template <typename T, uint32_t alignment>
+uint32_t DynamicFilter<T, alignment>::calcFilterBufferOffset(const uint32_t fx, const uint32_t fy, const uint32_t ic, uint32_t oc) const {
+  return oc * filterHeight * filterWidth * inputChannels + ic * filterHeight * filterWidth + fy * filterWidth + fx;
+}
+
+template <typename T, uint32_t alignment>
+uint32_t DynamicFilter<T, alignment>::calcColumnBufferOffset(const uint32_t fx, const uint32_t fy, const uint32_t ic, uint32_t oc) const {
+  const uint32_t vertical = ic * filterHeight * filterWidth + fy * filterWidth + fx;
+  const uint32_t horizontal = oc;
+  return vertical * core::getAlignedSize<uint32_t, alignment>(outputChannels) + horizontal;
+}
+
+}  // namespace core
+}  // namespace convolution
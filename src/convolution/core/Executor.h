@@ -0,0 +1,118 @@
+#ifndef CONVOLUTION_CORE_EXECUTOR_H
+#define CONVOLUTION_CORE_EXECUTOR_H
+
+#include <convolution/core/ConvolutionParams.h>
+#include <convolution/core/Convolver.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/img2col.h>
+#include <convolution/core/logging.h>
+#include <convolution/io/Image.h>
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \brief final state of a job submitted to the Executor
+enum class JobStatus {
+  kCompleted,  ///< the output has been computed
+  kFailed,     ///< the convolution failed, e.g. because the image doesn't match the filter
+  kCancelled,  ///< the job has been cancelled before a worker picked it up
+};
+
+/// \class Executor
+/// \brief asynchronous convolution of images on a pool of worker threads
+///
+///  Jobs are queued and picked up by the workers in the order of submission. The queue is bounded: submit() blocks
+///  while the queue is full and trySubmit() fails instead, so that the number of images in flight and the column and
+///  transform buffers, one set per worker, are capped. Queued jobs can be cancelled. The result of a job is delivered
+///  through a future and an optional callback, which runs on the worker thread before the future becomes ready. Jobs
+///  throwing an exception fail, exceptions thrown by the callback are logged and ignored.
+///
+///  The image of a job shares its buffer with the image submitted, it must not be modified until the job is done.
+///  Destroying the executor cancels the queued jobs and waits for the running jobs.
+///
+/// \tparam alignment(uint32_t) specifies the alignment of the column and filter buffer in support of the MxPxP multiplier to be used
+/// \tparam WeightT(typename) the C++ type used for the filter weights
+/// \tparam DataT(typename) the C++ type used for the image data
+template <uint32_t alignment, typename WeightT = uint8_t, typename DataT = uint8_t>
+class Executor {
+ public:
+  using ConvolverT = Convolver<alignment, WeightT, DataT>;  ///< the convolver used by the workers
+  using ImageT = typename ConvolverT::ImageT;                ///< the image type used for the input and output
+  using FilterPtr = std::shared_ptr<IFilter<WeightT>>;      ///< shared pointer to the filter of a job
+
+  /// \brief result of a job
+  struct Result {
+    JobStatus status = JobStatus::kFailed;  ///< final state of the job
+    ImageT output;                          ///< planar output with one channel per output channel of the filter
+  };
+  using CallbackT = std::function<void(const Result &)>;  ///< invoked once the job is done
+
+  /// \brief handle of a submitted job
+  struct Job {
+    uint64_t id = 0;             ///< id used to cancel the job
+    std::future<Result> result;  ///< becomes ready once the job is done
+  };
+
+ private:
+  /// \brief queued job
+  struct Task {
+    uint64_t id = 0;               ///< id of the job
+    ImageT image;                  ///< image to convolve
+    FilterPtr filter;              ///< filter of the convolution
+    ConvolutionParams params;      ///< stride and dilation of the convolution
+    CallbackT callback;            ///< invoked once the job is done, may be empty
+    std::promise<Result> promise;  ///< delivers the result to the future of the job
+  };
+
+  /// \brief state of a worker thread, the convolver is reused by consecutive jobs of the same filter
+  struct Worker {
+    FilterPtr filter;                  ///< filter of the convolver
+    ConvolutionParams params;          ///< parameters of the convolver
+    std::unique_ptr<ConvolverT> conv;  ///< convolver of the last job
+  };
+
+  size_t capacity = 0;               ///< maximum number of queued jobs
+  std::deque<Task> queue;            ///< jobs waiting for a worker
+  std::mutex mutex;                  ///< protects the queue and the stopping flag
+  std::condition_variable notEmpty;  ///< signals queued jobs to the workers
+  std::condition_variable notFull;   ///< signals free slots in the queue to blocked submitters
+  bool stopping = false;             ///< the executor is being destroyed
+  uint64_t nextId = 1;               ///< id of the next job
+  std::vector<std::thread> threads;  ///< worker threads
+
+  Job enqueue(std::unique_lock<std::mutex> &lock, const ImageT &image, FilterPtr filter, const ConvolutionParams &p, CallbackT callback);
+  void work();
+  void run(Worker &worker, Task &task);
+  static void finish(Task &task, Result &&result);
+
+ public:
+  explicit Executor(const uint32_t workers = 0, const size_t queueCapacity = 16);
+  Executor(const Executor &rhs) = delete;
+  Executor &operator=(const Executor &rhs) = delete;
+  ~Executor();
+
+  Job submit(const ImageT &image, FilterPtr filter, const ConvolutionParams &p = ConvolutionParams(), CallbackT callback = CallbackT());
+  std::optional<Job> trySubmit(const ImageT &image, FilterPtr filter, const ConvolutionParams &p = ConvolutionParams(), CallbackT callback = CallbackT());
+  bool cancel(const uint64_t id);
+
+  size_t numQueued();                                     ///< returns the number of jobs waiting for a worker
+  uint32_t numThreads() const { return threads.size(); }  ///< returns the number of worker threads
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/Executor.inl>
+
+#endif  // CONVOLUTION_CORE_EXECUTOR_H
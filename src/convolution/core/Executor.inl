@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace convolution {
+namespace core {
+
+/// \brief construct an Executor and start its worker threads
+/// \param workers(const uint32_t) number of worker threads, 0 uses one thread per hardware thread
+/// \param queueCapacity(const size_t) maximum number of queued jobs, at least 1
+template <uint32_t alignment, typename WeightT, typename DataT>
+Executor<alignment, WeightT, DataT>::Executor(const uint32_t workers, const size_t queueCapacity) : capacity(std::max<size_t>(1, queueCapacity)) {
+  const uint32_t count = workers > 0 ? workers : std::max(1u, std::thread::hardware_concurrency());
+  for (uint32_t i = 0; i < count; ++i) {
+    threads.emplace_back(&Executor::work, this);
+  }
+}
+
+template <uint32_t alignment, typename WeightT, typename DataT>
+Executor<alignment, WeightT, DataT>::~Executor() {
+  std::deque<Task> cancelled;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+    cancelled.swap(queue);
+  }
+  notEmpty.notify_all();
+  notFull.notify_all();
+
+  for (Task &task : cancelled) {
+    finish(task, Result{JobStatus::kCancelled, ImageT()});
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+/// \brief queue a job, blocks while the queue is full
+/// \param image(const ImageT &) image to convolve, its buffer must not be modified until the job is done
+/// \param filter(FilterPtr) filter of the convolution
+/// \param p(const ConvolutionParams &) stride and dilation of the convolution
+/// \param callback(CallbackT) invoked on the worker thread once the job is done, before its future becomes ready
+/// \return Job the id and the future of the job
+template <uint32_t alignment, typename WeightT, typename DataT>
+typename Executor<alignment, WeightT, DataT>::Job Executor<alignment, WeightT, DataT>::submit(const ImageT &image, FilterPtr filter, const ConvolutionParams &p, CallbackT callback) {
+  std::unique_lock<std::mutex> lock(mutex);
+  notFull.wait(lock, [this]() { return stopping || queue.size() < capacity; });
+  return enqueue(lock, image, filter, p, std::move(callback));
+}
+
+/// \brief queue a job unless the queue is full
+/// \return std::optional<Job> the id and the future of the job, empty if the queue is full
+template <uint32_t alignment, typename WeightT, typename DataT>
+std::optional<typename Executor<alignment, WeightT, DataT>::Job> Executor<alignment, WeightT, DataT>::trySubmit(const ImageT &image, FilterPtr filter, const ConvolutionParams &p, CallbackT callback) {
+  std::unique_lock<std::mutex> lock(mutex);
+  if (queue.size() >= capacity) {
+    return std::nullopt;
+  }
+  return enqueue(lock, image, filter, p, std::move(callback));
+}
+
+/// \brief cancel a queued job, its future becomes ready with JobStatus::kCancelled and its callback is invoked
+/// \param id(const uint64_t) id of the job
+/// \return bool true if the job has been cancelled, false if it is running or done
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Executor<alignment, WeightT, DataT>::cancel(const uint64_t id) {
+  std::unique_lock<std::mutex> lock(mutex);
+  auto it = std::find_if(queue.begin(), queue.end(), [id](const Task &task) { return task.id == id; });
+  if (it == queue.end()) {
+    return false;
+  }
+  Task task = std::move(*it);
+  queue.erase(it);
+  lock.unlock();
+  notFull.notify_one();
+
+  finish(task, Result{JobStatus::kCancelled, ImageT()});
+  return true;
+}
+
+template <uint32_t alignment, typename WeightT, typename DataT>
+size_t Executor<alignment, WeightT, DataT>::numQueued() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return queue.size();
+}
+
+/// append a job to the queue, the lock must be held
+template <uint32_t alignment, typename WeightT, typename DataT>
+typename Executor<alignment, WeightT, DataT>::Job Executor<alignment, WeightT, DataT>::enqueue(std::unique_lock<std::mutex> &lock, const ImageT &image, FilterPtr filter, const ConvolutionParams &p, CallbackT callback) {
+  Task task;
+  task.id = nextId++;
+  task.image = image;
+  task.filter = filter;
+  task.params = p;
+  task.callback = std::move(callback);
+
+  Job job{task.id, task.promise.get_future()};
+  if (stopping) {
+    lock.unlock();
+    finish(task, Result{JobStatus::kCancelled, ImageT()});
+    return job;
+  }
+
+  queue.push_back(std::move(task));
+  lock.unlock();
+  notEmpty.notify_one();
+  return job;
+}
+
+/// run queued jobs until the executor is destroyed
+template <uint32_t alignment, typename WeightT, typename DataT>
+void Executor<alignment, WeightT, DataT>::work() {
+  Worker worker;
+  while (true) {
+    Task task;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      notEmpty.wait(lock, [this]() { return stopping || !queue.empty(); });
+      if (queue.empty()) {
+        return;
+      }
+      task = std::move(queue.front());
+      queue.pop_front();
+    }
+    notFull.notify_one();
+    run(worker, task);
+  }
+}
+
+/// convolve the image of the task, the convolver of the worker is reused if the filter and parameters are unchanged
+template <uint32_t alignment, typename WeightT, typename DataT>
+void Executor<alignment, WeightT, DataT>::run(Worker &worker, Task &task) {
+  const ConvolutionParams &p = task.params;
+  if (!worker.conv || worker.filter != task.filter || worker.params != p) {
+    worker.conv = std::make_unique<ConvolverT>(task.filter, p);
+    worker.filter = task.filter;
+    worker.params = p;
+  }
+
+  Result result;
+  try {
+    worker.conv->setImage(task.image);
+    if (worker.conv->convolve()) {
+      ImageT output(getOutputSize(task.image.width(), p.strideX), getOutputSize(task.image.height(), p.strideY), task.filter->numOutputChannels());
+      if (worker.conv->store(output, 0, 0)) {
+        result.status = JobStatus::kCompleted;
+        result.output = std::move(output);
+      }
+    }
+    // the worker doesn't keep the image alive beyond the job
+    worker.conv->setImage(ImageT());
+  } catch (...) {
+    // an exception, e.g. an overflow of the accumulators, fails the job instead of terminating the worker thread
+    spdlog::error("Job {} failed with an exception", task.id);
+    result = Result();
+    worker.conv.reset();
+  }
+  finish(task, std::move(result));
+}
+
+/// invoke the callback of the task and make its future ready
+template <uint32_t alignment, typename WeightT, typename DataT>
+void Executor<alignment, WeightT, DataT>::finish(Task &task, Result &&result) {
+  if (task.callback) {
+    try {
+      task.callback(result);
+    } catch (...) {
+      spdlog::error("Callback of job {} failed with an exception", task.id);
+    }
+  }
+  task.promise.set_value(std::move(result));
+}
+
+}  // namespace core
+}  // namespace convolution
@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace convolution {
 namespace core {
@@ -21,6 +22,7 @@ class IFilter {
   virtual uint32_t width() const = 0;              ///< returns filter width in pixels
   virtual uint32_t numInputChannels() const = 0;   ///< returns the number of input channels of the filter
   virtual uint32_t numOutputChannels() const = 0;  ///< returns the number of output channels of the filter
+  virtual uint32_t numGroups() const { return 1; }  ///< returns the number of groups, numInputChannels() is the number of input channels per group
 
   virtual uint32_t leftPadding() const = 0;    ///< returns the padding required on the left of the image
   virtual uint32_t rightPadding() const = 0;   ///< returns the padding required on the right of the image
@@ -32,6 +34,21 @@ class IFilter {
 
   virtual T *getColumnBuffer() = 0;  ///< returns a raw pointer to the filter in column buffer format
   virtual const T *getColumnBuffer() const = 0;
+
+  template <uint32_t alignment>
+  bool getChannelWeights(std::vector<T> &weights) const;
+};
+
+/// \brief Interface of filters providing a direct kernel for single channel images, used by the Convolver instead of img2col and core::mult
+/// \tparam D(typename) the C++ type used for the image data
+/// \tparam R(typename) the C++ type used for the output and the accumulator
+template <typename D, typename R>
+class IDirectFilter {
+ public:
+  virtual ~IDirectFilter(){};
+
+  /// convolve the width x height image src into dst, returns false without touching dst if the kernel can't be used, e.g. because R may overflow
+  virtual bool applyDirect(const D *src, R *dst, const uint32_t width, const uint32_t height) const = 0;
 };
 
 /// \class Filter
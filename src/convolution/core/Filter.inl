@@ -3,6 +3,38 @@
 namespace convolution {
 namespace core {
 
+/// \brief detect box filters, whose weights are constant over the filter window of each pair of input and output channels
+/// The convolution of such a filter is a weighted sum of the window sums of the input channels, whose cost doesn't
+/// depend on the filter size. The weights are read from the column buffer, which is used for the convolution.
+/// \tparam alignment(uint32_t) alignment of the column buffer
+/// \param weights(std::vector<T> &) receives the weight of input channel ic of the group in output channel oc at oc * numInputChannels() + ic
+/// \return bool true if the weights are constant over the filter window, false otherwise
+template <typename T>
+template <uint32_t alignment>
+bool IFilter<T>::getChannelWeights(std::vector<T> &weights) const {
+  const uint32_t filterSize = height() * width();
+  const uint32_t inputChannels = numInputChannels();
+  const uint32_t outputChannelsPerGroup = numOutputChannels() / numGroups();
+  const uint32_t K = core::getAlignedSize<uint32_t, alignment>(filterSize * inputChannels);
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(outputChannelsPerGroup);
+  const T *colBuffer = getColumnBuffer();
+
+  weights.resize(static_cast<size_t>(numOutputChannels()) * inputChannels);
+  for (uint32_t oc = 0; oc < numOutputChannels(); ++oc) {
+    const T *group = colBuffer + static_cast<uint64_t>(oc / outputChannelsPerGroup) * K * N + oc % outputChannelsPerGroup;
+    for (uint32_t ic = 0; ic < inputChannels; ++ic) {
+      const T *taps = group + static_cast<uint64_t>(ic) * filterSize * N;
+      for (uint32_t tap = 1; tap < filterSize; ++tap) {
+        if (taps[static_cast<uint64_t>(tap) * N] != taps[0]) {
+          return false;
+        }
+      }
+      weights[static_cast<size_t>(oc) * inputChannels + ic] = taps[0];
+    }
+  }
+  return true;
+}
+
 template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t kInputChannels, uint32_t kOutputChannels, uint32_t alignment>
 Filter<T, kHeight, kWidth, kInputChannels, kOutputChannels, alignment>::Filter() {
   static_assert(kNumElements != 0, "Filter dimensions are ill-defined.");
@@ -0,0 +1,60 @@
+#ifndef CONVOLUTION_CORE_FILTERBANK_H
+#define CONVOLUTION_CORE_FILTERBANK_H
+
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/math.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \class FilterBank
+/// \brief Concatenates several filters with the same spatial shape along the output channels
+///
+///  Applying the bank with a single Convolver reads the image, builds the column buffer and transposes it
+///  only once for all filters, the filters are applied with a single multiplication where:
+///    K = height * width * inputChannels
+///    N = sum of the output channels of all filters
+///  The output channels of filter i start at outputChannelOffset(i), split() separates the result per filter.
+///
+/// \see core::DynamicFilter
+/// \tparam T(typename) the data type used for the elements of the filter
+/// \tparam alignment(uint32_t) allows to force alignment of the column buffer
+template <typename T, uint32_t alignment = 1>
+class FilterBank : public DynamicFilter<T, alignment> {
+ public:
+  using FilterPtr = std::shared_ptr<IFilter<T>>;
+  using StorageT = typename DynamicFilter<T, alignment>::StorageT;
+
+ private:
+  std::vector<uint32_t> offsets;  ///< first output channel of each filter, followed by the total number of output channels
+
+  static void validate(const std::vector<FilterPtr> &filters);
+  static StorageT concatenate(const std::vector<FilterPtr> &filters);
+
+  FilterBank(const std::vector<FilterPtr> &filters, const StorageT &elements);
+
+ public:
+  explicit FilterBank(const std::vector<FilterPtr> &filters);
+
+  uint32_t numFilters() const { return offsets.size() - 1; }                               ///< returns the number of filters in the bank
+  uint32_t outputChannelOffset(uint32_t idx) const { return offsets[idx]; }                  ///< returns the first output channel of filter idx
+  uint32_t numOutputChannels(uint32_t idx) const { return offsets[idx + 1] - offsets[idx]; }  ///< returns the number of output channels of filter idx
+  using DynamicFilter<T, alignment>::numOutputChannels;
+
+  template <typename R>
+  std::vector<std::vector<R>> split(const std::vector<R> &output, uint32_t pixels) const;
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/FilterBank.inl>
+
+#endif  // CONVOLUTION_CORE_FILTERBANK_H
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cstdint>
+
+namespace convolution {
+namespace core {
+
+/// \brief construct a filter bank from filters sharing height, width and number of input channels
+/// \param filters(const std::vector<FilterPtr> &) the filters in the order of their output channels
+template <typename T, uint32_t alignment>
+FilterBank<T, alignment>::FilterBank(const std::vector<FilterPtr> &filters) : FilterBank(filters, concatenate(filters)) {}
+
+/// \brief construct a filter bank from the validated filters and their concatenated elements
+template <typename T, uint32_t alignment>
+FilterBank<T, alignment>::FilterBank(const std::vector<FilterPtr> &filters, const StorageT &elements)
+    : DynamicFilter<T, alignment>(filters.front()->height(), filters.front()->width(), filters.front()->numInputChannels(), elements.size() / (filters.front()->height() * filters.front()->width() * filters.front()->numInputChannels()), elements) {
+  offsets.reserve(filters.size() + 1);
+  offsets.push_back(0);
+  for (const auto &filter : filters) {
+    offsets.push_back(offsets.back() + filter->numOutputChannels());
+  }
+}
+
+/// \brief check that the filters can be concatenated along the output channels
+template <typename T, uint32_t alignment>
+void FilterBank<T, alignment>::validate(const std::vector<FilterPtr> &filters) {
+  if (filters.empty()) {
+    spdlog::critical("Filter bank requires at least one filter.");
+    throw std::invalid_argument("Filter bank requires at least one filter.");
+  }
+  const IFilter<T> &first = *filters.front();
+  for (const auto &filter : filters) {
+    if (filter->height() != first.height() || filter->width() != first.width() || filter->numInputChannels() != first.numInputChannels()) {
+      spdlog::critical("Filter {}x{}x{} doesn't match the filter bank shape {}x{}x{}.", filter->height(), filter->width(), filter->numInputChannels(), first.height(), first.width(), first.numInputChannels());
+      throw std::invalid_argument("Filters of a filter bank must have the same shape.");
+    }
+    if (filter->numGroups() != 1) {
+      spdlog::critical("Grouped filters with {} groups can't be added to a filter bank.", filter->numGroups());
+      throw std::invalid_argument("Grouped filters can't be added to a filter bank.");
+    }
+  }
+}
+
+/// \brief concatenate the filter buffers, which store the elements of each output channel contiguously
+template <typename T, uint32_t alignment>
+typename FilterBank<T, alignment>::StorageT FilterBank<T, alignment>::concatenate(const std::vector<FilterPtr> &filters) {
+  validate(filters);
+  StorageT elements;
+  for (const auto &filter : filters) {
+    const uint32_t size = filter->height() * filter->width() * filter->numInputChannels() * filter->numOutputChannels();
+    elements.insert(elements.end(), filter->getFilterBuffer(), filter->getFilterBuffer() + size);
+  }
+  return elements;
+}
+
+/// \brief split the output of the convolution with the bank into the outputs of the individual filters
+/// \param output(const std::vector<R> &) row-major output with one row of aligned output channels per pixel
+/// \param pixels(uint32_t) number of output pixels
+/// \return one row-major buffer per filter with numOutputChannels(idx) channels per pixel
+template <typename T, uint32_t alignment>
+template <typename R>
+std::vector<std::vector<R>> FilterBank<T, alignment>::split(const std::vector<R> &output, uint32_t pixels) const {
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(numOutputChannels());
+  if (output.size() < static_cast<size_t>(pixels) * N) {
+    spdlog::error("Output size ({}) doesn't match {} pixels of {} output channels.", output.size(), pixels, N);
+    return {};
+  }
+
+  std::vector<std::vector<R>> outputs(numFilters());
+  for (uint32_t idx = 0; idx < numFilters(); ++idx) {
+    const uint32_t channels = numOutputChannels(idx);
+    outputs[idx].resize(static_cast<size_t>(pixels) * channels);
+    for (uint32_t pixel = 0; pixel < pixels; ++pixel) {
+      std::copy_n(output.data() + static_cast<size_t>(pixel) * N + offsets[idx], channels, outputs[idx].data() + static_cast<size_t>(pixel) * channels);
+    }
+  }
+  return outputs;
+}
+
+}  // namespace core
+}  // namespace convolution
@@ -0,0 +1,89 @@
+#ifndef CONVOLUTION_CORE_GROUPEDFILTER_H
+#define CONVOLUTION_CORE_GROUPEDFILTER_H
+
+#include <convolution/core/Filter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/math.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \class GroupedFilter
+/// \brief Implements a grouped 4D filter, where each group of output channels only sees its own group of input channels
+///
+///  The input channels of the image are split into groups consecutive ranges of numInputChannels() channels and
+///  each group produces numOutputChannels() / groups output channels. A depthwise filter uses one group per image channel.
+///
+///  The column buffer contains one KxN block per group, where:
+///    K = height * width * numInputChannels()
+///    N = numOutputChannels() / groups
+///  where K and N can be padded to be aligned to the alignment parameter specified
+///
+///  The filter elements are provided per output channel, each containing the weights of the input channels of its group.
+///
+/// \tparam T(typename) the data type used for the elements of the filter
+/// \tparam alignment(uint32_t) allows to force alignment of the column buffer
+template <typename T, uint32_t alignment = 1>
+class GroupedFilter : public IFilter<T> {
+ public:
+  using StorageT = std::vector<T>;
+  using StoragePtr = std::shared_ptr<StorageT>;
+
+ private:
+  uint32_t filterHeight = 0;            ///< filter height in pixels
+  uint32_t filterWidth = 0;             ///< filter width in pixels
+  uint32_t groups = 0;                  ///< number of groups
+  uint32_t inputChannelsPerGroup = 0;   ///< number of input channels per group
+  uint32_t outputChannelsPerGroup = 0;  ///< number of output channels per group
+  StoragePtr filterBuffer = nullptr;    ///< the input filter buffer
+  StoragePtr colBuffer = nullptr;       ///< the column buffer
+
+ protected:
+  void filterToColumn();
+
+ public:
+  GroupedFilter(uint32_t height, uint32_t width, uint32_t numGroups, uint32_t numInputChannelsPerGroup, uint32_t numOutputChannelsPerGroup, const StorageT &elements);
+
+  /// creates a depthwise filter applying multiplier filters of height x width to each of the channels
+  static std::shared_ptr<GroupedFilter> depthwise(uint32_t height, uint32_t width, uint32_t channels, const StorageT &elements, uint32_t multiplier = 1);
+
+  const T *getFilterBuffer() const { return filterBuffer->data(); }
+  T *getFilterBuffer() { return filterBuffer->data(); }
+
+  const T *getColumnBuffer() const { return colBuffer->data(); }
+  T *getColumnBuffer() { return colBuffer->data(); }
+
+  uint32_t numElements() const { return filterHeight * filterWidth * inputChannelsPerGroup * outputChannelsPerGroup * groups; }  ///< returns the number of filter elements
+  uint32_t groupSizeAligned() const;                                                                                             ///< returns the number of elements of a single group in the column buffer
+
+  T at(uint32_t hIdx, uint32_t wIdx, uint32_t icIdx, uint32_t ocIdx) const;
+
+  virtual uint32_t height() const override { return filterHeight; }
+  virtual uint32_t width() const override { return filterWidth; }
+  virtual uint32_t numInputChannels() const override { return inputChannelsPerGroup; }
+  virtual uint32_t numOutputChannels() const override { return outputChannelsPerGroup * groups; }
+  virtual uint32_t numGroups() const override { return groups; }
+
+  virtual uint32_t leftPadding() const override { return (filterWidth - 1) / 2; }
+  virtual uint32_t rightPadding() const override { return (filterWidth - 1) / 2; }
+  virtual uint32_t topPadding() const override { return (filterHeight - 1) / 2; }
+  virtual uint32_t bottomPadding() const override { return (filterHeight - 1) / 2; }
+
+  /// address calculation into the filter buffer, ic is the input channel within the group of oc
+  uint32_t calcFilterBufferOffset(const uint32_t fx, const uint32_t fy, const uint32_t ic, uint32_t oc) const;
+
+  /// address calculation into the column buffer, ic is the input channel within the group of oc
+  uint32_t calcColumnBufferOffset(const uint32_t fx, const uint32_t fy, const uint32_t ic, uint32_t oc) const;
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/GroupedFilter.inl>
+
+#endif  // CONVOLUTION_CORE_GROUPEDFILTER_H
@@ -0,0 +1,70 @@
+#include <cstdint>
+
+namespace convolution {
+namespace core {
+
+template <typename T, uint32_t alignment>
+GroupedFilter<T, alignment>::GroupedFilter(uint32_t height, uint32_t width, uint32_t numGroups, uint32_t numInputChannelsPerGroup, uint32_t numOutputChannelsPerGroup, const StorageT &elements)
+    : filterHeight(height), filterWidth(width), groups(numGroups), inputChannelsPerGroup(numInputChannelsPerGroup), outputChannelsPerGroup(numOutputChannelsPerGroup) {
+  if (numElements() == 0) {
+    spdlog::critical("Filter dimensions {}x{} with {} groups of {}x{} channels are ill-defined.", filterHeight, filterWidth, groups, inputChannelsPerGroup, outputChannelsPerGroup);
+    throw std::invalid_argument("Filter dimensions are ill-defined.");
+  }
+  if (filterWidth % 2 != 1 || filterHeight % 2 != 1) {
+    spdlog::critical("Filter dimensions {}x{} must be odd.", filterHeight, filterWidth);
+    throw std::invalid_argument("Filter width and height must be odd");
+  }
+  if (numElements() != elements.size()) {
+    spdlog::critical("Filter input data size ({}) doesn't match filter dimensions {}x{} with {} groups of {}x{} channels", elements.size(), filterHeight, filterWidth, groups, inputChannelsPerGroup, outputChannelsPerGroup);
+    throw std::out_of_range("Filter input data size doesn't match filter dimensions");
+  }
+  filterBuffer = std::make_shared<StorageT>(elements);
+  colBuffer = std::make_shared<StorageT>(groups * groupSizeAligned());
+  filterToColumn();
+}
+
+template <typename T, uint32_t alignment>
+std::shared_ptr<GroupedFilter<T, alignment>> GroupedFilter<T, alignment>::depthwise(uint32_t height, uint32_t width, uint32_t channels, const StorageT &elements, uint32_t multiplier) {
+  return std::make_shared<GroupedFilter>(height, width, channels, 1, multiplier, elements);
+}
+
+template <typename T, uint32_t alignment>
+uint32_t GroupedFilter<T, alignment>::groupSizeAligned() const {
+  return core::getAlignedSize<uint32_t, alignment>(filterHeight * filterWidth * inputChannelsPerGroup) * core::getAlignedSize<uint32_t, alignment>(outputChannelsPerGroup);
+}
+
+template <typename T, uint32_t alignment>
+T GroupedFilter<T, alignment>::at(uint32_t hIdx, uint32_t wIdx, uint32_t icIdx, uint32_t ocIdx) const {
+  return (*filterBuffer)[calcFilterBufferOffset(wIdx, hIdx, icIdx, ocIdx)];
+}
+
+template <typename T, uint32_t alignment>
+void GroupedFilter<T, alignment>::filterToColumn() {
+  for (uint32_t oc = 0; oc < numOutputChannels(); ++oc) {
+    for (uint32_t ic = 0; ic < inputChannelsPerGroup; ++ic) {
+      for (uint32_t fy = 0; fy < filterHeight; ++fy) {
+        for (uint32_t fx = 0; fx < filterWidth; ++fx) {
+          uint32_t read = calcFilterBufferOffset(fx, fy, ic, oc);
+          uint32_t write = calcColumnBufferOffset(fx, fy, ic, oc);
+          (*colBuffer)[write] = (*filterBuffer)[read];
+        }
+      }
+    }
+  }
+}
+
+template <typename T, uint32_t alignment>
+uint32_t GroupedFilter<T, alignment>::calcFilterBufferOffset(const uint32_t fx, const uint32_t fy, const uint32_t ic, uint32_t oc) const {
+  return oc * filterHeight * filterWidth * inputChannelsPerGroup + ic * filterHeight * filterWidth + fy * filterWidth + fx;
+}
+
+template <typename T, uint32_t alignment>
+uint32_t GroupedFilter<T, alignment>::calcColumnBufferOffset(const uint32_t fx, const uint32_t fy, const uint32_t ic, uint32_t oc) const {
+  const uint32_t group = oc / outputChannelsPerGroup;
+  const uint32_t vertical = ic * filterHeight * filterWidth + fy * filterWidth + fx;
+  const uint32_t horizontal = oc % outputChannelsPerGroup;
+  return group * groupSizeAligned() + vertical * core::getAlignedSize<uint32_t, alignment>(outputChannelsPerGroup) + horizontal;
+}
+
+}  // namespace core
+}  // namespace convolution
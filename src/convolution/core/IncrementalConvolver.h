@@ -0,0 +1,70 @@
+#ifndef CONVOLUTION_CORE_INCREMENTALCONVOLVER_H
+#define CONVOLUTION_CORE_INCREMENTALCONVOLVER_H
+
+#include <convolution/core/ConvolutionParams.h>
+#include <convolution/core/Convolver.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/img2col.h>
+#include <convolution/core/logging.h>
+#include <convolution/io/Image.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \class IncrementalConvolver
+/// \brief convolution of frame sequences which only recomputes the output tiles affected by changed input pixels
+///
+///  The output is divided into tiles of tileWidth x tileHeight output pixels. Each frame is compared block by block
+///  with the previous frame, where a block covers the input pixels centered by the output pixels of a tile. The tiles
+///  reached by the filter from the changed pixels of a block, i.e. their bounding box dilated by the filter halo, are
+///  convolved again and stored into the output, all other output tiles keep the result of the previous frames.
+///  The first frame, and every frame following a change of the frame size or a frame which failed to convolve, is
+///  convolved as a whole.
+///
+/// \tparam alignment(uint32_t) specifies the alignment of the column and filter buffer in support of the MxPxP multiplier to be used
+/// \tparam WeightT(typename) the C++ type used for the filter weights
+/// \tparam DataT(typename) the C++ type used for the image data
+template <uint32_t alignment, typename WeightT = uint8_t, typename DataT = uint8_t>
+class IncrementalConvolver {
+ public:
+  using ConvolverT = Convolver<alignment, WeightT, DataT>;  ///< the convolver used for the changed tiles
+  using ImageT = typename ConvolverT::ImageT;                ///< the image type used for the frames and the output
+
+ private:
+  std::shared_ptr<IFilter<WeightT>> filterPtr;  ///< filter used for the convolution
+  ConvolutionParams params;                     ///< stride and dilation of the convolution
+  ConvolverT conv;                              ///< convolver reused for all tiles
+  uint32_t tileWidth = 0;                       ///< tile width in output pixels
+  uint32_t tileHeight = 0;                      ///< tile height in output pixels
+  ImageT previous;                              ///< copy of the previous frame
+  ImageT output;                                ///< output of the frames convolved so far
+  std::vector<uint8_t> dirty;                   ///< flags the output tiles to be convolved for the current frame
+  uint32_t changedTiles = 0;                    ///< number of output tiles convolved for the last frame
+
+ protected:
+  std::optional<Region> updateBlock(const ImageT &frame, const uint32_t x0, const uint32_t x1, const uint32_t y0, const uint32_t y1);
+  bool convolveTiles(const uint32_t outWidth, const uint32_t outHeight, const uint32_t tilesX, const uint32_t tilesY);
+
+ public:
+  IncrementalConvolver(std::shared_ptr<IFilter<WeightT>> f, const uint32_t width = 32, const uint32_t height = 32, const ConvolutionParams &p = ConvolutionParams());
+
+  bool operator()(const ImageT &frame);
+  void reset();
+
+  const ImageT &getOutput() const { return output; }         ///< returns the output of the frames convolved so far
+  uint32_t numTiles() const { return dirty.size(); }         ///< returns the number of output tiles
+  uint32_t numChangedTiles() const { return changedTiles; }  ///< returns the number of output tiles convolved for the last frame
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/IncrementalConvolver.inl>
+
+#endif  // CONVOLUTION_CORE_INCREMENTALCONVOLVER_H
@@ -0,0 +1,198 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace convolution {
+namespace core {
+
+/// \brief construct an IncrementalConvolver for the filter, tile size and sampling parameters provided
+/// \param f(std::shared_ptr<IFilter<WeightT>>) filter used for the convolution
+/// \param width(const uint32_t) tile width in output pixels
+/// \param height(const uint32_t) tile height in output pixels
+/// \param p(const ConvolutionParams &) stride and dilation of the convolution
+template <uint32_t alignment, typename WeightT, typename DataT>
+IncrementalConvolver<alignment, WeightT, DataT>::IncrementalConvolver(std::shared_ptr<IFilter<WeightT>> f, const uint32_t width, const uint32_t height, const ConvolutionParams &p)
+    : filterPtr(f), params(p), conv(f, p), tileWidth(width), tileHeight(height) {
+  if (tileWidth == 0 || tileHeight == 0) {
+    spdlog::critical("Tile size {}x{} must be positive.", tileWidth, tileHeight);
+    throw std::invalid_argument("Tile size must be positive");
+  }
+}
+
+/// \brief convolve the next frame of the sequence, only the output tiles affected by changed input pixels are computed
+/// \param frame(const ImageT &) the next frame, its channels must match the input channels of the filter
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool IncrementalConvolver<alignment, WeightT, DataT>::operator()(const ImageT &frame) {
+  if (!frame.getImageBuffer() || frame.getImageBuffer()->empty()) {
+    spdlog::error("Frame is empty, failed to convolve the frame.");
+    return false;
+  }
+
+  const uint32_t width = frame.width();
+  const uint32_t height = frame.height();
+  const uint32_t outWidth = getOutputSize(width, params.strideX);
+  const uint32_t outHeight = getOutputSize(height, params.strideY);
+  const uint32_t tilesX = (outWidth + tileWidth - 1) / tileWidth;
+  const uint32_t tilesY = (outHeight + tileHeight - 1) / tileHeight;
+  conv.setImage(frame);
+
+  // the first frame and frames of a different size are convolved as a whole
+  if (!previous.getImageBuffer() || previous.width() != width || previous.height() != height || previous.channels() != frame.channels() || previous.layout() != frame.layout()) {
+    if (!conv.convolve()) {
+      return false;
+    }
+    output = ImageT(outWidth, outHeight, filterPtr->numOutputChannels());
+    if (!conv.store(output, 0, 0)) {
+      return false;
+    }
+
+    previous = ImageT(width, height, frame.channels(), frame.layout());
+    std::copy_n(frame.getImageBuffer()->data(), previous.getImageBuffer()->size(), previous.getImageBuffer()->data());
+    dirty.assign(static_cast<size_t>(tilesX) * tilesY, 1);
+    changedTiles = dirty.size();
+    return true;
+  }
+
+  // halo of input pixels reached by the filter around the centers of the output pixels
+  const int64_t leftHalo = filterPtr->leftPadding() * params.dilationX;
+  const int64_t rightHalo = filterPtr->rightPadding() * params.dilationX;
+  const int64_t topHalo = filterPtr->topPadding() * params.dilationY;
+  const int64_t bottomHalo = filterPtr->bottomPadding() * params.dilationY;
+
+  // returns the range of tiles [begin, end) with output pixels reaching the input range [begin, end)
+  auto affectedTiles = [](const int64_t begin, const int64_t end, const int64_t stride, const int64_t before, const int64_t after, const int64_t outSize, const int64_t tileSize) {
+    const int64_t outBegin = (std::max<int64_t>(0, begin - after) + stride - 1) / stride;
+    const int64_t outEnd = std::min<int64_t>(outSize, (end - 1 + before) / stride + 1);
+    return std::make_pair(static_cast<uint32_t>(outBegin / tileSize), static_cast<uint32_t>((outEnd + tileSize - 1) / tileSize));
+  };
+
+  // compare the blocks of input pixels centered by the output tiles and dilate the changed pixels by the halo
+  std::fill(dirty.begin(), dirty.end(), 0);
+  const uint32_t blockWidth = tileWidth * params.strideX;
+  const uint32_t blockHeight = tileHeight * params.strideY;
+  for (uint32_t y0 = 0; y0 < height; y0 += blockHeight) {
+    const uint32_t y1 = std::min(height, y0 + blockHeight);
+    for (uint32_t x0 = 0; x0 < width; x0 += blockWidth) {
+      const uint32_t x1 = std::min(width, x0 + blockWidth);
+      const std::optional<Region> changed = updateBlock(frame, x0, x1, y0, y1);
+      if (!changed) {
+        continue;
+      }
+
+      const auto [tyBegin, tyEnd] = affectedTiles(changed->y, changed->y + changed->height, params.strideY, topHalo, bottomHalo, outHeight, tileHeight);
+      const auto [txBegin, txEnd] = affectedTiles(changed->x, changed->x + changed->width, params.strideX, leftHalo, rightHalo, outWidth, tileWidth);
+      for (uint32_t ty = tyBegin; ty < tyEnd; ++ty) {
+        std::fill_n(dirty.begin() + static_cast<size_t>(ty) * tilesX + txBegin, txEnd - txBegin, 1);
+      }
+    }
+  }
+
+  // the changed rows are already copied into the previous frame, so that a frame which fails to convolve would leave its
+  // tiles stale for the following frames, these are convolved as a whole instead
+  try {
+    if (!convolveTiles(outWidth, outHeight, tilesX, tilesY)) {
+      reset();
+      return false;
+    }
+  } catch (...) {
+    reset();
+    throw;
+  }
+
+  spdlog::debug("Convolved {} of {} tiles of frame {}x{}x{}", changedTiles, dirty.size(), width, height, frame.channels());
+  return true;
+}
+
+/// \brief convolve the output tiles flagged as dirty and store them into the output, the remaining output is left untouched
+/// \param outWidth(const uint32_t) width of the output
+/// \param outHeight(const uint32_t) height of the output
+/// \param tilesX(const uint32_t) number of tiles per row of the output
+/// \param tilesY(const uint32_t) number of tile rows of the output
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool IncrementalConvolver<alignment, WeightT, DataT>::convolveTiles(const uint32_t outWidth, const uint32_t outHeight, const uint32_t tilesX, const uint32_t tilesY) {
+  changedTiles = 0;
+  for (uint32_t ty = 0; ty < tilesY; ++ty) {
+    for (uint32_t tx = 0; tx < tilesX; ++tx) {
+      if (!dirty[static_cast<size_t>(ty) * tilesX + tx]) {
+        continue;
+      }
+
+      const uint32_t ox = tx * tileWidth;
+      const uint32_t oy = ty * tileHeight;
+      if (!conv.convolve(Region{ox, oy, std::min(tileWidth, outWidth - ox), std::min(tileHeight, outHeight - oy)})) {
+        return false;
+      }
+      if (!conv.store(output, ox, oy)) {
+        return false;
+      }
+      ++changedTiles;
+    }
+  }
+  return true;
+}
+
+/// \brief compare a block of the frame with the previous frame and copy changed rows into the previous frame
+/// The rows are compared using memcmp, which the C library implements using SIMD instructions. Only the changed rows
+/// are searched for the first and last changed pixel.
+/// \param frame(const ImageT &) the current frame
+/// \param x0(const uint32_t) left-most column of the block
+/// \param x1(const uint32_t) column following the right-most column of the block
+/// \param y0(const uint32_t) top-most row of the block
+/// \param y1(const uint32_t) row following the bottom-most row of the block
+/// \return the bounding box of the changed pixels in input pixel coordinates, or nothing if the block didn't change
+template <uint32_t alignment, typename WeightT, typename DataT>
+std::optional<Region> IncrementalConvolver<alignment, WeightT, DataT>::updateBlock(const ImageT &frame, const uint32_t x0, const uint32_t x1, const uint32_t y0, const uint32_t y1) {
+  // the channels of a pixel are adjacent in interleaved frames, so that a single run covers all channels of a row
+  const uint32_t planes = frame.layout() == io::Layout::kInterleaved ? 1 : frame.channels();
+  const uint32_t stride = frame.pixelStride();
+  const size_t rowElements = static_cast<size_t>(x1 - x0) * stride;
+  const DataT *src = frame.getImageBuffer()->data();
+  DataT *dst = previous.getImageBuffer()->data();
+
+  uint32_t left = x1;
+  uint32_t right = x0;
+  uint32_t top = y1;
+  uint32_t bottom = y0;
+  for (uint32_t c = 0; c < planes; ++c) {
+    for (uint32_t y = y0; y < y1; ++y) {
+      const DataT *srcRow = src + frame.calcImageBufferOffset(x0, y, c);
+      DataT *dstRow = dst + frame.calcImageBufferOffset(x0, y, c);
+      if (memcmp(srcRow, dstRow, rowElements * sizeof(DataT)) == 0) {
+        continue;
+      }
+
+      // bitwise comparison of the first and last changed element, which also covers floating point data
+      auto differs = [&](const size_t i) { return memcmp(srcRow + i, dstRow + i, sizeof(DataT)) != 0; };
+      size_t first = 0;
+      while (!differs(first)) {
+        ++first;
+      }
+      size_t last = rowElements - 1;
+      while (!differs(last)) {
+        --last;
+      }
+
+      left = std::min<uint32_t>(left, x0 + first / stride);
+      right = std::max<uint32_t>(right, x0 + last / stride + 1);
+      top = std::min(top, y);
+      bottom = std::max(bottom, y + 1);
+      memcpy(dstRow, srcRow, rowElements * sizeof(DataT));
+    }
+  }
+
+  if (left >= right) {
+    return std::nullopt;
+  }
+  return Region{left, top, right - left, bottom - top};
+}
+
+/// \brief forget the previous frame, the next frame is convolved as a whole
+template <uint32_t alignment, typename WeightT, typename DataT>
+void IncrementalConvolver<alignment, WeightT, DataT>::reset() {
+  previous = ImageT();
+}
+
+}  // namespace core
+}  // namespace convolution
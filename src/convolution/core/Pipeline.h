@@ -0,0 +1,67 @@
+#ifndef CONVOLUTION_CORE_PIPELINE_H
+#define CONVOLUTION_CORE_PIPELINE_H
+
+#include <convolution/core/Convolver.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/logging.h>
+#include <convolution/io/Image.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \class Pipeline
+/// \brief Chains several convolutions, where the output of each layer is the input of the next layer
+///
+///  Intermediate results stay in memory and are narrowed to the image data type between layers, which gives the same
+///  results as writing and reading the output of each layer. Two ping-pong buffers are planned for the largest
+///  intermediate result and reused by all layers and runs.
+///
+///  If fusedRows is set, the layers are fused: the output is produced in bands of fusedRows rows, for which every layer
+///  only computes the rows required by the next layer, i.e. the band grown by the filter padding of the following layers.
+///  The intermediate buffers then only hold a band, so that the activations stay in cache, at the cost of recomputing
+///  the overlapping halo rows.
+///
+///  All layers use a stride and dilation of 1, so that each layer preserves the image size.
+///
+/// \tparam alignment(uint32_t) specifies the alignment of the column and filter buffer in support of the MxPxP multiplier to be used
+/// \tparam WeightT(typename) the C++ type used for the filter weights
+/// \tparam DataT(typename) the C++ type used for the image data
+template <uint32_t alignment, typename WeightT = uint8_t, typename DataT = uint8_t>
+class Pipeline {
+ public:
+  using ConvolverT = Convolver<alignment, WeightT, DataT>;  ///< the convolver used for each layer
+  using ImageT = typename ConvolverT::ImageT;                ///< the image type used for input, output and intermediate results
+  using FilterPtr = std::shared_ptr<IFilter<WeightT>>;      ///< shared pointer to the filter of a layer
+
+ private:
+  std::vector<FilterPtr> filters;                           ///< filter of each layer
+  std::vector<ConvolverT> convolvers;                       ///< convolver of each layer, keeps its buffers between runs
+  std::array<typename ImageT::StoragePtr, 2> buffers;       ///< ping-pong buffers for the intermediate results
+  uint32_t fusedRows = 0;                                   ///< number of output rows per fused band, 0 disables fusion
+
+  void plan(const uint32_t width, const uint32_t rows);
+  bool runLayers(const ImageT &input, ImageT &output);
+  bool runFused(const ImageT &input, ImageT &output);
+
+ public:
+  explicit Pipeline(const std::vector<FilterPtr> &layers, const uint32_t rows = 0);
+
+  bool operator()(const ImageT &input, ImageT &output);
+  bool operator()(const fs::path &path, ImageT &output);
+
+  uint32_t numLayers() const { return filters.size(); }  ///< returns the number of layers
+  size_t bufferSize() const;                              ///< returns the number of elements allocated for intermediate results
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/Pipeline.inl>
+
+#endif  // CONVOLUTION_CORE_PIPELINE_H
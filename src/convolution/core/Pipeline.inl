@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cstdint>
+
+namespace convolution {
+namespace core {
+
+/// \brief construct a pipeline applying the filters provided in order
+/// \param layers(const std::vector<FilterPtr> &) filter of each layer, the input channels of each layer must match the output channels of the previous layer
+/// \param rows(const uint32_t) number of output rows per fused band, 0 runs each layer on the whole image
+template <uint32_t alignment, typename WeightT, typename DataT>
+Pipeline<alignment, WeightT, DataT>::Pipeline(const std::vector<FilterPtr> &layers, const uint32_t rows) : filters(layers), fusedRows(rows) {
+  if (filters.empty()) {
+    spdlog::critical("Pipeline requires at least one layer.");
+    throw std::invalid_argument("Pipeline requires at least one layer.");
+  }
+
+  for (uint32_t l = 1; l < filters.size(); ++l) {
+    const uint32_t inputChannels = filters[l]->numGroups() * filters[l]->numInputChannels();
+    if (inputChannels != filters[l - 1]->numOutputChannels()) {
+      spdlog::critical("Layer {} expects {} input channels, but layer {} produces {} output channels.", l, inputChannels, l - 1, filters[l - 1]->numOutputChannels());
+      throw std::invalid_argument("Pipeline layers don't match.");
+    }
+  }
+
+  convolvers.reserve(filters.size());
+  for (const auto &filter : filters) {
+    convolvers.emplace_back(filter);
+  }
+
+  for (auto &buffer : buffers) {
+    buffer = std::make_shared<typename ImageT::StorageT>();
+  }
+}
+
+/// \brief grow the ping-pong buffers to hold the intermediate result of any layer for rows x width pixels
+template <uint32_t alignment, typename WeightT, typename DataT>
+void Pipeline<alignment, WeightT, DataT>::plan(const uint32_t width, const uint32_t rows) {
+  size_t size = 0;
+  for (uint32_t l = 0; l + 1 < filters.size(); ++l) {
+    size = std::max<size_t>(size, static_cast<size_t>(width) * rows * filters[l]->numOutputChannels());
+  }
+
+  for (auto &buffer : buffers) {
+    if (buffer->size() < size) {
+      buffer->resize(size);
+    }
+  }
+}
+
+template <uint32_t alignment, typename WeightT, typename DataT>
+size_t Pipeline<alignment, WeightT, DataT>::bufferSize() const {
+  return buffers[0]->size() + buffers[1]->size();
+}
+
+/// \brief apply all layers to the input image
+/// \param input(const ImageT &) input image, its channels must match the input channels of the first layer
+/// \param output(ImageT &) receives the output of the last layer, its buffer is reused if the size matches
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Pipeline<alignment, WeightT, DataT>::operator()(const ImageT &input, ImageT &output) {
+  const uint32_t outputChannels = filters.back()->numOutputChannels();
+  if (!output.getImageBuffer() || output.width() != input.width() || output.height() != input.height() || output.channels() != outputChannels) {
+    output = ImageT(input.width(), input.height(), outputChannels);
+  }
+
+  return fusedRows == 0 ? runLayers(input, output) : runFused(input, output);
+}
+
+/// \brief read the image at path and apply all layers
+/// \see operator()(const ImageT &, ImageT &)
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Pipeline<alignment, WeightT, DataT>::operator()(const fs::path &path, ImageT &output) {
+  ImageT input{};
+  if (!input.read(path)) {
+    return false;
+  }
+  return (*this)(input, output);
+}
+
+/// \brief apply each layer to the whole image, alternating between the ping-pong buffers
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Pipeline<alignment, WeightT, DataT>::runLayers(const ImageT &input, ImageT &output) {
+  const uint32_t width = input.width();
+  const uint32_t height = input.height();
+  plan(width, height);
+
+  ImageT current = input;
+  for (uint32_t l = 0; l < filters.size(); ++l) {
+    ConvolverT &conv = convolvers[l];
+    conv.setImage(current);
+    if (!conv.convolve()) {
+      return false;
+    }
+
+    if (l + 1 == filters.size()) {
+      return conv.store(output, 0, 0);
+    }
+
+    ImageT next(width, height, filters[l]->numOutputChannels(), buffers[l % 2]);
+    if (!conv.store(next, 0, 0)) {
+      return false;
+    }
+    current = next;
+  }
+  return true;
+}
+
+/// \brief apply all layers band by band, each layer only computes the rows required by the following layers
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool Pipeline<alignment, WeightT, DataT>::runFused(const ImageT &input, ImageT &output) {
+  const uint32_t numLayers = filters.size();
+  const uint32_t width = input.width();
+  const uint32_t height = input.height();
+
+  // a band grows by the padding of every following layer
+  uint32_t halo = 0;
+  for (uint32_t l = 1; l < numLayers; ++l) {
+    halo += filters[l]->topPadding() + filters[l]->bottomPadding();
+  }
+  plan(width, std::min(height, fusedRows + halo));
+
+  // first and last output row of each layer for the current band
+  std::vector<std::pair<uint32_t, uint32_t>> rows(numLayers);
+
+  for (uint32_t y = 0; y < height; y += fusedRows) {
+    rows[numLayers - 1] = {y, std::min(height, y + fusedRows)};
+    for (uint32_t l = numLayers - 1; l > 0; --l) {
+      rows[l - 1].first = rows[l].first - std::min(rows[l].first, filters[l]->topPadding());
+      rows[l - 1].second = std::min(height, rows[l].second + filters[l]->bottomPadding());
+    }
+
+    // the input of the first layer is the whole image, the inputs of the following layers only hold the band rows
+    ImageT current = input;
+    uint32_t firstRow = 0;
+    for (uint32_t l = 0; l < numLayers; ++l) {
+      ConvolverT &conv = convolvers[l];
+      const uint32_t bandHeight = rows[l].second - rows[l].first;
+      conv.setImage(current);
+      if (!conv.convolve(Region{0, rows[l].first - firstRow, width, bandHeight})) {
+        return false;
+      }
+
+      if (l + 1 == numLayers) {
+        if (!conv.store(output, 0, rows[l].first)) {
+          return false;
+        }
+        break;
+      }
+
+      ImageT next(width, bandHeight, filters[l]->numOutputChannels(), buffers[l % 2]);
+      if (!conv.store(next, 0, 0)) {
+        return false;
+      }
+      current = next;
+      firstRow = rows[l].first;
+    }
+  }
+  return true;
+}
+
+}  // namespace core
+}  // namespace convolution
@@ -0,0 +1,59 @@
+#ifndef CONVOLUTION_CORE_STREAMCONVOLVER_H
+#define CONVOLUTION_CORE_STREAMCONVOLVER_H
+
+#include <convolution/core/ConvolutionParams.h>
+#include <convolution/core/Convolver.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/img2col.h>
+#include <convolution/core/logging.h>
+#include <convolution/io/FrameStream.h>
+#include <convolution/io/Image.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace convolution {
+namespace core {
+
+/// \class StreamConvolver
+/// \brief convolution of frame sequences read from a stream, e.g. a pipe from a video decoder
+///
+///  Every frame is read into the same frame buffer, convolved by the same convolver and stored into the same output
+///  image, which is handed to a sink before the next frame is read. Once the first frame has been convolved, all
+///  buffers have reached their final size, so that frames of a constant size are processed without allocating memory.
+///
+/// \tparam alignment(uint32_t) specifies the alignment of the column and filter buffer in support of the MxPxP multiplier to be used
+/// \tparam WeightT(typename) the C++ type used for the filter weights
+/// \tparam DataT(typename) the C++ type used for the image data
+template <uint32_t alignment, typename WeightT = uint8_t, typename DataT = uint8_t>
+class StreamConvolver {
+ public:
+  using ConvolverT = Convolver<alignment, WeightT, DataT>;  ///< the convolver used for the frames
+  using ImageT = typename ConvolverT::ImageT;                ///< the image type used for the frames and the output
+  using SinkT = std::function<bool(const ImageT &)>;         ///< receives the output of each frame, returns false to stop the stream
+
+ private:
+  std::shared_ptr<IFilter<WeightT>> filterPtr;  ///< filter used for the convolution
+  ConvolutionParams params;                     ///< stride and dilation of the convolution
+  ConvolverT conv;                              ///< convolver reused for all frames
+  ImageT frame;                                 ///< buffer of the frame read from the stream
+  ImageT output;                                ///< output of the current frame
+  uint64_t frames = 0;                          ///< number of frames convolved so far
+
+ public:
+  explicit StreamConvolver(std::shared_ptr<IFilter<WeightT>> f, const ConvolutionParams &p = ConvolutionParams());
+
+  bool operator()(io::FrameReader &reader, const SinkT &sink);
+  bool operator()(io::FrameReader &reader, io::FrameWriter &writer);
+  bool push(const ImageT &input, const SinkT &sink);
+
+  uint64_t numFrames() const { return frames; }  ///< returns the number of frames convolved so far
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/StreamConvolver.inl>
+
+#endif  // CONVOLUTION_CORE_STREAMCONVOLVER_H
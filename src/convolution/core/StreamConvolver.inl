@@ -0,0 +1,69 @@
+#include <cstdint>
+
+namespace convolution {
+namespace core {
+
+/// \brief construct a StreamConvolver for the filter and sampling parameters provided
+/// \param f(std::shared_ptr<IFilter<WeightT>>) filter used for the convolution
+/// \param p(const ConvolutionParams &) stride and dilation of the convolution
+template <uint32_t alignment, typename WeightT, typename DataT>
+StreamConvolver<alignment, WeightT, DataT>::StreamConvolver(std::shared_ptr<IFilter<WeightT>> f, const ConvolutionParams &p) : filterPtr(f), params(p), conv(f, p) {}
+
+/// \brief convolve all frames of the stream until its end
+/// \param reader(io::FrameReader &) stream of frames, its channels must match the input channels of the filter
+/// \param sink(const SinkT &) receives the output of each frame, which is only valid until the sink returns
+/// \return bool true if the end of the stream has been reached, false on error or if the sink stopped the stream
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool StreamConvolver<alignment, WeightT, DataT>::operator()(io::FrameReader &reader, const SinkT &sink) {
+  if (reader.type() != io::getRawType<DataT>()) {
+    spdlog::error("Frame stream has type {}, expected {}.", static_cast<uint32_t>(reader.type()), static_cast<uint32_t>(io::getRawType<DataT>()));
+    return false;
+  }
+
+  if (frame.width() != reader.width() || frame.height() != reader.height() || frame.channels() != reader.channels()) {
+    frame = ImageT(reader.width(), reader.height(), reader.channels());
+  }
+
+  while (reader.read(frame.getImageBuffer()->data())) {
+    if (!push(frame, sink)) {
+      return false;
+    }
+  }
+  return reader.eof();
+}
+
+/// \brief convolve all frames of the stream until its end and write the output frames to another stream
+/// \param reader(io::FrameReader &) stream of frames, its channels must match the input channels of the filter
+/// \param writer(io::FrameWriter &) stream receiving the planar output frames
+/// \return bool true if the end of the stream has been reached, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool StreamConvolver<alignment, WeightT, DataT>::operator()(io::FrameReader &reader, io::FrameWriter &writer) {
+  return (*this)(reader, [&writer](const ImageT &out) { return writer.write(out.getImageBuffer()->data()); });
+}
+
+/// \brief convolve a single frame and hand its output to the sink
+/// \param input(const ImageT &) the next frame, its channels must match the input channels of the filter
+/// \param sink(const SinkT &) receives the output of the frame, which is only valid until the sink returns
+/// \return bool true on success, false on error or if the sink stopped the stream
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool StreamConvolver<alignment, WeightT, DataT>::push(const ImageT &input, const SinkT &sink) {
+  conv.setImage(input);
+  if (!conv.convolve()) {
+    return false;
+  }
+
+  const uint32_t outWidth = getOutputSize(input.width(), params.strideX);
+  const uint32_t outHeight = getOutputSize(input.height(), params.strideY);
+  if (output.width() != outWidth || output.height() != outHeight || output.channels() != filterPtr->numOutputChannels()) {
+    output = ImageT(outWidth, outHeight, filterPtr->numOutputChannels());
+  }
+
+  if (!conv.store(output, 0, 0)) {
+    return false;
+  }
+  ++frames;
+  return sink(output);
+}
+
+}  // namespace core
+}  // namespace convolution
@@ -0,0 +1,81 @@
+#ifndef CONVOLUTION_CORE_TILESCHEDULER_H
+#define CONVOLUTION_CORE_TILESCHEDULER_H
+
+#include <convolution/core/ConvolutionParams.h>
+#include <convolution/core/Convolver.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/img2col.h>
+#include <convolution/core/logging.h>
+#include <convolution/io/Image.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \class TileScheduler
+/// \brief convolution of batches of images of very different sizes on all cores using work stealing
+///
+///  The convolution of every image is decomposed into tasks of bands of output rows, sized so that the column buffer
+///  of a band fits into the cache. Tiny images form a single task, huge images many. The tasks are dealt in contiguous
+///  chunks to per-thread deques, so that each thread works through neighbouring bands of the same image. A thread
+///  running out of tasks steals from the opposite end of the deque of another thread, which balances a single huge
+///  image against hundreds of tiny ones without idle cores at the tail of the batch.
+///
+/// \tparam alignment(uint32_t) specifies the alignment of the column and filter buffer in support of the MxPxP multiplier to be used
+/// \tparam WeightT(typename) the C++ type used for the filter weights
+/// \tparam DataT(typename) the C++ type used for the image data
+template <uint32_t alignment, typename WeightT = uint8_t, typename DataT = uint8_t>
+class TileScheduler {
+ public:
+  using ConvolverT = Convolver<alignment, WeightT, DataT>;  ///< the convolver used by each thread
+  using ImageT = typename ConvolverT::ImageT;                ///< the image type used for the input and output
+
+  /// default number of output pixels of a band, the column buffer of a band of a 3x3x3 filter then takes about 256 KiB
+  static constexpr uint32_t kBandPixels = 8192;
+
+ private:
+  /// \brief band of output rows of a single image
+  struct Task {
+    uint32_t image = 0;  ///< index of the image in the batch
+    uint32_t y = 0;      ///< first output row of the band
+    uint32_t rows = 0;   ///< number of output rows of the band
+  };
+
+  /// \brief deque of tasks of a thread, the owner pops from the front, thieves steal from the back
+  struct TaskQueue {
+    std::mutex mutex;        ///< protects the tasks
+    std::deque<Task> tasks;  ///< tasks not yet started
+  };
+
+  std::shared_ptr<IFilter<WeightT>> filterPtr;          ///< filter used for the convolution
+  ConvolutionParams params;                             ///< stride and dilation of the convolution
+  uint32_t numThreads = 0;                              ///< number of threads
+  uint32_t bandPixels = 0;                              ///< number of output pixels per band
+  std::vector<std::unique_ptr<ConvolverT>> convolvers;  ///< convolver of each thread, keeps its buffers between batches
+  std::atomic<uint64_t> steals{0};                      ///< number of tasks stolen during the last batch
+
+  std::optional<Task> pop(std::vector<TaskQueue> &queues, const uint32_t thread);
+  bool work(const std::vector<ImageT> &images, std::vector<ImageT> &outputs, std::vector<TaskQueue> &queues, const uint32_t thread);
+
+ public:
+  TileScheduler(std::shared_ptr<IFilter<WeightT>> f, const ConvolutionParams &p = ConvolutionParams(), const uint32_t threads = 0, const uint32_t pixels = kBandPixels);
+
+  bool operator()(const std::vector<ImageT> &images, std::vector<ImageT> &outputs);
+
+  uint32_t numWorkers() const { return numThreads; }  ///< returns the number of threads
+  uint64_t numSteals() const { return steals; }       ///< returns the number of tasks stolen during the last batch
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/TileScheduler.inl>
+
+#endif  // CONVOLUTION_CORE_TILESCHEDULER_H
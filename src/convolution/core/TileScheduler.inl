@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+
+namespace convolution {
+namespace core {
+
+/// \brief construct a TileScheduler for the filter and sampling parameters provided
+/// \param f(std::shared_ptr<IFilter<WeightT>>) filter used for the convolution
+/// \param p(const ConvolutionParams &) stride and dilation of the convolution
+/// \param threads(const uint32_t) number of threads, 0 uses one thread per hardware thread
+/// \param pixels(const uint32_t) number of output pixels per band, at least one row is convolved per band
+template <uint32_t alignment, typename WeightT, typename DataT>
+TileScheduler<alignment, WeightT, DataT>::TileScheduler(std::shared_ptr<IFilter<WeightT>> f, const ConvolutionParams &p, const uint32_t threads, const uint32_t pixels)
+    : filterPtr(f), params(p), numThreads(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())), bandPixels(std::max(1u, pixels)) {
+  for (uint32_t t = 0; t < numThreads; ++t) {
+    convolvers.push_back(std::make_unique<ConvolverT>(f, p));
+  }
+}
+
+/// \brief convolve a batch of images
+/// \param images(const std::vector<ImageT> &) images of any size, their channels must match the input channels of the filter
+/// \param outputs(std::vector<ImageT> &) receives the planar output of each image
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool TileScheduler<alignment, WeightT, DataT>::operator()(const std::vector<ImageT> &images, std::vector<ImageT> &outputs) {
+  outputs.resize(images.size());
+  std::vector<Task> tasks;
+  for (uint32_t i = 0; i < images.size(); ++i) {
+    if (!images[i].getImageBuffer() || images[i].getImageBuffer()->empty()) {
+      spdlog::error("Image {} of the batch is empty, failed to convolve the batch.", i);
+      return false;
+    }
+
+    const uint32_t outWidth = getOutputSize(images[i].width(), params.strideX);
+    const uint32_t outHeight = getOutputSize(images[i].height(), params.strideY);
+    const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+    if (outputs[i].width() != outWidth || outputs[i].height() != outHeight || outputs[i].channels() != numOutputChannels || outputs[i].layout() != io::Layout::kPlanar) {
+      outputs[i] = ImageT(outWidth, outHeight, numOutputChannels);
+    }
+
+    const uint32_t rows = std::max(1u, bandPixels / outWidth);
+    for (uint32_t y = 0; y < outHeight; y += rows) {
+      tasks.push_back(Task{i, y, std::min(rows, outHeight - y)});
+    }
+  }
+
+  // contiguous chunks keep the bands of an image on the same thread unless they are stolen
+  const uint32_t threads = std::min<uint32_t>(numThreads, std::max<size_t>(1, tasks.size()));
+  std::vector<TaskQueue> queues(threads);
+  for (uint32_t t = 0; t < threads; ++t) {
+    const size_t begin = tasks.size() * t / threads;
+    const size_t end = tasks.size() * (t + 1) / threads;
+    queues[t].tasks.assign(tasks.begin() + begin, tasks.begin() + end);
+  }
+
+  steals = 0;
+  std::atomic<bool> success = true;
+  std::vector<std::thread> pool;
+  for (uint32_t t = 1; t < threads; ++t) {
+    pool.emplace_back([&, t]() {
+      if (!work(images, outputs, queues, t)) {
+        success = false;
+      }
+    });
+  }
+  if (!work(images, outputs, queues, 0)) {
+    success = false;
+  }
+  for (std::thread &thread : pool) {
+    thread.join();
+  }
+
+  spdlog::debug("Convolved a batch of {} images in {} bands using {} threads and {} steals.", images.size(), tasks.size(), threads, steals.load());
+  return success;
+}
+
+/// take the next task of the thread, or steal one from the back of the fullest deque of another thread
+template <uint32_t alignment, typename WeightT, typename DataT>
+std::optional<typename TileScheduler<alignment, WeightT, DataT>::Task> TileScheduler<alignment, WeightT, DataT>::pop(std::vector<TaskQueue> &queues, const uint32_t thread) {
+  {
+    TaskQueue &own = queues[thread];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      const Task task = own.tasks.front();
+      own.tasks.pop_front();
+      return task;
+    }
+  }
+
+  // tasks are never added during a batch, so the search ends once all deques have been found empty
+  while (true) {
+    uint32_t victim = thread;
+    size_t largest = 0;
+    for (uint32_t t = 0; t < queues.size(); ++t) {
+      std::lock_guard<std::mutex> lock(queues[t].mutex);
+      if (queues[t].tasks.size() > largest) {
+        largest = queues[t].tasks.size();
+        victim = t;
+      }
+    }
+    if (largest == 0) {
+      return std::nullopt;
+    }
+
+    std::lock_guard<std::mutex> lock(queues[victim].mutex);
+    if (!queues[victim].tasks.empty()) {
+      const Task task = queues[victim].tasks.back();
+      queues[victim].tasks.pop_back();
+      ++steals;
+      return task;
+    }
+  }
+}
+
+/// convolve tasks until all deques are empty, the bands are stored into disjoint rows of the outputs
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool TileScheduler<alignment, WeightT, DataT>::work(const std::vector<ImageT> &images, std::vector<ImageT> &outputs, std::vector<TaskQueue> &queues, const uint32_t thread) {
+  ConvolverT &conv = *convolvers[thread];
+  bool success = true;
+  uint32_t current = static_cast<uint32_t>(images.size());
+  while (const std::optional<Task> task = pop(queues, thread)) {
+    if (task->image != current) {
+      conv.setImage(images[task->image]);
+      current = task->image;
+    }
+
+    const Region band{0, task->y, outputs[task->image].width(), task->rows};
+    try {
+      if (!conv.convolve(band) || !conv.store(outputs[task->image], 0, task->y)) {
+        success = false;
+      }
+    } catch (...) {
+      // an exception, e.g. an overflow of the accumulators, fails the batch instead of terminating the thread
+      spdlog::error("Band at row {} of image {} failed with an exception", task->y, task->image);
+      success = false;
+    }
+  }
+
+  // the convolver doesn't keep the images of the batch alive
+  conv.setImage(ImageT());
+  return success;
+}
+
+}  // namespace core
+}  // namespace convolution
@@ -0,0 +1,58 @@
+#ifndef CONVOLUTION_CORE_TILEDCONVOLVER_H
+#define CONVOLUTION_CORE_TILEDCONVOLVER_H
+
+#include <convolution/core/ConvolutionParams.h>
+#include <convolution/core/Convolver.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/img2col.h>
+#include <convolution/core/logging.h>
+#include <convolution/io/Image.h>
+#include <convolution/io/RawFile.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace convolution {
+namespace core {
+
+/// \class TiledConvolver
+/// \brief out-of-core convolution of raw tensor files that don't fit into memory
+///
+///  The output is produced in tiles of tileWidth x tileHeight output pixels. For each tile only the input pixels
+///  covered by the filter, i.e. the tile grown by its halo, are read from the input file, and the narrowed output
+///  tile is written to the output file right away. The resident memory is bounded by the tile size, regardless of
+///  the image size.
+///
+/// \tparam alignment(uint32_t) specifies the alignment of the column and filter buffer in support of the MxPxP multiplier to be used
+/// \tparam WeightT(typename) the C++ type used for the filter weights
+/// \tparam DataT(typename) the C++ type used for the image data
+template <uint32_t alignment, typename WeightT = uint8_t, typename DataT = uint8_t>
+class TiledConvolver {
+ public:
+  using ConvolverT = Convolver<alignment, WeightT, DataT>;  ///< the convolver used for each tile
+  using ImageT = typename ConvolverT::ImageT;                ///< the image type used for the input and output tiles
+
+ private:
+  std::shared_ptr<IFilter<WeightT>> filterPtr;  ///< filter used for the convolution
+  ConvolutionParams params;                     ///< stride and dilation of the convolution
+  ConvolverT conv;                              ///< convolver reused for all tiles
+  uint32_t tileWidth = 0;                       ///< tile width in output pixels
+  uint32_t tileHeight = 0;                      ///< tile height in output pixels
+  typename ImageT::StoragePtr inputBuffer;      ///< buffer of the input tile including its halo
+  typename ImageT::StoragePtr outputBuffer;     ///< buffer of the output tile
+
+ public:
+  TiledConvolver(std::shared_ptr<IFilter<WeightT>> f, const uint32_t width, const uint32_t height, const ConvolutionParams &p = ConvolutionParams());
+
+  bool operator()(const fs::path &input, const fs::path &output);
+
+  size_t bufferSize() const { return inputBuffer->size() + outputBuffer->size(); }  ///< returns the number of elements allocated for the tiles
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#include <convolution/core/TiledConvolver.inl>
+
+#endif  // CONVOLUTION_CORE_TILEDCONVOLVER_H
@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <cstdint>
+
+namespace convolution {
+namespace core {
+
+/// \brief construct a TiledConvolver for the filter, tile size and sampling parameters provided
+/// \param f(std::shared_ptr<IFilter<WeightT>>) filter used for the convolution
+/// \param width(const uint32_t) tile width in output pixels
+/// \param height(const uint32_t) tile height in output pixels
+/// \param p(const ConvolutionParams &) stride and dilation of the convolution
+template <uint32_t alignment, typename WeightT, typename DataT>
+TiledConvolver<alignment, WeightT, DataT>::TiledConvolver(std::shared_ptr<IFilter<WeightT>> f, const uint32_t width, const uint32_t height, const ConvolutionParams &p)
+    : filterPtr(f), params(p), conv(f, p), tileWidth(width), tileHeight(height), inputBuffer(std::make_shared<typename ImageT::StorageT>()), outputBuffer(std::make_shared<typename ImageT::StorageT>()) {
+  if (tileWidth == 0 || tileHeight == 0) {
+    spdlog::critical("Tile size {}x{} must be positive.", tileWidth, tileHeight);
+    throw std::invalid_argument("Tile size must be positive");
+  }
+}
+
+/// \brief convolve the raw tensor at input tile by tile and write the result as raw tensor to output
+/// \param input(const fs::path &) raw tensor file of the input image
+/// \param output(const fs::path &) raw tensor file created for the output, with one channel per output channel of the filter
+/// \return bool true on success, false otherwise
+template <uint32_t alignment, typename WeightT, typename DataT>
+bool TiledConvolver<alignment, WeightT, DataT>::operator()(const fs::path &input, const fs::path &output) {
+  auto in = io::RawFile::open(input);
+  if (!in) {
+    return false;
+  }
+
+  const io::RawHeader &header = in->getHeader();
+  if (header.type != io::getRawType<DataT>()) {
+    spdlog::error("Raw tensor {} has type {}, expected {}.", input.c_str(), static_cast<uint32_t>(header.type), static_cast<uint32_t>(io::getRawType<DataT>()));
+    return false;
+  }
+
+  const uint32_t width = header.width;
+  const uint32_t height = header.height;
+  const uint32_t channels = header.channels;
+  const uint32_t outWidth = getOutputSize(width, params.strideX);
+  const uint32_t outHeight = getOutputSize(height, params.strideY);
+  const uint32_t numOutputChannels = filterPtr->numOutputChannels();
+
+  auto out = io::RawFile::create(output, outWidth, outHeight, numOutputChannels, io::getRawType<DataT>());
+  if (!out) {
+    return false;
+  }
+
+  // halo of input pixels required around the centers of the output pixels
+  const uint32_t leftHalo = filterPtr->leftPadding() * params.dilationX;
+  const uint32_t rightHalo = filterPtr->rightPadding() * params.dilationX;
+  const uint32_t topHalo = filterPtr->topPadding() * params.dilationY;
+  const uint32_t bottomHalo = filterPtr->bottomPadding() * params.dilationY;
+
+  // returns the input range [begin, end) covering the output range [outBegin, outEnd), begin is a multiple of the stride
+  auto inputRange = [](const uint32_t outBegin, const uint32_t outEnd, const uint32_t stride, const uint32_t before, const uint32_t after, const uint32_t size) {
+    const uint64_t center = static_cast<uint64_t>(outBegin) * stride;
+    uint64_t begin = center - std::min<uint64_t>(center, before);
+    begin -= begin % stride;
+    const uint64_t end = std::min<uint64_t>(size, static_cast<uint64_t>(outEnd - 1) * stride + after + 1);
+    return std::make_pair(static_cast<uint32_t>(begin), static_cast<uint32_t>(end));
+  };
+
+  for (uint32_t oy = 0; oy < outHeight; oy += tileHeight) {
+    const uint32_t oh = std::min(tileHeight, outHeight - oy);
+    const auto [iy, iyEnd] = inputRange(oy, oy + oh, params.strideY, topHalo, bottomHalo, height);
+
+    for (uint32_t ox = 0; ox < outWidth; ox += tileWidth) {
+      const uint32_t ow = std::min(tileWidth, outWidth - ox);
+      const auto [ix, ixEnd] = inputRange(ox, ox + ow, params.strideX, leftHalo, rightHalo, width);
+
+      // read the input tile including its halo
+      ImageT tile(ixEnd - ix, iyEnd - iy, channels, inputBuffer);
+      for (uint32_t c = 0; c < channels; ++c) {
+        for (uint32_t y = 0; y < tile.height(); ++y) {
+          if (!in->read(ix, iy + y, c, tile.width(), inputBuffer->data() + tile.calcImageBufferOffset(0, y, c))) {
+            return false;
+          }
+        }
+      }
+
+      // convolve the output pixels of the tile, the halo only provides the input for the border pixels
+      conv.setImage(tile);
+      if (!conv.convolve(Region{ox - ix / params.strideX, oy - iy / params.strideY, ow, oh})) {
+        return false;
+      }
+
+      ImageT outTile(ow, oh, numOutputChannels, outputBuffer);
+      if (!conv.store(outTile, 0, 0)) {
+        return false;
+      }
+
+      for (uint32_t c = 0; c < numOutputChannels; ++c) {
+        for (uint32_t y = 0; y < oh; ++y) {
+          if (!out->write(ox, oy + y, c, ow, outputBuffer->data() + outTile.calcImageBufferOffset(0, y, c))) {
+            return false;
+          }
+        }
+      }
+    }
+  }
+
+  spdlog::info("Convolved raw tensor {} {}x{}x{} in tiles of {}x{} into {}", input.c_str(), width, height, channels, tileWidth, tileHeight, output.c_str());
+  return true;
+}
+
+}  // namespace core
+}  // namespace convolution
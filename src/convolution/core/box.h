@@ -0,0 +1,141 @@
+#ifndef CONVOLUTION_CORE_BOX_H
+#define CONVOLUTION_CORE_BOX_H
+
+#include <convolution/core/img2col.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \brief sums of n taps at distance d along a line, evaluated at the left-most taps begin + i * stride for i < count
+/// Taps outside of [0, size) are zero. The sums are updated by a running sum, which adds the tap entering and subtracts
+/// the tap leaving the window, so that the cost doesn't depend on n. Each residue modulo d runs its own running sum.
+/// Sparse evaluations, i.e. a stride much larger than the window, sum the taps directly.
+/// \tparam S(typename) type of the sums
+/// \tparam GetT(typename) callable returning the value at a position inside of the line
+/// \tparam PutT(typename) callable receiving the index i and the sum at begin + i * stride
+/// \param begin(const int64_t) first evaluated position, may be negative
+/// \param count(const uint32_t) number of evaluated positions
+/// \param stride(const uint32_t) distance between evaluated positions
+/// \param n(const uint32_t) number of taps
+/// \param d(const uint32_t) distance between taps
+/// \param size(const int64_t) length of the line
+/// \param get(GetT) callable returning the value at a position
+/// \param put(PutT) callable receiving the sums
+template <typename S, typename GetT, typename PutT>
+void slidingSum(const int64_t begin, const uint32_t count, const uint32_t stride, const uint32_t n, const uint32_t d, const int64_t size, GetT get, PutT put) {
+  auto at = [&](const int64_t x) { return x >= 0 && x < size ? static_cast<S>(get(x)) : S(0); };
+  auto window = [&](const int64_t x) {
+    S sum = 0;
+    for (uint32_t j = 0; j < n; ++j) {
+      sum += at(x + static_cast<int64_t>(j) * d);
+    }
+    return sum;
+  };
+
+  const int64_t span = static_cast<int64_t>(count - 1) * stride + 1;
+  if (static_cast<int64_t>(count) * n <= span) {
+    for (uint32_t i = 0; i < count; ++i) {
+      put(i, window(begin + static_cast<int64_t>(i) * stride));
+    }
+    return;
+  }
+
+  const int64_t end = begin + span;
+  for (uint32_t r = 0; r < d && r < span; ++r) {
+    S sum = window(begin + r);
+    for (int64_t x = begin + r; x < end; x += d) {
+      if ((x - begin) % stride == 0) {
+        put(static_cast<uint32_t>((x - begin) / stride), sum);
+      }
+      sum += at(x + static_cast<int64_t>(n) * d) - at(x);
+    }
+  }
+}
+
+/// \brief convolution with a box filter, i.e. weights constant over the filter window of each pair of channels
+/// Every output channel is a weighted sum of the window sums of the input channels of its group. The window sums are
+/// computed separably by core::slidingSum, first along the image rows, then along the columns of the output pixels, so
+/// that the cost per output pixel doesn't depend on the filter size. Integral sums are exact, so that the results equal
+/// the ones of the multiplication of all taps as long as the latter doesn't overflow.
+/// The output is written directly in the layout of the transform buffer, one row of N output channels per output pixel.
+/// \tparam R(typename) accumulator type of the output, must be integral
+/// \tparam T(typename) the C++ type used to represent a single channel pixel
+/// \tparam W(typename) the C++ type used for the filter weights
+/// \tparam useOverflowDetection(bool) detect overflow of the accumulator
+/// \param shape(const ColumnShape &) image and filter dimensions and output region, imgChannels is the number of input channels per group
+/// \param numGroups(const uint32_t) number of filter groups
+/// \param img(const T *) planar or interleaved image buffer
+/// \param weights(const W *) weight of input channel ic of the group in output channel oc at oc * shape.imgChannels + ic
+/// \param numOutputChannels(const uint32_t) number of output channels
+/// \param N(const uint32_t) aligned number of output channels
+/// \param out(R *) output with N elements per output pixel, cleared by the caller
+/// \param rowSums(std::vector<int64_t> &) scratch buffer of the row sums
+/// \param boxSums(std::vector<int64_t> &) scratch buffer of the window sums
+/// \return bool true on success, false if the accumulator overflowed
+template <typename R, typename T, typename W, bool useOverflowDetection = false>
+bool box(const ColumnShape &shape, const uint32_t numGroups, const T *img, const W *weights, const uint32_t numOutputChannels, const uint32_t N, R *out, std::vector<int64_t> &rowSums, std::vector<int64_t> &boxSums) {
+  static_assert(std::is_integral_v<R>, "box filters require an integral result type to be exact");
+
+  const uint32_t imgChannels = shape.imgChannels * numGroups;
+  const uint32_t outputChannelsPerGroup = numOutputChannels / numGroups;
+  const uint64_t channelStride = shape.interleaved ? 1 : shape.pixels();
+  const uint64_t pixelStride = shape.interleaved ? imgChannels : 1;
+
+  // left-most and top-most taps of the first output pixel
+  const int64_t x0 = static_cast<int64_t>(shape.outOffsetX) * shape.strideX - shape.leftPadding;
+  const int64_t y0 = static_cast<int64_t>(shape.outOffsetY) * shape.strideY - shape.topPadding;
+  // image rows covered by the taps of the output pixels
+  const int64_t rowBegin = std::max<int64_t>(0, y0);
+  const int64_t rowEnd = std::min<int64_t>(shape.imgHeight, y0 + static_cast<int64_t>(shape.outHeight - 1) * shape.strideY + static_cast<int64_t>(shape.filterHeight - 1) * shape.dilationY + 1);
+  const uint32_t numRows = rowEnd > rowBegin ? static_cast<uint32_t>(rowEnd - rowBegin) : 0;
+
+  // the row sums are stored column by column, so that the vertical pass reads them contiguously
+  rowSums.resize(static_cast<size_t>(shape.outWidth) * numRows);
+  boxSums.resize(shape.outputPixels());
+  bool noOverflow = true;
+
+  for (uint32_t c = 0; c < imgChannels; ++c) {
+    const T *plane = img + c * channelStride;
+    for (uint32_t row = 0; row < numRows; ++row) {
+      const T *line = plane + static_cast<uint64_t>(rowBegin + row) * shape.imgWidth * pixelStride;
+      slidingSum<int64_t>(x0, shape.outWidth, shape.strideX, shape.filterWidth, shape.dilationX, shape.imgWidth, [&](const int64_t x) { return line[x * pixelStride]; },
+                          [&](const uint32_t out_x, const int64_t sum) { rowSums[static_cast<size_t>(out_x) * numRows + row] = sum; });
+    }
+    for (uint32_t out_x = 0; out_x < shape.outWidth; ++out_x) {
+      const int64_t *column = rowSums.data() + static_cast<size_t>(out_x) * numRows;
+      slidingSum<int64_t>(y0 - rowBegin, shape.outHeight, shape.strideY, shape.filterHeight, shape.dilationY, numRows, [&](const int64_t y) { return column[y]; },
+                          [&](const uint32_t out_y, const int64_t sum) { boxSums[static_cast<size_t>(out_y) * shape.outWidth + out_x] = sum; });
+    }
+
+    // weight the window sums of the channel into the output channels of its group
+    const uint32_t group = c / shape.imgChannels;
+    const uint32_t ic = c % shape.imgChannels;
+    for (uint32_t oc = group * outputChannelsPerGroup; oc < (group + 1) * outputChannelsPerGroup; ++oc) {
+      const W w = weights[static_cast<uint64_t>(oc) * shape.imgChannels + ic];
+      if (w == W(0)) {
+        continue;
+      }
+      R *dst = out + oc;
+      for (uint32_t p = 0; p < shape.outputPixels(); ++p, dst += N) {
+        if constexpr (useOverflowDetection) {
+          R product = 0;
+          noOverflow &= !__builtin_mul_overflow(boxSums[p], w, &product);
+          noOverflow &= !__builtin_add_overflow(*dst, product, dst);
+        } else {
+          *dst += static_cast<R>(boxSums[p] * w);
+        }
+      }
+    }
+  }
+  return noOverflow;
+}
+
+}  // namespace core
+}  // namespace convolution
+
+#endif  // CONVOLUTION_CORE_BOX_H
@@ -0,0 +1,72 @@
+#ifndef CONVOLUTION_CORE_HASH_H
+#define CONVOLUTION_CORE_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace convolution {
+namespace core {
+
+/// \brief final mixing of a 64Bit hash, every input bit affects every output bit
+inline uint64_t mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ull;
+  h ^= h >> 33;
+  return h;
+}
+
+/// \brief returns an identity of the arithmetic type T, types of a different size, signedness or representation differ
+template <typename T>
+constexpr uint64_t typeIdentity() {
+  static_assert(std::is_arithmetic_v<T>, "type identities are only defined for arithmetic types");
+  return sizeof(T) | (std::is_signed_v<T> ? 0x100u : 0u) | (std::is_floating_point_v<T> ? 0x200u : 0u);
+}
+
+/// \brief fast non-cryptographic 64Bit hash of a buffer, e.g. of the pixels of an image
+/// The buffer is consumed in blocks of 32 bytes by 4 independent lanes, which keeps the multipliers busy, so that the
+/// hash runs close to the memory bandwidth for large images.
+/// \param data(const void *) buffer to hash
+/// \param size(const size_t) size of the buffer in bytes
+/// \param seed(const uint64_t) seed of the hash, e.g. the hash of further data
+/// \return uint64_t hash of the buffer
+inline uint64_t hash(const void *data, const size_t size, const uint64_t seed = 0) {
+  constexpr uint64_t k1 = 0x9e3779b97f4a7c15ull;
+  constexpr uint64_t k2 = 0xc2b2ae3d27d4eb4full;
+  auto round = [](const uint64_t h, const uint64_t word) {
+    const uint64_t x = h + word * k2;
+    return ((x << 31) | (x >> 33)) * k1;
+  };
+
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  uint64_t lanes[4] = {seed + k1, seed ^ k2, seed - k1, seed ^ (k1 + k2)};
+  size_t offset = 0;
+  for (; offset + 32 <= size; offset += 32) {
+    for (uint32_t i = 0; i < 4; ++i) {
+      uint64_t word;
+      std::memcpy(&word, bytes + offset + 8 * i, sizeof(word));
+      lanes[i] = round(lanes[i], word);
+    }
+  }
+
+  uint64_t h = mix(lanes[0]) ^ mix(lanes[1] + k1) ^ mix(lanes[2] + k2) ^ mix(lanes[3] - k1);
+  for (; offset + 8 <= size; offset += 8) {
+    uint64_t word;
+    std::memcpy(&word, bytes + offset, sizeof(word));
+    h = round(h, word);
+  }
+  if (offset < size) {
+    uint64_t word = 0;
+    std::memcpy(&word, bytes + offset, size - offset);
+    h = round(h, word);
+  }
+  return mix(h ^ size);
+}
+
+}  // namespace core
+}  // namespace convolution
+
+#endif  // CONVOLUTION_CORE_HASH_H
@@ -0,0 +1,324 @@
+#ifndef CONVOLUTION_CORE_IMG2COL_H
+#define CONVOLUTION_CORE_IMG2COL_H
+
+#include <convolution/core/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace convolution {
+namespace core {
+
+/// \brief rectangular region in output pixel coordinates, which equal image coordinates for a stride of 1
+struct Region {
+  uint32_t x = 0;       ///< left-most output pixel of the region
+  uint32_t y = 0;       ///< top-most output pixel of the region
+  uint32_t width = 0;   ///< width of the region in output pixels
+  uint32_t height = 0;  ///< height of the region in output pixels
+};
+
+/// \brief image and filter dimensions required by the img2col kernels
+/// The shape is resolved once per image so that no virtual filter queries are made inside the kernels.
+struct ColumnShape {
+  uint32_t imgWidth = 0;                  ///< image width in pixels
+  uint32_t imgHeight = 0;                 ///< image height in pixels
+  uint32_t imgChannels = 0;               ///< number of image channels
+  uint32_t filterWidth = 0;               ///< filter width in pixels
+  uint32_t filterHeight = 0;              ///< filter height in pixels
+  uint32_t leftPadding = 0;               ///< padding required on the left of the image, including dilation
+  uint32_t topPadding = 0;                ///< padding required on the top of the image, including dilation
+  uint32_t strideX = 1;                   ///< horizontal distance between output pixels in the input image
+  uint32_t strideY = 1;                   ///< vertical distance between output pixels in the input image
+  uint32_t dilationX = 1;                 ///< horizontal distance between filter taps
+  uint32_t dilationY = 1;                 ///< vertical distance between filter taps
+  uint32_t outOffsetX = 0;                ///< horizontal position of the first output pixel to transform
+  uint32_t outOffsetY = 0;                ///< vertical position of the first output pixel to transform
+  uint32_t outWidth = 0;                  ///< number of output pixels to transform horizontally
+  uint32_t outHeight = 0;                 ///< number of output pixels to transform vertically
+  uint32_t columnBufferWidthAligned = 0;  ///< aligned number of elements in a single row of the column buffer
+  bool interleaved = false;               ///< the image buffer uses the interleaved layout instead of planes
+
+  uint32_t filterSize() const { return filterWidth * filterHeight; }  ///< returns the number of filter taps per channel
+  uint64_t pixels() const { return static_cast<uint64_t>(imgWidth) * imgHeight; }  ///< returns the number of image pixels
+  uint32_t outputPixels() const { return outWidth * outHeight; }      ///< returns the number of output pixels, i.e. rows in the column buffer
+};
+
+/// \brief returns the output size along one dimension, one output pixel is produced for every stride input pixels
+inline uint32_t getOutputSize(const uint32_t size, const uint32_t stride) {
+  return (size + stride - 1) / stride;
+}
+
+/// \brief copy the kWidth taps of a single column buffer row segment, clipping taps outside of the image line
+/// \param src(const T *) first pixel of the image line
+/// \param dst(T *) destination in the column buffer
+/// \param x(int32_t) position of the left-most tap in the image line, may be negative
+template <typename T, uint32_t kWidth>
+inline void copyTaps(const T *src, T *dst, const int32_t x, const int32_t imgWidth) {
+  for (uint32_t fx = 0; fx < kWidth; ++fx) {
+    const int32_t sx = x + fx;
+    if (sx >= 0 && sx < imgWidth) {
+      dst[fx] = src[sx];
+    }
+  }
+}
+
+/// \brief img2col kernel with filter height, filter width and channel count resolved at compile time
+/// The column buffer must be cleared before calling the kernel, taps outside of the image are skipped.
+/// Only the output pixels of the region described by the shape are transformed, i.e. the column buffer has
+/// shape.outputPixels() rows and the cost of the kernel is proportional to the output region.
+/// The kernel requires dilationX == 1, so that the taps of a filter row are contiguous in the image.
+/// \see http://15418.courses.cs.cmu.edu/fall2017/lecture/dnn/slide_023
+/// \tparam T(typename) the C++ type used to represent a single channel pixel
+/// \tparam kHeight(uint32_t) filter height
+/// \tparam kWidth(uint32_t) filter width
+/// \tparam kChannels(uint32_t) number of image channels
+/// \param shape(const ColumnShape &) image and filter dimensions
+/// \param img(const T *) planar image buffer
+/// \param col(T *) row-major column buffer
+template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t kChannels>
+void img2colKernel(const ColumnShape &shape, const T *img, T *col) {
+  const int32_t imgWidth = shape.imgWidth;
+  const int32_t imgHeight = shape.imgHeight;
+  const int32_t outWidth = shape.outWidth;
+  const int32_t outHeight = shape.outHeight;
+  const int32_t offsetX = shape.outOffsetX;
+  const int32_t offsetY = shape.outOffsetY;
+  const int32_t strideX = shape.strideX;
+  const int32_t strideY = shape.strideY;
+  const int32_t dilationY = shape.dilationY;
+  // padding relative to the first output pixel of the region, negative inside of the image
+  const int32_t leftPadding = (int32_t)shape.leftPadding - offsetX * strideX;
+  const int32_t topPadding = (int32_t)shape.topPadding - offsetY * strideY;
+  const uint32_t ldc = shape.columnBufferWidthAligned;
+  const uint64_t planeSize = shape.pixels();
+
+  // the range of output x positions for which all taps are inside of the image line
+  const int32_t lastInner = imgWidth - (int32_t)kWidth + (int32_t)shape.leftPadding;
+  const int32_t innerBegin = std::clamp<int32_t>(((int32_t)shape.leftPadding + strideX - 1) / strideX - offsetX, 0, outWidth);
+  const int32_t innerEnd = lastInner < 0 ? innerBegin : std::clamp<int32_t>(lastInner / strideX + 1 - offsetX, innerBegin, outWidth);
+
+  for (int32_t out_y = 0; out_y < outHeight; ++out_y) {
+    T *rowPtr = col + (uint64_t)out_y * outWidth * ldc;
+    for (uint32_t img_c = 0; img_c < kChannels; ++img_c) {
+      for (uint32_t filter_y = 0; filter_y < kHeight; ++filter_y) {
+        const int32_t src_y = out_y * strideY - topPadding + filter_y * dilationY;
+        if (src_y < 0 || src_y >= imgHeight) {
+          continue;
+        }
+        const T *src = img + img_c * planeSize + static_cast<uint64_t>(src_y) * imgWidth;
+        T *dst = rowPtr + img_c * kHeight * kWidth + filter_y * kWidth;
+
+        int32_t out_x = 0;
+        for (; out_x < innerBegin; ++out_x, dst += ldc) {
+          copyTaps<T, kWidth>(src, dst, out_x * strideX - leftPadding, imgWidth);
+        }
+        for (; out_x < innerEnd; ++out_x, dst += ldc) {
+          memcpy(dst, src + out_x * strideX - leftPadding, kWidth * sizeof(T));
+        }
+        for (; out_x < outWidth; ++out_x, dst += ldc) {
+          copyTaps<T, kWidth>(src, dst, out_x * strideX - leftPadding, imgWidth);
+        }
+      }
+    }
+  }
+}
+
+/// \brief generic img2col kernel used as fallback for filter shapes without a specialized kernel and for horizontal dilation
+/// \see img2colKernel
+template <typename T>
+void img2colGeneric(const ColumnShape &shape, const T *img, T *col) {
+  const int32_t imgWidth = shape.imgWidth;
+  const int32_t imgHeight = shape.imgHeight;
+  const int32_t outWidth = shape.outWidth;
+  const int32_t outHeight = shape.outHeight;
+  const uint32_t filterWidth = shape.filterWidth;
+  const uint32_t filterHeight = shape.filterHeight;
+  const int32_t strideX = shape.strideX;
+  const int32_t strideY = shape.strideY;
+  const int32_t leftPadding = (int32_t)shape.leftPadding - (int32_t)shape.outOffsetX * strideX;
+  const int32_t topPadding = (int32_t)shape.topPadding - (int32_t)shape.outOffsetY * strideY;
+  const int32_t dilationX = shape.dilationX;
+  const int32_t dilationY = shape.dilationY;
+  const uint32_t ldc = shape.columnBufferWidthAligned;
+  const uint64_t planeSize = shape.pixels();
+
+  for (int32_t out_y = 0; out_y < outHeight; ++out_y) {
+    T *rowPtr = col + (uint64_t)out_y * outWidth * ldc;
+    for (uint32_t img_c = 0; img_c < shape.imgChannels; ++img_c) {
+      for (uint32_t filter_y = 0; filter_y < filterHeight; ++filter_y) {
+        const int32_t src_y = out_y * strideY - topPadding + filter_y * dilationY;
+        if (src_y < 0 || src_y >= imgHeight) {
+          continue;
+        }
+        const T *src = img + img_c * planeSize + static_cast<uint64_t>(src_y) * imgWidth;
+        T *dst = rowPtr + img_c * filterHeight * filterWidth + filter_y * filterWidth;
+        for (int32_t out_x = 0; out_x < outWidth; ++out_x, dst += ldc) {
+          for (uint32_t filter_x = 0; filter_x < filterWidth; ++filter_x) {
+            const int32_t src_x = out_x * strideX - leftPadding + filter_x * dilationX;
+            if (src_x >= 0 && src_x < imgWidth) {
+              dst[filter_x] = src[src_x];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/// \brief copy the kWidth taps of all kChannels channels of an interleaved image line, clipping taps outside of the line
+/// \param src(const T *) first pixel of the interleaved image line
+/// \param dst(T *) destination in the column buffer
+/// \param x(int32_t) position of the left-most tap in the image line, may be negative
+template <typename T, uint32_t kWidth, uint32_t kChannels>
+inline void copyPixels(const T *src, T *dst, const int32_t x, const int32_t imgWidth) {
+  for (uint32_t fx = 0; fx < kWidth; ++fx) {
+    const int32_t sx = x + fx;
+    if (sx >= 0 && sx < imgWidth) {
+      memcpy(dst + fx * kChannels, src + static_cast<int64_t>(sx) * kChannels, kChannels * sizeof(T));
+    }
+  }
+}
+
+/// \brief img2col kernel for interleaved images with filter height, filter width and channel count resolved at compile time
+/// The taps of a filter row are a single contiguous run of kWidth * kChannels elements in an interleaved image, which
+/// is copied at once. The column buffer rows are therefore ordered by filter row, filter column and channel, i.e.
+/// the tap (fx, fy) of channel c is stored at (fy * kWidth + fx) * kChannels + c, and the filter must be permuted
+/// accordingly.
+/// \see img2colKernel
+template <typename T, uint32_t kHeight, uint32_t kWidth, uint32_t kChannels>
+void img2colInterleavedKernel(const ColumnShape &shape, const T *img, T *col) {
+  const int32_t imgWidth = shape.imgWidth;
+  const int32_t imgHeight = shape.imgHeight;
+  const int32_t outWidth = shape.outWidth;
+  const int32_t outHeight = shape.outHeight;
+  const int32_t offsetX = shape.outOffsetX;
+  const int32_t offsetY = shape.outOffsetY;
+  const int32_t strideX = shape.strideX;
+  const int32_t strideY = shape.strideY;
+  const int32_t dilationY = shape.dilationY;
+  const int32_t leftPadding = (int32_t)shape.leftPadding - offsetX * strideX;
+  const int32_t topPadding = (int32_t)shape.topPadding - offsetY * strideY;
+  const uint32_t ldc = shape.columnBufferWidthAligned;
+  const uint64_t lineSize = static_cast<uint64_t>(shape.imgWidth) * kChannels;
+
+  // the range of output x positions for which all taps are inside of the image line
+  const int32_t lastInner = imgWidth - (int32_t)kWidth + (int32_t)shape.leftPadding;
+  const int32_t innerBegin = std::clamp<int32_t>(((int32_t)shape.leftPadding + strideX - 1) / strideX - offsetX, 0, outWidth);
+  const int32_t innerEnd = lastInner < 0 ? innerBegin : std::clamp<int32_t>(lastInner / strideX + 1 - offsetX, innerBegin, outWidth);
+
+  for (int32_t out_y = 0; out_y < outHeight; ++out_y) {
+    T *rowPtr = col + (uint64_t)out_y * outWidth * ldc;
+    for (uint32_t filter_y = 0; filter_y < kHeight; ++filter_y) {
+      const int32_t src_y = out_y * strideY - topPadding + filter_y * dilationY;
+      if (src_y < 0 || src_y >= imgHeight) {
+        continue;
+      }
+      const T *src = img + static_cast<uint64_t>(src_y) * lineSize;
+      T *dst = rowPtr + filter_y * kWidth * kChannels;
+
+      int32_t out_x = 0;
+      for (; out_x < innerBegin; ++out_x, dst += ldc) {
+        copyPixels<T, kWidth, kChannels>(src, dst, out_x * strideX - leftPadding, imgWidth);
+      }
+      for (; out_x < innerEnd; ++out_x, dst += ldc) {
+        memcpy(dst, src + static_cast<int64_t>(out_x * strideX - leftPadding) * kChannels, kWidth * kChannels * sizeof(T));
+      }
+      for (; out_x < outWidth; ++out_x, dst += ldc) {
+        copyPixels<T, kWidth, kChannels>(src, dst, out_x * strideX - leftPadding, imgWidth);
+      }
+    }
+  }
+}
+
+/// \brief generic img2col kernel for interleaved images, used for filter shapes without a specialized kernel and for horizontal dilation
+/// \see img2colInterleavedKernel
+template <typename T>
+void img2colInterleavedGeneric(const ColumnShape &shape, const T *img, T *col) {
+  const int32_t imgWidth = shape.imgWidth;
+  const int32_t imgHeight = shape.imgHeight;
+  const int32_t outWidth = shape.outWidth;
+  const int32_t outHeight = shape.outHeight;
+  const uint32_t filterWidth = shape.filterWidth;
+  const uint32_t filterHeight = shape.filterHeight;
+  const uint32_t channels = shape.imgChannels;
+  const int32_t strideX = shape.strideX;
+  const int32_t strideY = shape.strideY;
+  const int32_t leftPadding = (int32_t)shape.leftPadding - (int32_t)shape.outOffsetX * strideX;
+  const int32_t topPadding = (int32_t)shape.topPadding - (int32_t)shape.outOffsetY * strideY;
+  const int32_t dilationX = shape.dilationX;
+  const int32_t dilationY = shape.dilationY;
+  const uint32_t ldc = shape.columnBufferWidthAligned;
+  const uint64_t lineSize = static_cast<uint64_t>(shape.imgWidth) * channels;
+
+  for (int32_t out_y = 0; out_y < outHeight; ++out_y) {
+    T *rowPtr = col + (uint64_t)out_y * outWidth * ldc;
+    for (uint32_t filter_y = 0; filter_y < filterHeight; ++filter_y) {
+      const int32_t src_y = out_y * strideY - topPadding + filter_y * dilationY;
+      if (src_y < 0 || src_y >= imgHeight) {
+        continue;
+      }
+      const T *src = img + static_cast<uint64_t>(src_y) * lineSize;
+      T *dst = rowPtr + filter_y * filterWidth * channels;
+      for (int32_t out_x = 0; out_x < outWidth; ++out_x, dst += ldc) {
+        for (uint32_t filter_x = 0; filter_x < filterWidth; ++filter_x) {
+          const int32_t src_x = out_x * strideX - leftPadding + filter_x * dilationX;
+          if (src_x >= 0 && src_x < imgWidth) {
+            memcpy(dst + filter_x * channels, src + static_cast<int64_t>(src_x) * channels, channels * sizeof(T));
+          }
+        }
+      }
+    }
+  }
+}
+
+/// signature shared by all img2col kernels
+template <typename T>
+using Img2ColKernel = void (*)(const ColumnShape &, const T *, T *);
+
+/// \brief entry of the img2col dispatch table
+template <typename T>
+struct Img2ColEntry {
+  uint32_t height;
+  uint32_t width;
+  uint32_t channels;
+  Img2ColKernel<T> kernel;
+};
+
+/// \brief select the img2col kernel for the filter and image shape provided
+/// Common shapes (1x1, 3x3, 5x5, 7x7 with 1, 3 or 4 channels) without horizontal dilation map to fully
+/// specialized kernels, all other shapes use img2colGeneric. Interleaved images use the interleaved kernels.
+/// \param shape(const ColumnShape &) image and filter dimensions
+/// \return the kernel to be used for the shape
+template <typename T>
+Img2ColKernel<T> selectImg2ColKernel(const ColumnShape &shape) {
+  // clang-format off
+  static constexpr std::array<Img2ColEntry<T>, 12> table = {{
+      {1, 1, 1, &img2colKernel<T, 1, 1, 1>}, {1, 1, 3, &img2colKernel<T, 1, 1, 3>}, {1, 1, 4, &img2colKernel<T, 1, 1, 4>},
+      {3, 3, 1, &img2colKernel<T, 3, 3, 1>}, {3, 3, 3, &img2colKernel<T, 3, 3, 3>}, {3, 3, 4, &img2colKernel<T, 3, 3, 4>},
+      {5, 5, 1, &img2colKernel<T, 5, 5, 1>}, {5, 5, 3, &img2colKernel<T, 5, 5, 3>}, {5, 5, 4, &img2colKernel<T, 5, 5, 4>},
+      {7, 7, 1, &img2colKernel<T, 7, 7, 1>}, {7, 7, 3, &img2colKernel<T, 7, 7, 3>}, {7, 7, 4, &img2colKernel<T, 7, 7, 4>}
+  }};
+  static constexpr std::array<Img2ColEntry<T>, 12> interleavedTable = {{
+      {1, 1, 1, &img2colInterleavedKernel<T, 1, 1, 1>}, {1, 1, 3, &img2colInterleavedKernel<T, 1, 1, 3>}, {1, 1, 4, &img2colInterleavedKernel<T, 1, 1, 4>},
+      {3, 3, 1, &img2colInterleavedKernel<T, 3, 3, 1>}, {3, 3, 3, &img2colInterleavedKernel<T, 3, 3, 3>}, {3, 3, 4, &img2colInterleavedKernel<T, 3, 3, 4>},
+      {5, 5, 1, &img2colInterleavedKernel<T, 5, 5, 1>}, {5, 5, 3, &img2colInterleavedKernel<T, 5, 5, 3>}, {5, 5, 4, &img2colInterleavedKernel<T, 5, 5, 4>},
+      {7, 7, 1, &img2colInterleavedKernel<T, 7, 7, 1>}, {7, 7, 3, &img2colInterleavedKernel<T, 7, 7, 3>}, {7, 7, 4, &img2colInterleavedKernel<T, 7, 7, 4>}
+  }};
+  // clang-format on
+
+  for (const auto &entry : shape.interleaved ? interleavedTable : table) {
+    if (shape.dilationX == 1 && entry.height == shape.filterHeight && entry.width == shape.filterWidth && entry.channels == shape.imgChannels) {
+      return entry.kernel;
+    }
+  }
+
+  spdlog::debug("No specialized img2col kernel for filter {}x{}x{}, using generic kernel.", shape.filterHeight, shape.filterWidth, shape.imgChannels);
+  return shape.interleaved ? &img2colInterleavedGeneric<T> : &img2colGeneric<T>;
+}
+
+}  // namespace core
+}  // namespace convolution
+
+#endif  // CONVOLUTION_CORE_IMG2COL_H
@@ -3,7 +3,11 @@
 
 #include <convolution/core/logging.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 namespace convolution {
 namespace core {
@@ -17,9 +21,9 @@ enum class MatrixOrder {
 template <MatrixOrder order>
 uint64_t address(uint32_t M, uint32_t N, uint32_t m, uint32_t n) {
   if constexpr (order == core::MatrixOrder::kRowMajor) {
-    return N * m + n;
+    return static_cast<uint64_t>(N) * m + n;
   } else {
-    return M * n + m;
+    return static_cast<uint64_t>(M) * n + m;
   }
 }
 
@@ -29,7 +33,7 @@ template <typename T, MatrixOrder order>
 void transpose(uint32_t M, uint32_t N, T *data, T *buffer = nullptr) {
   std::vector<T> tmp;
   if (!buffer) {
-    tmp.resize(M * N);
+    tmp.resize(static_cast<size_t>(M) * N);
     buffer = tmp.data();
   }
   for (uint32_t m = 0; m < M; ++m) {
@@ -41,7 +45,7 @@ void transpose(uint32_t M, uint32_t N, T *data, T *buffer = nullptr) {
       }
     }
   }
-  memcpy(data, buffer, sizeof(T) * M * N);
+  memcpy(data, buffer, sizeof(T) * M * static_cast<size_t>(N));
 }
 
 /// \brief general MxNxK matrix-matrix multiplication c = a * b
@@ -49,20 +53,23 @@ void transpose(uint32_t M, uint32_t N, T *data, T *buffer = nullptr) {
 ///  Matrix a has dimensions MxK
 ///  Matrix b has dimensions KxN
 /// \tparam R(typename) type used by the matrix c storing the result of a * b
-/// \tparam T(typename) type used bu the input matrix a and b
+/// \tparam T(typename) type used bu the input matrix a
 /// \tparam cOrder(MatrixOrder) the storage format used by matrix c
 /// \tparam aOrder(MatrixOrder) the storage format used by matrix a
 /// \tparam bOrder(MatrixOrder) the storage format used by matrix b
 /// \tparam useOverflowDetection(bool) flag used to enable / disable overflow detection at compile time, for instance when R == T
+/// \tparam W(typename) type used by the input matrix b, deduced from b and defaults to T
 /// \param M(uint32_t) matrix dimension
 /// \param N(uint32_t) matrix dimension
 /// \param K(uint32_t) matrix dimension
 /// \param c(R *) raw pointer to output data representing matrix c
 /// \param a(const T *) raw pointer to input data representing matrix a
-/// \param b(const T *) raw pointer to input data representing matrix b
+/// \param b(const W *) raw pointer to input data representing matrix b
 /// \return bool true on success, false otherwise
-template <typename R, typename T, MatrixOrder cOrder, MatrixOrder aOrder, MatrixOrder bOrder, bool useOverflowDetection = false>
-bool gemm(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const T *b) {
+template <typename R, typename T, MatrixOrder cOrder, MatrixOrder aOrder, MatrixOrder bOrder, bool useOverflowDetection = false, typename W = T>
+bool gemm(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const W *b) {
+  static_assert(std::is_signed_v<R> || !(std::is_signed_v<T> || std::is_signed_v<W>), "signed input matrices require a signed result type");
+
   R a_mk = 0;
   R b_kn = 0;
 
@@ -74,24 +81,26 @@ bool gemm(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const T *b) {
         b_kn = b[address<bOrder>(K, N, k, n)];
 
         if constexpr (useOverflowDetection) {
-          R overflow = 0;
-          if (__builtin_mul_overflow(a_mk, b_kn, &overflow)) {
+          // the builtins operate on the type of the result and detect overflow as well as underflow for signed types
+          R product = 0;
+          if (__builtin_mul_overflow(a_mk, b_kn, &product)) {
             return false;
           }
-          if (__builtin_add_overflow(sum, a_mk * b_kn, &overflow)) {
+          if (__builtin_add_overflow(sum, product, &sum)) {
             return false;
           }
+        } else {
+          sum += a_mk * b_kn;
         }
-        sum += a_mk * b_kn;
       }
 
       if constexpr (useOverflowDetection) {
-        R overflow = 0;
-        if (__builtin_add_overflow(c[address<cOrder>(M, N, m, n)], sum, &overflow)) {
+        if (__builtin_add_overflow(c[address<cOrder>(M, N, m, n)], sum, &c[address<cOrder>(M, N, m, n)])) {
           return false;
         }
+      } else {
+        c[address<cOrder>(M, N, m, n)] += sum;
       }
-      c[address<cOrder>(M, N, m, n)] += sum;
     }
   }
 
@@ -99,11 +108,86 @@ bool gemm(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const T *b) {
 }
 
 /// \brief general MxNxK matrix-matrix multiplication c = a * b
-template <typename R, typename T, MatrixOrder order, bool useOverflowDetection = false>
-bool gemm(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const T *b) {
+template <typename R, typename T, MatrixOrder order, bool useOverflowDetection = false, typename W = T>
+bool gemm(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const W *b) {
   return gemm<R, T, order, order, order, useOverflowDetection>(M, N, K, c, a, b);
 }
 
+/// \brief MxPxP matrix-matrix multiplication c = a * b used by core::mult
+/// All matrices use core::MatrixOrder::kColumnMajor. The inner loop runs along M, which is contiguous in a and c,
+/// to allow the compiler to vectorize the kernel for each combination of types.
+/// \tparam R(typename) type used by the matrix c storing the result of a * b
+/// \tparam T(typename) type used by the input matrix a
+/// \tparam W(typename) type used by the input matrix b
+/// \tparam P(uint32_t) size P of the MxPxP matrix multiplier
+/// \tparam useOverflowDetection(bool) flag used to enable / disable overflow detection, requires an integral R
+/// \param M(uint32_t) matrix dimension
+/// \param c(R *) raw pointer to output data representing matrix c
+/// \param a(const T *) raw pointer to input data representing matrix a
+/// \param b(const W *) raw pointer to input data representing matrix b
+/// \return bool true on success, false otherwise
+template <typename R, typename T, typename W, uint32_t P, bool useOverflowDetection = false>
+bool gemmBlock(uint32_t M, R *c, const T *a, const W *b) {
+  static_assert(std::is_signed_v<R> || !(std::is_signed_v<T> || std::is_signed_v<W>), "signed input matrices require a signed result type");
+  static_assert(!useOverflowDetection || std::is_integral_v<R>, "overflow detection requires an integral result type");
+
+  bool noOverflow = true;
+  for (uint32_t n = 0; n < P; ++n) {
+    R *cPtr = c + static_cast<uint64_t>(M) * n;
+    for (uint32_t k = 0; k < P; ++k) {
+      const R b_kn = b[P * n + k];
+      const T *aPtr = a + static_cast<uint64_t>(M) * k;
+      for (uint32_t m = 0; m < M; ++m) {
+        if constexpr (useOverflowDetection) {
+          R product = 0;
+          noOverflow &= !__builtin_mul_overflow(static_cast<R>(aPtr[m]), b_kn, &product);
+          noOverflow &= !__builtin_add_overflow(cPtr[m], product, &cPtr[m]);
+        } else {
+          cPtr[m] += static_cast<R>(aPtr[m]) * b_kn;
+        }
+      }
+    }
+  }
+  return noOverflow;
+}
+
+/// \brief MxPxP matrix-matrix multiplication of unsigned 8Bit activations with signed 8Bit weights c = a * b
+/// The data flow matches vpdpbusd: pairs of u8 x s8 products along K are summed and accumulated into the 32Bit
+/// result. The pair sum is kept in 32Bit, so unlike pmaddubsw it never saturates and the result matches the other
+/// engines exactly. The inner loop runs along M, which is contiguous in a and c, to allow the compiler to vectorize
+/// the kernel.
+/// \tparam P(uint32_t) size P of the MxPxP matrix multiplier, must be even
+/// \tparam useOverflowDetection(bool) detect overflow of the 32Bit result
+/// \param M(uint32_t) matrix dimension
+/// \param c(int32_t *) raw pointer to output data representing matrix c in core::MatrixOrder::kColumnMajor
+/// \param a(const uint8_t *) raw pointer to input data representing matrix a in core::MatrixOrder::kColumnMajor
+/// \param b(const int8_t *) raw pointer to input data representing matrix b in core::MatrixOrder::kColumnMajor
+/// \return bool true on success, false otherwise
+template <uint32_t P, bool useOverflowDetection = false>
+bool gemmU8S8(uint32_t M, int32_t *c, const uint8_t *a, const int8_t *b) {
+  static_assert(P % 2 == 0, "gemmU8S8 requires an even P");
+
+  bool noOverflow = true;
+  for (uint32_t n = 0; n < P; ++n) {
+    int32_t *cPtr = c + static_cast<uint64_t>(M) * n;
+    for (uint32_t k = 0; k < P; k += 2) {
+      const int32_t w0 = b[P * n + k];
+      const int32_t w1 = b[P * n + k + 1];
+      const uint8_t *a0 = a + static_cast<uint64_t>(M) * k;
+      const uint8_t *a1 = a + static_cast<uint64_t>(M) * (k + 1);
+      for (uint32_t m = 0; m < M; ++m) {
+        const int32_t pair = a0[m] * w0 + a1[m] * w1;
+        if constexpr (useOverflowDetection) {
+          noOverflow &= !__builtin_add_overflow(cPtr[m], pair, &cPtr[m]);
+        } else {
+          cPtr[m] += pair;
+        }
+      }
+    }
+  }
+  return noOverflow;
+}
+
 /// \brief general MxNxK matrix-matrix multiplication using an MxPxP matrix-matrix multiplier
 /// Note:
 ///  The storage format for the matrices are constrained to allow efficient traversal and selection
@@ -116,15 +200,17 @@ bool gemm(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const T *b) {
 /// \tparam bOrder(MatrixOrder) the storage format used by matrix b, must be core::MatrixOrder::kRowMajor
 /// \tparam P(uint32_t) size P of the MxPxP matrix multiplier
 /// \tparam useOverflowDetection(bool) flag used to enable / disable overflow detection at compile time, for instance when R == T
+/// \tparam W(typename) type used by the input matrix b, deduced from b and defaults to T
 /// \param M(uint32_t) matrix dimension
 /// \param N(uint32_t) matrix dimension, must be divisible by P
 /// \param K(uint32_t) matrix dimension, must be divisible by P
 /// \param c(R *) raw pointer to output data representing matrix c
 /// \param a(const T *) raw pointer to input data representing matrix a
-/// \param b(const T *) raw pointer to input data representing matrix b
+/// \param b(const W *) raw pointer to input data representing matrix b
+/// \param buffer(W *) optional scratch buffer of 2 * N * P elements, allocated by each call if not provided
 /// \return bool true on success, false otherwise
-template <typename R, typename T, MatrixOrder cOrder, MatrixOrder aOrder, MatrixOrder bOrder, uint32_t P, bool useOverflowDetection = false>
-bool mult(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const T *b) {
+template <typename R, typename T, MatrixOrder cOrder, MatrixOrder aOrder, MatrixOrder bOrder, uint32_t P, bool useOverflowDetection = false, typename W = T>
+bool mult(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const W *b, W *buffer = nullptr) {
   static_assert(aOrder == core::MatrixOrder::kColumnMajor, "Matrix a in c = a x b must be in core::MatrixOrder::kColumnMajor");
   static_assert(bOrder == core::MatrixOrder::kRowMajor, "Matrix b in c = a x b must be in core::MatrixOrder::kRowMajor");
   static_assert(cOrder == core::MatrixOrder::kColumnMajor, "Matrix c in c = a x b must be in core::MatrixOrder::kColumnMajor");
@@ -137,34 +223,42 @@ bool mult(uint32_t M, uint32_t N, uint32_t K, R *c, const T *a, const T *b) {
   bool noOverflow = true;
 
   const T *aPtr = a;
-  const T *bPtr = b;
+  const W *bPtr = b;
   R *cPtr = c;
 
-  // we require one buffer to transpose N*P elements of matrix b
-  std::vector<T> buffer(N * P);
-  const T *bufferPtr = buffer.data();
+  // we require one buffer to transpose N*P elements of matrix b, followed by the scratch buffer of the transpose
+  std::vector<W> tmp;
+  if (!buffer) {
+    tmp.resize(2 * static_cast<size_t>(N) * P);
+    buffer = tmp.data();
+  }
+  const W *bufferPtr = buffer;
 
   // outer loop over K in steps of P
   for (uint32_t p = 0; p < K; p += P) {
     // copy N*P elements from matrix b following bPtr into the buffer
-    memcpy(buffer.data(), bPtr, buffer.size() * sizeof(T));
+    memcpy(buffer, bPtr, static_cast<size_t>(N) * P * sizeof(W));
 
     // transpose data in buffer
-    core::transpose<T, bOrder>(P, N, buffer.data());
+    core::transpose<W, bOrder>(P, N, buffer, buffer + static_cast<size_t>(N) * P);
 
     // reset pointers for inner loop
-    bufferPtr = buffer.data();
+    bufferPtr = buffer;
     cPtr = c;
 
     // inner loop over N in steps of P
     for (uint32_t q = 0; q < N; q += P) {
-      // the MxPxP matrix-matrix multiplication
-      noOverflow &= gemm<R, T, cOrder, aOrder, core::MatrixOrder::kColumnMajor, useOverflowDetection>(M, P, P, cPtr, aPtr, bufferPtr);
+      // the MxPxP matrix-matrix multiplication, u8 x s8 uses the dedicated kernel
+      if constexpr (std::is_same_v<R, int32_t> && std::is_same_v<T, uint8_t> && std::is_same_v<W, int8_t> && P % 2 == 0) {
+        noOverflow &= gemmU8S8<P, useOverflowDetection>(M, cPtr, aPtr, bufferPtr);
+      } else {
+        noOverflow &= gemmBlock<R, T, W, P, useOverflowDetection>(M, cPtr, aPtr, bufferPtr);
+      }
       bufferPtr += P * P;  // step forward P*P elements in buffer
-      cPtr += M * P;       // step forward M*P elements in matrix c
+      cPtr += static_cast<uint64_t>(M) * P;  // step forward M*P elements in matrix c
     }
 
-    aPtr += M * P;  // step forward M*P elements in matrix a
+    aPtr += static_cast<uint64_t>(M) * P;  // step forward M*P elements in matrix a
     bPtr += N * P;  // step forward N*P elements in matrix b
   }
 
@@ -177,6 +271,26 @@ constexpr T getAlignedSize(const T size) {
   return size % alignment == 0 ? size : (size / alignment + 1) * alignment;
 }
 
+/// \brief selects the accumulator type used for the convolution of image data with the weight type provided
+///  - floating point data or weights accumulate into float
+///  - u8 x u8 accumulates into 16Bit, u8 x s8 accumulates into 32Bit
+///  - wider integral types accumulate into 32Bit (u16 x u8) or 64Bit (u16 x u16, u16 x s8)
+/// \tparam DataT(typename) the C++ type used for the image data
+/// \tparam WeightT(typename) the C++ type used for the filter weights
+template <typename DataT, typename WeightT>
+struct Accumulator {
+  static constexpr size_t kProductSize = sizeof(DataT) + sizeof(WeightT);
+  static constexpr bool kSigned = std::is_signed_v<DataT> || std::is_signed_v<WeightT>;
+
+  using SignedT = std::conditional_t<kProductSize <= 2, int32_t, int64_t>;
+  using UnsignedT = std::conditional_t<kProductSize <= 2, uint16_t, std::conditional_t<kProductSize <= 3, uint32_t, uint64_t>>;
+  using IntegralT = std::conditional_t<kSigned, SignedT, UnsignedT>;
+  using type = std::conditional_t<std::is_floating_point_v<DataT> || std::is_floating_point_v<WeightT>, float, IntegralT>;
+};
+
+template <typename DataT, typename WeightT>
+using AccumulatorT = typename Accumulator<DataT, WeightT>::type;
+
 }  // namespace core
 }  // namespace convolution
 
@@ -0,0 +1,97 @@
+#ifndef CONVOLUTION_CORE_POINTWISE_H
+#define CONVOLUTION_CORE_POINTWISE_H
+
+#include <convolution/core/img2col.h>
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace convolution {
+namespace core {
+
+/// \brief returns true if no output channel of a pointwise convolution can overflow R, for any image of data type T
+/// The sum of an output channel lies between the sums of its negative and positive weights scaled by the largest pixel value.
+/// \param weights(const W *) filter in column buffer format, a row-major K x N matrix with one row per input channel
+/// \param K(const uint32_t) number of input channels
+/// \param N(const uint32_t) aligned number of output channels
+template <typename R, typename T, typename W>
+bool pointwiseFits(const W *weights, const uint32_t K, const uint32_t N) {
+  const double maxValue = static_cast<double>(std::numeric_limits<T>::max());
+  for (uint32_t n = 0; n < N; ++n) {
+    double positive = 0;
+    double negative = 0;
+    for (uint32_t k = 0; k < K; ++k) {
+      const double w = static_cast<double>(weights[static_cast<uint64_t>(k) * N + n]);
+      (w > 0 ? positive : negative) += w * maxValue;
+    }
+    if (positive > static_cast<double>(std::numeric_limits<R>::max()) || negative < static_cast<double>(std::numeric_limits<R>::lowest())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/// \brief pointwise (1x1) convolution of a planar image, i.e. a color matrix applied to every output pixel
+/// The input channels are streamed once, from planar or interleaved images, and the output is written directly in the layout of the transform
+/// buffer, one row of N output channels per output pixel, so that neither a column buffer nor a transpose is required.
+/// The inner loop runs along the output channels, which are contiguous in the weights and the output, to allow the
+/// compiler to vectorize the multiply-accumulate of each input channel. With overflow detection the weights are checked
+/// up front, so that the multiply-accumulate only checks each operation if the weights could overflow the accumulator.
+/// \tparam R(typename) accumulator type of the output
+/// \tparam T(typename) the C++ type used to represent a single channel pixel
+/// \tparam W(typename) the C++ type used for the filter weights
+/// \tparam alignment(uint32_t) alignment of N
+/// \tparam useOverflowDetection(bool) detect overflow of the accumulator, requires an integral R
+/// \param shape(const ColumnShape &) image dimensions and output region
+/// \param img(const T *) planar or interleaved image buffer
+/// \param weights(const W *) filter in column buffer format, a row-major K x N matrix with one row per input channel
+/// \param N(const uint32_t) aligned number of output channels
+/// \param out(R *) output with N elements per output pixel, cleared by the caller
+/// \return bool true on success, false if the accumulator overflowed
+template <typename R, typename T, typename W, uint32_t alignment, bool useOverflowDetection = false>
+bool pointwise(const ColumnShape &shape, const T *img, const W *weights, const uint32_t N, R *out) {
+  static_assert(!useOverflowDetection || std::is_integral_v<R>, "overflow detection requires an integral result type");
+
+  if constexpr (useOverflowDetection) {
+    if (pointwiseFits<R, T>(weights, shape.imgChannels, N)) {
+      return pointwise<R, T, W, alignment, false>(shape, img, weights, N, out);
+    }
+  }
+
+  // distance between the channels of a pixel and between horizontally adjacent pixels
+  const uint64_t channelStride = shape.interleaved ? 1 : shape.pixels();
+  const uint64_t pixelStride = shape.interleaved ? shape.imgChannels : 1;
+  bool noOverflow = true;
+
+  for (uint32_t out_y = 0; out_y < shape.outHeight; ++out_y) {
+    const uint64_t src_y = static_cast<uint64_t>(shape.outOffsetY + out_y) * shape.strideY;
+    const T *src = img + (src_y * shape.imgWidth + static_cast<uint64_t>(shape.outOffsetX) * shape.strideX) * pixelStride;
+    R *dst = out + static_cast<uint64_t>(out_y) * shape.outWidth * N;
+
+    for (uint32_t out_x = 0; out_x < shape.outWidth; ++out_x, dst += N) {
+      const T *pixel = src + static_cast<uint64_t>(out_x) * shape.strideX * pixelStride;
+      // the output row never overlaps the weights, which the compiler can't prove if W is a character type
+      R *__restrict row = dst;
+      for (uint32_t ic = 0; ic < shape.imgChannels; ++ic) {
+        const R value = static_cast<R>(pixel[ic * channelStride]);
+        const W *w = weights + static_cast<uint64_t>(ic) * N;
+        for (uint32_t n = 0; n < N; ++n) {
+          if constexpr (useOverflowDetection) {
+            R product = 0;
+            noOverflow &= !__builtin_mul_overflow(value, static_cast<R>(w[n]), &product);
+            noOverflow &= !__builtin_add_overflow(row[n], product, &row[n]);
+          } else {
+            row[n] += value * static_cast<R>(w[n]);
+          }
+        }
+      }
+    }
+  }
+  return noOverflow;
+}
+
+}  // namespace core
+}  // namespace convolution
+
+#endif  // CONVOLUTION_CORE_POINTWISE_H
@@ -0,0 +1,93 @@
+#ifndef CONVOLUTION_CORE_SPARSE_H
+#define CONVOLUTION_CORE_SPARSE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \brief filter in column buffer format compressed to the non-zero weights of each output channel
+/// The taps of output channel n are [offsets[n], offsets[n + 1]), ordered by their row k of the column buffer.
+template <typename W>
+struct SparseFilter {
+  uint32_t K = 0;                 ///< number of rows of the column buffer format
+  uint32_t N = 0;                 ///< number of output channels, including the alignment
+  std::vector<uint32_t> offsets;  ///< first tap of each output channel, followed by the total number of taps
+  std::vector<uint32_t> rows;     ///< row k of the column buffer format of each tap
+  std::vector<W> weights;         ///< weight of each tap
+
+  size_t numTaps() const { return weights.size(); }  ///< returns the number of non-zero weights
+};
+
+/// \brief compress a filter in column buffer format to its non-zero weights
+/// The storage of sparse is reused, so that compressing filters of the same size repeatedly doesn't allocate.
+/// \tparam W(typename) the C++ type used for the filter weights
+/// \param b(const W *) filter in column buffer format, a row-major K x N matrix
+/// \param K(const uint32_t) number of rows of b
+/// \param N(const uint32_t) number of columns of b
+/// \param sparse(SparseFilter<W> &) receives the taps of each output channel
+template <typename W>
+void compress(const W *b, const uint32_t K, const uint32_t N, SparseFilter<W> &sparse) {
+  sparse.K = K;
+  sparse.N = N;
+  sparse.offsets.clear();
+  sparse.rows.clear();
+  sparse.weights.clear();
+  for (uint32_t n = 0; n < N; ++n) {
+    sparse.offsets.push_back(sparse.rows.size());
+    for (uint32_t k = 0; k < K; ++k) {
+      const W weight = b[static_cast<uint64_t>(k) * N + n];
+      if (weight != W(0)) {
+        sparse.rows.push_back(k);
+        sparse.weights.push_back(weight);
+      }
+    }
+  }
+  sparse.offsets.push_back(sparse.rows.size());
+}
+
+/// \brief MxNxK matrix-matrix multiplication c += a * b with a compressed matrix b, only the non-zero weights are applied
+/// Every tap scales a column of a into a column of c, the inner loop runs along M, which is contiguous in a and c, to
+/// allow the compiler to vectorize the kernel. The taps of each element of c are accumulated in the order of k, as by
+/// core::mult, so that the results are bit-identical to the dense multiplication.
+/// \tparam R(typename) type used by the matrix c storing the result of a * b
+/// \tparam T(typename) type used by the input matrix a
+/// \tparam W(typename) type used by the input matrix b
+/// \tparam useOverflowDetection(bool) flag used to enable / disable overflow detection, requires an integral R
+/// \param M(uint32_t) matrix dimension
+/// \param c(R *) raw pointer to output data representing matrix c in core::MatrixOrder::kColumnMajor
+/// \param a(const T *) raw pointer to input data representing matrix a in core::MatrixOrder::kColumnMajor
+/// \param b(const SparseFilter<W> &) compressed matrix b
+/// \return bool true on success, false otherwise
+template <typename R, typename T, typename W, bool useOverflowDetection = false>
+bool sparseMult(uint32_t M, R *c, const T *a, const SparseFilter<W> &b) {
+  static_assert(std::is_signed_v<R> || !(std::is_signed_v<T> || std::is_signed_v<W>), "signed input matrices require a signed result type");
+  static_assert(!useOverflowDetection || std::is_integral_v<R>, "overflow detection requires an integral result type");
+
+  bool noOverflow = true;
+  for (uint32_t n = 0; n < b.N; ++n) {
+    R *cPtr = c + static_cast<uint64_t>(M) * n;
+    for (uint32_t tap = b.offsets[n]; tap < b.offsets[n + 1]; ++tap) {
+      const R b_kn = b.weights[tap];
+      const T *aPtr = a + static_cast<uint64_t>(M) * b.rows[tap];
+      for (uint32_t m = 0; m < M; ++m) {
+        if constexpr (useOverflowDetection) {
+          R product = 0;
+          noOverflow &= !__builtin_mul_overflow(static_cast<R>(aPtr[m]), b_kn, &product);
+          noOverflow &= !__builtin_add_overflow(cPtr[m], product, &cPtr[m]);
+        } else {
+          cPtr[m] += static_cast<R>(aPtr[m]) * b_kn;
+        }
+      }
+    }
+  }
+  return noOverflow;
+}
+
+}  // namespace core
+}  // namespace convolution
+
+#endif  // CONVOLUTION_CORE_SPARSE_H
@@ -0,0 +1,77 @@
+#ifndef CONVOLUTION_CORE_STATS_H
+#define CONVOLUTION_CORE_STATS_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace convolution {
+namespace core {
+
+/// \brief statistics of a single output channel, collected while the output is stored
+/// The histogram bins have equal widths and cover [lower, upper], which the caller sets to the range the filter can
+/// produce, so that the bins are known before the first output pixel.
+/// \tparam T(typename) the C++ type used to represent a single output channel pixel
+template <typename T>
+struct ChannelStats {
+  /// the sum is accumulated in the widest type to avoid overflow of the output type
+  using SumT = std::conditional_t<std::is_floating_point_v<T>, double, std::conditional_t<std::is_signed_v<T>, int64_t, uint64_t>>;
+  static constexpr uint32_t kNumBins = 256;  ///< number of histogram bins
+
+  T min = std::numeric_limits<T>::max();     ///< minimum of the output pixels
+  T max = std::numeric_limits<T>::lowest();  ///< maximum of the output pixels
+  SumT sum = 0;                              ///< sum of the output pixels
+  uint64_t count = 0;                        ///< number of output pixels
+  double lower = 0;                          ///< lower bound of the first histogram bin
+  double upper = 0;                          ///< upper bound of the last histogram bin
+  std::vector<uint64_t> histogram;           ///< kNumBins bins over [lower, upper], empty if not collected
+
+  /// \brief clear the statistics, the histogram is collected over [lo, hi] if withHistogram is set
+  void reset(const bool withHistogram, const double lo = 0, const double hi = 0) {
+    min = std::numeric_limits<T>::max();
+    max = std::numeric_limits<T>::lowest();
+    sum = 0;
+    count = 0;
+    lower = lo;
+    upper = hi;
+    histogram.assign(withHistogram ? kNumBins : 0, 0);
+  }
+
+  /// \brief add a single output pixel
+  void add(const T value) {
+    min = std::min(min, value);
+    max = std::max(max, value);
+    sum += value;
+    ++count;
+    if (!histogram.empty()) {
+      const double position = upper > lower ? (static_cast<double>(value) - lower) * kNumBins / (upper - lower) : 0;
+      ++histogram[static_cast<uint32_t>(std::clamp(position, 0.0, kNumBins - 1.0))];
+    }
+  }
+
+  double mean() const { return count ? static_cast<double>(sum) / count : 0; }  ///< returns the mean of the output pixels
+
+  /// \brief rescale a value from [min, max] to the range of D, [0, 1] for floating point types, rounded to the nearest integer otherwise
+  /// \tparam D(typename) the C++ type of the rescaled value
+  template <typename D>
+  D normalize(const T value) const {
+    constexpr double range = std::is_floating_point_v<D> ? 1.0 : static_cast<double>(std::numeric_limits<D>::max());
+    if (max <= min) {
+      return D(0);
+    }
+    const double scaled = (static_cast<double>(value) - min) * range / (static_cast<double>(max) - min);
+    if constexpr (std::is_floating_point_v<D>) {
+      return static_cast<D>(std::clamp(scaled, 0.0, range));
+    } else {
+      return static_cast<D>(std::lround(std::clamp(scaled, 0.0, range)));
+    }
+  }
+};
+
+}  // namespace core
+}  // namespace convolution
+
+#endif  // CONVOLUTION_CORE_STATS_H
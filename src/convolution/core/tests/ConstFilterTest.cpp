@@ -0,0 +1,125 @@
+#include <convolution/core/ConstFilter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace convolution;
+
+namespace {
+
+/// reference convolution of a single channel image with a row-major filter, taps outside of the image are zero
+template <typename R, typename D, typename T>
+std::vector<R> convolveReference(const std::vector<D> &img, const uint32_t width, const uint32_t height, const T *weights, const uint32_t kHeight, const uint32_t kWidth) {
+  std::vector<R> out(width * height);
+  const int32_t leftPadding = (kWidth - 1) / 2;
+  const int32_t topPadding = (kHeight - 1) / 2;
+  for (int32_t y = 0; y < (int32_t)height; ++y) {
+    for (int32_t x = 0; x < (int32_t)width; ++x) {
+      R sum = 0;
+      for (int32_t fy = 0; fy < (int32_t)kHeight; ++fy) {
+        for (int32_t fx = 0; fx < (int32_t)kWidth; ++fx) {
+          const int32_t sx = x - leftPadding + fx;
+          const int32_t sy = y - topPadding + fy;
+          if (sx >= 0 && sx < (int32_t)width && sy >= 0 && sy < (int32_t)height) {
+            sum += R(img[sy * width + sx]) * R(weights[fy * kWidth + fx]);
+          }
+        }
+      }
+      out[y * width + x] = sum;
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST(ConstFilterTest, NonZeroTaps) {
+  ASSERT_EQ(core::Binomial3x3<uint8_t>::numNonZeroTaps(), 9u);
+  ASSERT_EQ(core::Laplacian3x3<int8_t>::numNonZeroTaps(), 5u);
+  ASSERT_EQ(core::SobelX3x3<int8_t>::numNonZeroTaps(), 6u);
+}
+
+TEST(ConstFilterTest, ColumnBuffer) {
+  constexpr uint32_t alignment = 4;
+  using TestFilter = core::Binomial3x3<uint8_t, alignment>;
+  using ReferenceFilter = core::Filter<uint8_t, 3, 3, 1, 1, alignment>;
+
+  TestFilter filter;
+  ReferenceFilter reference(std::vector<uint8_t>(TestFilter::kElements.begin(), TestFilter::kElements.end()));
+
+  ASSERT_EQ(memcmp(filter.getFilterBuffer(), reference.getFilterBuffer(), ReferenceFilter::kNumElements), 0);
+  ASSERT_EQ(memcmp(filter.getColumnBuffer(), reference.getColumnBuffer(), ReferenceFilter::kNumElementsAligned), 0);
+}
+
+TEST(ConstFilterTest, Binomial) {
+  constexpr uint32_t width = 23;
+  constexpr uint32_t height = 17;
+  constexpr uint32_t channels = 3;
+  auto img = core::test::getRandomVector<uint8_t>(width * height * channels);
+
+  {
+    using TestFilter = core::Binomial3x3<uint8_t>;
+    std::vector<uint16_t> out(img.size());
+    TestFilter::apply<uint16_t>(img.data(), out.data(), width, height, channels);
+
+    for (uint32_t c = 0; c < channels; ++c) {
+      std::vector<uint8_t> plane(img.begin() + c * width * height, img.begin() + (c + 1) * width * height);
+      auto expected = convolveReference<uint16_t>(plane, width, height, TestFilter::kElements.data(), 3, 3);
+      ASSERT_TRUE(std::equal(expected.begin(), expected.end(), out.begin() + c * width * height));
+    }
+  }
+  {
+    using TestFilter = core::Binomial5x5<uint8_t>;
+    std::vector<uint32_t> out(img.size());
+    TestFilter::apply<uint32_t>(img.data(), out.data(), width, height, channels);
+
+    for (uint32_t c = 0; c < channels; ++c) {
+      std::vector<uint8_t> plane(img.begin() + c * width * height, img.begin() + (c + 1) * width * height);
+      auto expected = convolveReference<uint32_t>(plane, width, height, TestFilter::kElements.data(), 5, 5);
+      ASSERT_TRUE(std::equal(expected.begin(), expected.end(), out.begin() + c * width * height));
+    }
+  }
+}
+
+TEST(ConstFilterTest, SignedWeights) {
+  constexpr uint32_t width = 19;
+  constexpr uint32_t height = 11;
+  auto img = core::test::getRandomVector<uint8_t>(width * height);
+
+  {
+    using TestFilter = core::Laplacian3x3<int8_t>;
+    std::vector<int32_t> out(img.size());
+    TestFilter::apply<int32_t>(img.data(), out.data(), width, height);
+    auto expected = convolveReference<int32_t>(img, width, height, TestFilter::kElements.data(), 3, 3);
+    ASSERT_EQ(expected, out);
+  }
+  {
+    using TestFilter = core::SobelX3x3<int8_t>;
+    std::vector<int32_t> out(img.size());
+    TestFilter::apply<int32_t>(img.data(), out.data(), width, height);
+    auto expected = convolveReference<int32_t>(img, width, height, TestFilter::kElements.data(), 3, 3);
+    ASSERT_EQ(expected, out);
+  }
+  {
+    using TestFilter = core::SobelY3x3<int8_t>;
+    std::vector<float> out(img.size());
+    TestFilter::apply<float>(img.data(), out.data(), width, height);
+    auto expected = convolveReference<float>(img, width, height, TestFilter::kElements.data(), 3, 3);
+    ASSERT_EQ(expected, out);
+  }
+}
+
+TEST(ConstFilterTest, SmallImage) {
+  // images smaller than the filter only use the clipped path
+  constexpr uint32_t width = 3;
+  constexpr uint32_t height = 2;
+  auto img = core::test::getRandomVector<uint8_t>(width * height);
+
+  using TestFilter = core::Binomial5x5<uint8_t>;
+  std::vector<uint32_t> out(img.size());
+  TestFilter::apply<uint32_t>(img.data(), out.data(), width, height);
+  auto expected = convolveReference<uint32_t>(img, width, height, TestFilter::kElements.data(), 5, 5);
+  ASSERT_EQ(expected, out);
+}
@@ -0,0 +1,150 @@
+#include <convolution/core/ConvolutionCache.h>
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <convolution/io/Image.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace convolution;
+
+namespace {
+
+constexpr uint32_t alignment = 4;
+using FilterPtr = std::shared_ptr<core::IFilter<uint8_t>>;
+using Cache = core::ConvolutionCache<alignment>;
+
+}  // namespace
+
+TEST(ConvolutionCacheTest, Hash) {
+  std::vector<uint8_t> buffer(1000);
+  std::iota(buffer.begin(), buffer.end(), 0);
+  const uint64_t h = core::hash(buffer.data(), buffer.size());
+  ASSERT_EQ(h, core::hash(buffer.data(), buffer.size()));
+  ASSERT_NE(h, core::hash(buffer.data(), buffer.size() - 1));
+  ASSERT_NE(h, core::hash(buffer.data(), buffer.size(), 1));
+
+  // every byte of the buffer, including the tail, affects the hash
+  for (size_t i : {0, 31, 32, 500, 995, 999}) {
+    buffer[i] ^= 1;
+    ASSERT_NE(h, core::hash(buffer.data(), buffer.size())) << "byte " << i;
+    buffer[i] ^= 1;
+  }
+}
+
+TEST(ConvolutionCacheTest, MemoryTier) {
+  spdlog::set_level(spdlog::level::warn);
+  const io::Image image = core::test::createImage(33, 21, 3, 1);
+  FilterPtr filter = core::test::createFilter<alignment>(3, 3, 2, 1);
+  Cache cache;
+
+  io::Image output;
+  ASSERT_TRUE(cache(filter, image, output));
+  ASSERT_EQ(cache.misses(), 1u);
+  ASSERT_EQ(cache.hits(), 0u);
+  ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<alignment>(image, filter));
+
+  // changes of the returned output don't affect the cached output
+  std::fill(output.getImageBuffer()->begin(), output.getImageBuffer()->end(), 0);
+  ASSERT_TRUE(cache(filter, image, output));
+  ASSERT_EQ(cache.misses(), 1u);
+  ASSERT_EQ(cache.numMemoryHits(), 1u);
+  ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<alignment>(image, filter));
+
+  // an identical filter object and a copy of the image are hits as well
+  io::Image copy(image.width(), image.height(), image.channels());
+  *copy.getImageBuffer() = *image.getImageBuffer();
+  ASSERT_TRUE(cache(core::test::createFilter<alignment>(3, 3, 2, 1), copy, output));
+  ASSERT_EQ(cache.numMemoryHits(), 2u);
+
+  // different pixels, weights and sampling parameters are misses
+  ASSERT_TRUE(cache(filter, core::test::createImage(33, 21, 3, 2), output));
+  ASSERT_TRUE(cache(core::test::createFilter<alignment>(3, 3, 2, 2), image, output));
+  core::ConvolutionParams params;
+  params.strideX = 2;
+  ASSERT_TRUE(cache(filter, image, output, params));
+  ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<alignment>(image, filter, params));
+  ASSERT_EQ(cache.misses(), 4u);
+  ASSERT_EQ(cache.numEntries(), 4u);
+  ASSERT_EQ(cache.hits(), 2u);
+}
+
+TEST(ConvolutionCacheTest, Eviction) {
+  spdlog::set_level(spdlog::level::warn);
+  FilterPtr filter = core::test::createFilter<alignment>(3, 1, 1, 3);
+  const std::vector<io::Image> images = {core::test::createImage(16, 16, 1, 1), core::test::createImage(16, 16, 1, 2), core::test::createImage(16, 16, 1, 3)};
+
+  // the memory tier holds two outputs of 16x16 pixels
+  core::CacheParams params;
+  params.memoryBytes = 2 * 16 * 16;
+  Cache cache(params);
+
+  io::Image output;
+  ASSERT_TRUE(cache(filter, images[0], output));
+  ASSERT_TRUE(cache(filter, images[1], output));
+  ASSERT_TRUE(cache(filter, images[0], output));
+  ASSERT_EQ(cache.hits(), 1u);
+
+  // images[1] is the least recently used output and evicted by images[2]
+  ASSERT_TRUE(cache(filter, images[2], output));
+  ASSERT_EQ(cache.numEntries(), 2u);
+  ASSERT_EQ(cache.memoryUsage(), params.memoryBytes);
+  ASSERT_TRUE(cache(filter, images[0], output));
+  ASSERT_EQ(cache.hits(), 2u);
+  ASSERT_TRUE(cache(filter, images[1], output));
+  ASSERT_EQ(cache.hits(), 2u);
+  ASSERT_EQ(cache.misses(), 4u);
+  ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<alignment>(images[1], filter));
+}
+
+TEST(ConvolutionCacheTest, DiskTier) {
+  spdlog::set_level(spdlog::level::warn);
+  const fs::path directory = fs::temp_directory_path() / "ConvolutionCacheTest";
+  fs::remove_all(directory);
+  const io::Image image = core::test::createImage(40, 30, 3, 4);
+  FilterPtr filter = core::test::createFilter<alignment>(5, 3, 3, 4);
+
+  core::CacheParams params;
+  params.directory = directory;
+  io::Image output;
+  {
+    Cache cache(params);
+    ASSERT_TRUE(cache(filter, image, output));
+    ASSERT_EQ(cache.misses(), 1u);
+  }
+
+  // a new cache sharing the directory reads the output from disk and promotes it into the memory tier
+  Cache cache(params);
+  ASSERT_TRUE(cache(filter, image, output));
+  ASSERT_EQ(cache.numDiskHits(), 1u);
+  ASSERT_EQ(cache.misses(), 0u);
+  ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<alignment>(image, filter));
+
+  ASSERT_TRUE(cache(filter, image, output));
+  ASSERT_EQ(cache.numMemoryHits(), 1u);
+  ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<alignment>(image, filter));
+
+  // outputs larger than the memory tier are only kept on disk
+  params.memoryBytes = 0;
+  Cache diskOnly(params);
+  ASSERT_TRUE(diskOnly(filter, image, output));
+  ASSERT_TRUE(diskOnly(filter, image, output));
+  ASSERT_EQ(diskOnly.numDiskHits(), 2u);
+  ASSERT_EQ(diskOnly.numEntries(), 0u);
+
+  // signed weights with identical bytes are a different request sharing the directory
+  std::vector<int8_t> signedElements(5 * 5 * 3 * 3);
+  std::memcpy(signedElements.data(), filter->getFilterBuffer(), signedElements.size());
+  core::ConvolutionCache<alignment, int8_t> signedCache(params);
+  ASSERT_TRUE(signedCache(std::make_shared<core::DynamicFilter<int8_t, alignment>>(5, 5, 3, 3, signedElements), image, output));
+  ASSERT_EQ(signedCache.numDiskHits(), 0u);
+  ASSERT_EQ(signedCache.misses(), 1u);
+  fs::remove_all(directory);
+}
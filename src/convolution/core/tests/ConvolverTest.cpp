@@ -2,13 +2,20 @@
 #include <gtest/gtest.h>
 // clang-format on
 
+#include <convolution/core/ConstFilter.h>
 #include <convolution/core/Convolver.h>
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/FilterBank.h>
+#include <convolution/core/GroupedFilter.h>
 #include <convolution/core/tests/TestResources.h>
 #include <convolution/core/logging.h>
 
 #include <boost/preprocessor/stringize.hpp>
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
+#include <optional>
 #include <random>
 #include <memory>
 #include <cstdint>
@@ -25,14 +32,17 @@ using namespace convolution;
 
 namespace {
 
-template <uint32_t alignment>
-class TestConvolver : public core::Convolver<alignment> {
+template <uint32_t alignment, typename WeightT = uint8_t, typename DataT = uint8_t>
+class TestConvolver : public core::Convolver<alignment, WeightT, DataT> {
  public:
-  TestConvolver(std::shared_ptr<core::IFilter<uint8_t>> f) : core::Convolver<alignment>(f) {}
-  using core::Convolver<alignment>::img2col;
-  using core::Convolver<alignment>::read;
-  using core::Convolver<alignment>::calcColumnBufferOffset;
-  using core::Convolver<alignment>::getColumnBuffer;
+  using BaseT = core::Convolver<alignment, WeightT, DataT>;
+  TestConvolver(std::shared_ptr<core::IFilter<WeightT>> f, const core::ConvolutionParams &p = core::ConvolutionParams()) : BaseT(f, p) {}
+  using BaseT::img2col;
+  using BaseT::read;
+  using BaseT::convolve;
+  using BaseT::calcColumnBufferOffset;
+  using BaseT::getColumnBuffer;
+  using BaseT::getTransformBuffer;
 };
 
 CImg<uint8_t> createTestImage(uint32_t height, uint32_t width) {
@@ -49,45 +59,23 @@ CImg<uint8_t> createTestImage(uint32_t height, uint32_t width) {
   return img;
 }
 
-}  // namespace
-
-TEST(ConvolverTest, ColumnBuffer) {
-  // setup test image
-  const uint32_t imgWidth = 17;
-  const uint32_t imgHeight = 13;
-  auto img = createTestImage(imgHeight, imgWidth);
-
-  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage.bmp";
-  img.save(p.c_str());
-
-  // setup test filter
-  constexpr uint32_t fHeight = 3;
-  constexpr uint32_t fWidth = 5;
-  constexpr uint32_t kInputChannels = 3;
-  constexpr uint32_t kOutputChannels = 2;
-  constexpr uint32_t alignment = 3;
-  using TestFilter = core::Filter<uint8_t, fHeight, fWidth, kInputChannels, kOutputChannels, alignment>;
-
-  // create a TestFilter
-  std::shared_ptr<TestFilter> filter = std::make_shared<TestFilter>();
-
-  // create the Convolver using the previously defined filter
-  TestConvolver<alignment> conv(filter);
-
+/// verify the column buffer created by img2col against patches read directly from the test image
+template <uint32_t alignment>
+void verifyColumnBuffer(TestConvolver<alignment> &conv, const core::IFilter<uint8_t> *filter, const fs::path &p) {
   // use convolver to read image
   ASSERT_TRUE(conv.read(p));
 
   // apply img2col transform to image
-  ASSERT_TRUE(conv.img2col<core::MatrixOrder::kRowMajor>());
+  ASSERT_TRUE(conv.template img2col<core::MatrixOrder::kRowMajor>());
 
   // get the column buffer for inspection
-  io::Image::StorageT colBuffer = *(conv.getColumnBuffer());
+  std::vector<uint8_t> colBuffer = *(conv.getColumnBuffer());
 
   // read the test image directly to create the comparison data
   CImg<uint8_t> cimg(p.c_str());
 
   // the patch will contain the image data that covers the filter area
-  io::Image::StorageT patch(fHeight * fWidth);
+  std::vector<uint8_t> patch(filter->height() * filter->width());
   uint32_t patchIdx = 0;
   int32_t qx = 0;
   int32_t qy = 0;
@@ -136,6 +124,1092 @@ TEST(ConvolverTest, ColumnBuffer) {
   }
 }
 
+}  // namespace
+
+TEST(ConvolverTest, ColumnBuffer) {
+  // setup test image
+  const uint32_t imgWidth = 17;
+  const uint32_t imgHeight = 13;
+  auto img = createTestImage(imgHeight, imgWidth);
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage.bmp";
+  img.save(p.c_str());
+
+  // setup test filter
+  constexpr uint32_t fHeight = 3;
+  constexpr uint32_t fWidth = 5;
+  constexpr uint32_t kInputChannels = 3;
+  constexpr uint32_t kOutputChannels = 2;
+  constexpr uint32_t alignment = 3;
+  using TestFilter = core::Filter<uint8_t, fHeight, fWidth, kInputChannels, kOutputChannels, alignment>;
+
+  // create a TestFilter
+  std::shared_ptr<TestFilter> filter = std::make_shared<TestFilter>();
+
+  // create the Convolver using the previously defined filter
+  TestConvolver<alignment> conv(filter);
+
+  verifyColumnBuffer(conv, filter.get(), p);
+}
+
+TEST(ConvolverTest, ColumnBufferDynamicFilter) {
+  // setup test image
+  const uint32_t imgWidth = 17;
+  const uint32_t imgHeight = 13;
+  auto img = createTestImage(imgHeight, imgWidth);
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage.bmp";
+  img.save(p.c_str());
+
+  constexpr uint32_t kInputChannels = 3;
+  constexpr uint32_t kOutputChannels = 2;
+  constexpr uint32_t alignment = 4;
+  using TestFilter = core::DynamicFilter<uint8_t, alignment>;
+
+  // specialized kernels (1x1, 3x3, 5x5, 7x7) and generic fallback (3x5, 9x9)
+  const std::vector<std::pair<uint32_t, uint32_t>> shapes = {{1, 1}, {3, 3}, {5, 5}, {7, 7}, {3, 5}, {9, 9}};
+  for (const auto &[fHeight, fWidth] : shapes) {
+    std::shared_ptr<TestFilter> filter = std::make_shared<TestFilter>(fHeight, fWidth, kInputChannels, kOutputChannels);
+    TestConvolver<alignment> conv(filter);
+    verifyColumnBuffer(conv, filter.get(), p);
+  }
+}
+
+TEST(ConvolverTest, SignedWeights) {
+  // setup test image
+  const uint32_t imgWidth = 17;
+  const uint32_t imgHeight = 13;
+  auto img = createTestImage(imgHeight, imgWidth);
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage.bmp";
+  img.save(p.c_str());
+
+  constexpr uint32_t alignment = 8;
+  constexpr uint32_t kInputChannels = 3;
+  constexpr uint32_t kOutputChannels = 1;
+  using Laplacian = core::Laplacian3x3<int8_t>;
+
+  // apply the Laplacian to the first input channel only
+  auto filter = std::make_shared<core::DynamicFilter<int8_t, alignment>>(3, 3, kInputChannels, kOutputChannels);
+  for (uint32_t fy = 0; fy < 3; ++fy) {
+    for (uint32_t fx = 0; fx < 3; ++fx) {
+      filter->set(fy, fx, 0, 0, Laplacian::kElements[fy * 3 + fx]);
+    }
+  }
+
+  TestConvolver<alignment, int8_t> conv(filter);
+  ASSERT_TRUE(conv.read(p));
+  ASSERT_TRUE(conv.convolve());
+
+  // compute the reference using the direct kernel of the ConstFilter
+  io::Image image{};
+  ASSERT_TRUE(image.read(p));
+  std::vector<int32_t> reference(image.pixels());
+  Laplacian::apply<int32_t>(image.getImageBuffer()->data(), reference.data(), image.width(), image.height());
+
+  auto output = conv.getTransformBuffer();
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(kOutputChannels);
+  bool hasNegative = false;
+  for (uint32_t idx = 0; idx < image.pixels(); ++idx) {
+    ASSERT_EQ((*output)[idx * N], reference[idx]);
+    hasNegative |= reference[idx] < 0;
+  }
+  ASSERT_TRUE(hasNegative);
+}
+
+TEST(ConvolverTest, SignedWeightsSaturated) {
+  // weights near the limits of int8_t on saturated pixels, where pairs of products exceed 16Bit
+  constexpr uint32_t alignment = 8;
+  const int32_t width = 9;
+  const int32_t height = 7;
+  const std::vector<int8_t> elements = {127, 127, -128, 100, 100, -128, -128, 127, 127};
+  auto filter = std::make_shared<core::DynamicFilter<int8_t, alignment>>(3, 3, 1, 1, elements);
+
+  io::BasicImage<uint8_t> image(width, height, 1);
+  std::fill(image.getImageBuffer()->begin(), image.getImageBuffer()->end(), std::numeric_limits<uint8_t>::max());
+
+  core::ConvolutionParams params;
+  params.sparseDensity = 0;
+  params.boxFilters = false;
+  TestConvolver<alignment, int8_t> conv(filter, params);
+  conv.setImage(image);
+  ASSERT_TRUE(conv.convolve());
+
+  auto output = conv.getTransformBuffer();
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(1);
+  for (int32_t y = 0; y < height; ++y) {
+    for (int32_t x = 0; x < width; ++x) {
+      int32_t sum = 0;
+      for (int32_t fy = 0; fy < 3; ++fy) {
+        for (int32_t fx = 0; fx < 3; ++fx) {
+          const int32_t sx = x + fx - 1;
+          const int32_t sy = y + fy - 1;
+          if (sx >= 0 && sx < width && sy >= 0 && sy < height) {
+            sum += std::numeric_limits<uint8_t>::max() * elements[fy * 3 + fx];
+          }
+        }
+      }
+      ASSERT_EQ((*output)[(y * width + x) * N], sum);
+    }
+  }
+}
+
+/// convolve a single channel image with the direct kernel of the ConstFilter and with the multiplication of its weights
+template <typename ConstFilterT, typename DataT>
+void verifyDirectConvolution(const bool expectDirect, const core::ConvolutionParams &params = core::ConvolutionParams(), const uint32_t maxValue = 255) {
+  constexpr uint32_t alignment = 4;
+  using WeightT = typename std::decay_t<decltype(ConstFilterT::kElements)>::value_type;
+  io::BasicImage<DataT> image(19, 11, 1);
+  std::mt19937 generator(5);
+  std::uniform_int_distribution<uint32_t> values(0, maxValue);
+  std::generate(image.getImageBuffer()->begin(), image.getImageBuffer()->end(), [&]() { return static_cast<DataT>(values(generator)); });
+
+  auto filter = std::make_shared<ConstFilterT>();
+  TestConvolver<alignment, WeightT, DataT> direct(filter, params);
+  direct.setImage(image);
+  ASSERT_TRUE(direct.convolve());
+  ASSERT_EQ(direct.isDirect(), expectDirect);
+
+  const std::vector<WeightT> elements(ConstFilterT::kElements.begin(), ConstFilterT::kElements.end());
+  TestConvolver<alignment, WeightT, DataT> reference(std::make_shared<core::DynamicFilter<WeightT, alignment>>(filter->height(), filter->width(), 1, 1, elements), params);
+  reference.setImage(image);
+  ASSERT_TRUE(reference.convolve());
+  ASSERT_FALSE(reference.isDirect());
+  ASSERT_EQ(*direct.getTransformBuffer(), *reference.getTransformBuffer());
+}
+
+TEST(ConvolverTest, ConstFilter) {
+  verifyDirectConvolution<core::Binomial3x3<uint8_t, 4>, uint8_t>(true);
+  verifyDirectConvolution<core::Binomial5x5<uint8_t, 4>, uint8_t>(true);
+  verifyDirectConvolution<core::Binomial5x5<uint8_t, 4>, uint16_t>(true);
+  verifyDirectConvolution<core::Laplacian3x3<int8_t, 4>, uint8_t>(true);
+  verifyDirectConvolution<core::SobelX3x3<int8_t, 4>, uint8_t>(true);
+  verifyDirectConvolution<core::SobelY3x3<int8_t, 4>, uint8_t>(true);
+
+  // strided convolutions and accumulators that may overflow use the multiplication
+  verifyDirectConvolution<core::SobelX3x3<int8_t, 4>, uint8_t>(false, {2, 2, 1, 1});
+  verifyDirectConvolution<core::ConstFilter<uint8_t, 3, 3, 4, 200, 0, 200, 0, 200, 0, 200, 0, 200>, uint8_t>(false, {}, 50);
+}
+
+/// convolve the image at path with random weights and compare against a direct convolution using double precision
+template <typename WeightT, typename DataT>
+void verifyConvolution(const fs::path &p, const WeightT maxWeight, const uint32_t kHeight = 3, const uint32_t kWidth = 3, const core::ConvolutionParams &params = core::ConvolutionParams()) {
+  constexpr uint32_t alignment = 4;
+  constexpr uint32_t kOutputChannels = 2;
+
+  io::BasicImage<DataT> image{};
+  ASSERT_TRUE(image.read(p));
+  const int32_t width = image.width();
+  const int32_t height = image.height();
+  const uint32_t channels = image.channels();
+  const DataT *imgData = image.getImageBuffer()->data();
+
+  std::mt19937 generator(7);
+  std::uniform_real_distribution<double> distribution(0, maxWeight);
+  std::vector<WeightT> elements(kHeight * kWidth * channels * kOutputChannels);
+  std::generate(elements.begin(), elements.end(), [&]() { return static_cast<WeightT>(distribution(generator)); });
+  auto filter = std::make_shared<core::DynamicFilter<WeightT, alignment>>(kHeight, kWidth, channels, kOutputChannels, elements);
+
+  TestConvolver<alignment, WeightT, DataT> conv(filter, params);
+  ASSERT_TRUE(conv.read(p));
+  ASSERT_TRUE(conv.convolve());
+  auto output = conv.getTransformBuffer();
+  using TransformDataT = typename TestConvolver<alignment, WeightT, DataT>::TransformDataT;
+
+  // the output only contains the pixels selected by the stride
+  const int32_t outWidth = (width + params.strideX - 1) / params.strideX;
+  const int32_t outHeight = (height + params.strideY - 1) / params.strideY;
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(kOutputChannels);
+  ASSERT_EQ(output->size(), outWidth * outHeight * N);
+
+  for (int32_t y = 0; y < outHeight; ++y) {
+    for (int32_t x = 0; x < outWidth; ++x) {
+      for (uint32_t oc = 0; oc < kOutputChannels; ++oc) {
+        double sum = 0;
+        for (uint32_t ic = 0; ic < channels; ++ic) {
+          for (int32_t fy = 0; fy < (int32_t)kHeight; ++fy) {
+            for (int32_t fx = 0; fx < (int32_t)kWidth; ++fx) {
+              const int32_t sx = x * params.strideX + (fx - (int32_t)filter->leftPadding()) * params.dilationX;
+              const int32_t sy = y * params.strideY + (fy - (int32_t)filter->topPadding()) * params.dilationY;
+              if (sx >= 0 && sx < width && sy >= 0 && sy < height) {
+                sum += double(imgData[ic * width * height + sy * width + sx]) * double(filter->at(fy, fx, ic, oc));
+              }
+            }
+          }
+        }
+        const TransformDataT result = (*output)[(y * outWidth + x) * N + oc];
+        if constexpr (std::is_floating_point_v<TransformDataT>) {
+          ASSERT_NEAR(result, sum, 1e-3 * sum + 1e-3);
+        } else {
+          ASSERT_EQ(result, static_cast<TransformDataT>(sum));
+        }
+      }
+    }
+  }
+}
+
+TEST(ConvolverTest, Precision) {
+  static_assert(std::is_same_v<core::AccumulatorT<uint8_t, uint8_t>, uint16_t>);
+  static_assert(std::is_same_v<core::AccumulatorT<uint8_t, int8_t>, int32_t>);
+  static_assert(std::is_same_v<core::AccumulatorT<uint16_t, uint8_t>, uint32_t>);
+  static_assert(std::is_same_v<core::AccumulatorT<uint16_t, uint16_t>, uint64_t>);
+  static_assert(std::is_same_v<core::AccumulatorT<float, float>, float>);
+
+  // setup a 16Bit test image
+  const uint32_t imgWidth = 17;
+  const uint32_t imgHeight = 13;
+  CImg<uint16_t> img(imgWidth, imgHeight, 1, 3);
+  for (uint32_t c = 0; c < 3; ++c) {
+    for (uint32_t y = 0; y < imgHeight; ++y) {
+      for (uint32_t x = 0; x < imgWidth; ++x) {
+        img(x, y, 0, c) = 1000 * c + 97 * y + 13 * x;
+      }
+    }
+  }
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage16.png";
+  img.save(p.c_str());
+
+  verifyConvolution<uint8_t, uint16_t>(p, 255);
+  verifyConvolution<uint16_t, uint16_t>(p, 65535);
+  verifyConvolution<float, float>(p, 1);
+}
+
+TEST(ConvolverTest, StrideAndDilation) {
+  // setup test image
+  const uint32_t imgWidth = 17;
+  const uint32_t imgHeight = 13;
+  auto img = createTestImage(imgHeight, imgWidth);
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage.bmp";
+  img.save(p.c_str());
+
+  // specialized 3x3 kernel and generic 3x5 kernel
+  for (const auto &[kHeight, kWidth] : std::vector<std::pair<uint32_t, uint32_t>>{{3, 3}, {3, 5}}) {
+    verifyConvolution<float, float>(p, 1, kHeight, kWidth, {2, 2, 1, 1});
+    verifyConvolution<float, float>(p, 1, kHeight, kWidth, {4, 3, 1, 1});
+    verifyConvolution<float, float>(p, 1, kHeight, kWidth, {1, 1, 2, 2});
+    verifyConvolution<float, float>(p, 1, kHeight, kWidth, {1, 1, 1, 3});
+    verifyConvolution<float, float>(p, 1, kHeight, kWidth, {2, 2, 3, 2});
+    verifyConvolution<uint8_t, uint8_t>(p, 3, kHeight, kWidth, {2, 2, 2, 2});
+  }
+
+  ASSERT_THROW(core::Convolver<4> conv(std::make_shared<core::DynamicFilter<uint8_t, 4>>(3, 3, 3, 1), {0, 1, 1, 1}), std::invalid_argument);
+}
+
+/// convolve the image at path using a grouped filter and an equivalent dense filter with zero weights across groups
+void verifyGroupedConvolution(const fs::path &p, const uint32_t numGroups, const uint32_t channels) {
+  constexpr uint32_t alignment = 4;
+  constexpr uint32_t kHeight = 3;
+  constexpr uint32_t kWidth = 3;
+  constexpr uint32_t kOutputChannelsPerGroup = 2;
+  const uint32_t inputChannelsPerGroup = channels / numGroups;
+  const uint32_t numOutputChannels = numGroups * kOutputChannelsPerGroup;
+
+  auto elements = core::test::getRandomVector<uint8_t>(kHeight * kWidth * inputChannelsPerGroup * numOutputChannels);
+  for (auto &e : elements) {
+    e = e % 4;  //< keep the accumulator within 16Bit
+  }
+  auto grouped = std::make_shared<core::GroupedFilter<uint8_t, alignment>>(kHeight, kWidth, numGroups, inputChannelsPerGroup, kOutputChannelsPerGroup, elements);
+  auto dense = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(kHeight, kWidth, channels, numOutputChannels);
+  for (uint32_t oc = 0; oc < numOutputChannels; ++oc) {
+    const uint32_t group = oc / kOutputChannelsPerGroup;
+    for (uint32_t ic = 0; ic < inputChannelsPerGroup; ++ic) {
+      for (uint32_t fy = 0; fy < kHeight; ++fy) {
+        for (uint32_t fx = 0; fx < kWidth; ++fx) {
+          dense->set(fy, fx, group * inputChannelsPerGroup + ic, oc, grouped->at(fy, fx, ic, oc));
+        }
+      }
+    }
+  }
+
+  TestConvolver<alignment> groupedConv(grouped);
+  ASSERT_TRUE(groupedConv.read(p));
+  ASSERT_TRUE(groupedConv.convolve());
+
+  TestConvolver<alignment> denseConv(dense);
+  ASSERT_TRUE(denseConv.read(p));
+  ASSERT_TRUE(denseConv.convolve());
+
+  ASSERT_EQ(*groupedConv.getTransformBuffer(), *denseConv.getTransformBuffer());
+}
+
+TEST(ConvolverTest, GroupedConvolution) {
+  // setup a 4 channel test image
+  const uint32_t imgWidth = 17;
+  const uint32_t imgHeight = 13;
+  const uint32_t channels = 4;
+  CImg<uint8_t> img(imgWidth, imgHeight, 1, channels);
+  for (uint32_t c = 0; c < channels; ++c) {
+    for (uint32_t y = 0; y < imgHeight; ++y) {
+      for (uint32_t x = 0; x < imgWidth; ++x) {
+        img(x, y, 0, c) = (31 * c + 7 * y + x) % 256;
+      }
+    }
+  }
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage4.png";
+  img.save(p.c_str());
+
+  verifyGroupedConvolution(p, 2, channels);         //< grouped
+  verifyGroupedConvolution(p, channels, channels);  //< depthwise
+
+  // the number of image channels must match the filter groups
+  auto filter = core::GroupedFilter<uint8_t, 4>::depthwise(3, 3, 3, std::vector<uint8_t>(27, 1));
+  TestConvolver<4> conv(filter);
+  ASSERT_TRUE(conv.read(p));
+  ASSERT_FALSE(conv.convolve());
+}
+
+/// convolve regions of the image at path and compare against the corresponding pixels of the whole image convolution
+template <uint32_t alignment>
+void verifyRegions(const fs::path &p, std::shared_ptr<core::IFilter<uint8_t>> filter, const core::ConvolutionParams &params, const std::vector<core::Region> &regions) {
+  TestConvolver<alignment> conv(filter, params);
+  ASSERT_TRUE(conv.read(p));
+  ASSERT_TRUE(conv.convolve());
+  const auto reference = *conv.getTransformBuffer();
+
+  std::vector<typename TestConvolver<alignment>::TransformBufferT> outputs;
+  ASSERT_TRUE(conv.convolve(regions, outputs));
+  ASSERT_EQ(outputs.size(), regions.size());
+
+  io::Image image{};
+  ASSERT_TRUE(image.read(p));
+  const uint32_t outWidth = (image.width() + params.strideX - 1) / params.strideX;
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(filter->numOutputChannels());
+
+  for (size_t idx = 0; idx < regions.size(); ++idx) {
+    const core::Region &r = regions[idx];
+    ASSERT_EQ(outputs[idx].size(), r.width * r.height * N);
+    for (uint32_t y = 0; y < r.height; ++y) {
+      for (uint32_t x = 0; x < r.width; ++x) {
+        for (uint32_t oc = 0; oc < filter->numOutputChannels(); ++oc) {
+          ASSERT_EQ(outputs[idx][(y * r.width + x) * N + oc], reference[((r.y + y) * outWidth + r.x + x) * N + oc]) << "region " << idx << " at " << x << "x" << y;
+        }
+      }
+    }
+  }
+}
+
+TEST(ConvolverTest, Regions) {
+  // setup a 3 channel test image
+  const uint32_t imgWidth = 23;
+  const uint32_t imgHeight = 19;
+  const uint32_t channels = 3;
+  CImg<uint8_t> img(imgWidth, imgHeight, 1, channels);
+  for (uint32_t c = 0; c < channels; ++c) {
+    for (uint32_t y = 0; y < imgHeight; ++y) {
+      for (uint32_t x = 0; x < imgWidth; ++x) {
+        img(x, y, 0, c) = (17 * c + 5 * y + 3 * x) % 256;
+      }
+    }
+  }
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageRegions.png";
+  img.save(p.c_str());
+
+  constexpr uint32_t alignment = 4;
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<uint32_t> distribution(0, 3);
+  auto random = [&](const uint32_t size) {
+    std::vector<uint8_t> elements(size);
+    std::generate(elements.begin(), elements.end(), [&]() { return static_cast<uint8_t>(distribution(generator)); });
+    return elements;
+  };
+
+  // regions in the interior, touching the borders and covering a single pixel
+  const std::vector<core::Region> regions = {{5, 4, 7, 6}, {0, 0, 4, 3}, {18, 15, 5, 4}, {9, 0, 1, 1}, {0, 0, 23, 19}};
+  verifyRegions<alignment>(p, std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, channels, 2, random(3 * 3 * channels * 2)), {}, regions);
+  verifyRegions<alignment>(p, std::make_shared<core::DynamicFilter<uint8_t, alignment>>(5, 5, channels, 1, random(5 * 5 * channels)), {}, regions);
+  verifyRegions<alignment>(p, core::GroupedFilter<uint8_t, alignment>::depthwise(3, 3, channels, random(3 * 3 * channels)), {}, regions);
+
+  // with stride and dilation the regions are given in output pixel coordinates
+  const std::vector<core::Region> stridedRegions = {{2, 1, 4, 5}, {0, 0, 2, 2}, {9, 7, 3, 3}};
+  verifyRegions<alignment>(p, std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, channels, 2, random(3 * 3 * channels * 2)), {2, 2, 1, 2}, stridedRegions);
+  verifyRegions<alignment>(p, std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, channels, 2, random(3 * 3 * channels * 2)), {2, 2, 2, 1}, stridedRegions);
+
+  // regions must be non-empty and inside of the output
+  TestConvolver<alignment> conv(std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, channels, 1, random(3 * 3 * channels)));
+  ASSERT_TRUE(conv.read(p));
+  std::vector<TestConvolver<alignment>::TransformBufferT> outputs;
+  ASSERT_FALSE(conv.convolve({{20, 0, 4, 1}}, outputs));
+  ASSERT_FALSE(conv.convolve({{0, 0, 0, 1}}, outputs));
+}
+
+TEST(ConvolverTest, FilterBank) {
+  // setup a 3 channel test image
+  const uint32_t imgWidth = 21;
+  const uint32_t imgHeight = 11;
+  const uint32_t channels = 3;
+  CImg<uint8_t> img(imgWidth, imgHeight, 1, channels);
+  for (uint32_t c = 0; c < channels; ++c) {
+    for (uint32_t y = 0; y < imgHeight; ++y) {
+      for (uint32_t x = 0; x < imgWidth; ++x) {
+        img(x, y, 0, c) = (41 * c + 3 * y + 7 * x) % 256;
+      }
+    }
+  }
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageBank.png";
+  img.save(p.c_str());
+
+  constexpr uint32_t alignment = 4;
+  std::mt19937 generator(13);
+  std::uniform_int_distribution<uint32_t> distribution(0, 3);
+  auto random = [&](const uint32_t size) {
+    std::vector<uint8_t> elements(size);
+    std::generate(elements.begin(), elements.end(), [&]() { return static_cast<uint8_t>(distribution(generator)); });
+    return elements;
+  };
+
+  std::vector<std::shared_ptr<core::IFilter<uint8_t>>> filters = {
+      std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, channels, 2, random(3 * 3 * channels * 2)),
+      std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, channels, 1, random(3 * 3 * channels)),
+      std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, channels, 3, random(3 * 3 * channels * 3))};
+  auto bank = std::make_shared<core::FilterBank<uint8_t, alignment>>(filters);
+
+  // a single convolution with the bank produces the outputs of all filters
+  TestConvolver<alignment> bankConv(bank);
+  ASSERT_TRUE(bankConv.read(p));
+  ASSERT_TRUE(bankConv.convolve());
+  auto outputs = bank->split(*bankConv.getTransformBuffer(), imgWidth * imgHeight);
+  ASSERT_EQ(outputs.size(), filters.size());
+
+  for (uint32_t idx = 0; idx < filters.size(); ++idx) {
+    TestConvolver<alignment> conv(filters[idx]);
+    ASSERT_TRUE(conv.read(p));
+    ASSERT_TRUE(conv.convolve());
+    auto output = conv.getTransformBuffer();
+    const uint32_t numOutputChannels = filters[idx]->numOutputChannels();
+    const uint32_t N = core::getAlignedSize<uint32_t, alignment>(numOutputChannels);
+    for (uint32_t pixel = 0; pixel < imgWidth * imgHeight; ++pixel) {
+      for (uint32_t oc = 0; oc < numOutputChannels; ++oc) {
+        ASSERT_EQ(outputs[idx][pixel * numOutputChannels + oc], (*output)[pixel * N + oc]);
+      }
+    }
+  }
+}
+
+/// convolve the image at path with pooling and compare against pooling the output of the whole image convolution
+template <uint32_t alignment, typename WeightT>
+void verifyPooling(const fs::path &p, std::shared_ptr<core::IFilter<WeightT>> filter, const core::ConvolutionParams &params, const core::Pooling pooling, const uint32_t poolSize) {
+  using ConvolverT = TestConvolver<alignment, WeightT>;
+  using TransformDataT = typename ConvolverT::TransformDataT;
+
+  ConvolverT conv(filter, params);
+  ASSERT_TRUE(conv.read(p));
+  ASSERT_TRUE(conv.convolve());
+  const auto reference = *conv.getTransformBuffer();
+  ASSERT_TRUE(conv.convolve(pooling, poolSize));
+  const auto output = *conv.getTransformBuffer();
+
+  io::Image image{};
+  ASSERT_TRUE(image.read(p));
+  const uint32_t outWidth = core::getOutputSize(image.width(), params.strideX);
+  const uint32_t outHeight = core::getOutputSize(image.height(), params.strideY);
+  const uint32_t pooledWidth = core::getOutputSize(outWidth, poolSize);
+  const uint32_t pooledHeight = core::getOutputSize(outHeight, poolSize);
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(filter->numOutputChannels());
+  ASSERT_EQ(output.size(), pooledWidth * pooledHeight * N);
+
+  for (uint32_t py = 0; py < pooledHeight; ++py) {
+    for (uint32_t px = 0; px < pooledWidth; ++px) {
+      for (uint32_t oc = 0; oc < filter->numOutputChannels(); ++oc) {
+        int64_t max = std::numeric_limits<int64_t>::min();
+        int64_t sum = 0;
+        int64_t count = 0;
+        for (uint32_t y = py * poolSize; y < std::min((py + 1) * poolSize, outHeight); ++y) {
+          for (uint32_t x = px * poolSize; x < std::min((px + 1) * poolSize, outWidth); ++x) {
+            const int64_t value = reference[(y * outWidth + x) * N + oc];
+            max = std::max(max, value);
+            sum += value;
+            ++count;
+          }
+        }
+        const TransformDataT expected = static_cast<TransformDataT>(pooling == core::Pooling::kMax ? max : sum / count);
+        ASSERT_EQ(output[(py * pooledWidth + px) * N + oc], expected) << "pooled pixel " << px << "x" << py << " channel " << oc;
+      }
+    }
+  }
+
+  // the pooled output is stored and written at the pooled resolution
+  io::Image pooledImage(pooledWidth, pooledHeight, filter->numOutputChannels());
+  ASSERT_TRUE(conv.store(pooledImage, 0, 0));
+  for (uint32_t py = 0; py < pooledHeight; ++py) {
+    for (uint32_t px = 0; px < pooledWidth; ++px) {
+      for (uint32_t oc = 0; oc < filter->numOutputChannels(); ++oc) {
+        const TransformDataT value = output[(py * pooledWidth + px) * N + oc];
+        const uint8_t expected = std::is_signed_v<TransformDataT> ? std::clamp<int64_t>(value, 0, 255) : static_cast<uint8_t>(value);
+        ASSERT_EQ((*pooledImage.getImageBuffer())[pooledImage.calcImageBufferOffset(px, py, oc)], expected);
+      }
+    }
+  }
+  io::Image tooSmall(pooledWidth - 1, pooledHeight, filter->numOutputChannels());
+  ASSERT_FALSE(conv.store(tooSmall, 0, 0));
+
+  fs::path prefix = p.parent_path() / "TestImagePooled";
+  ASSERT_TRUE(conv.write(prefix));
+  io::Image written{};
+  ASSERT_TRUE(written.read(prefix.string() + "_0.png"));
+  ASSERT_EQ(written.width(), pooledWidth);
+  ASSERT_EQ(written.height(), pooledHeight);
+  ASSERT_TRUE(std::equal(written.getImageBuffer()->begin(), written.getImageBuffer()->end(), pooledImage.getImageBuffer()->begin()));
+}
+
+TEST(ConvolverTest, Pooling) {
+  // setup a 3 channel test image with odd dimensions, so that the border windows are partial
+  const uint32_t imgWidth = 19;
+  const uint32_t imgHeight = 15;
+  const uint32_t channels = 3;
+  CImg<uint8_t> img(imgWidth, imgHeight, 1, channels);
+  for (uint32_t c = 0; c < channels; ++c) {
+    for (uint32_t y = 0; y < imgHeight; ++y) {
+      for (uint32_t x = 0; x < imgWidth; ++x) {
+        img(x, y, 0, c) = (23 * c + 11 * y + 5 * x + x * y) % 256;
+      }
+    }
+  }
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImagePooling.png";
+  img.save(p.c_str());
+
+  constexpr uint32_t alignment = 4;
+  std::mt19937 generator(17);
+  std::uniform_int_distribution<int32_t> distribution(-3, 3);
+  auto random = [&](const uint32_t size) {
+    std::vector<int8_t> elements(size);
+    std::generate(elements.begin(), elements.end(), [&]() { return static_cast<int8_t>(distribution(generator)); });
+    return elements;
+  };
+  std::vector<uint8_t> unsignedElements(3 * 3 * channels * 2);
+  for (auto &element : unsignedElements) {
+    element = std::abs(distribution(generator));
+  }
+
+  auto unsignedFilter = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, channels, 2, unsignedElements);
+  auto signedFilter = std::make_shared<core::DynamicFilter<int8_t, alignment>>(3, 3, channels, 3, random(3 * 3 * channels * 3));
+  for (const core::Pooling pooling : {core::Pooling::kMax, core::Pooling::kAverage}) {
+    for (const uint32_t poolSize : {1u, 2u, 3u}) {
+      verifyPooling<alignment, uint8_t>(p, unsignedFilter, {}, pooling, poolSize);
+      verifyPooling<alignment, int8_t>(p, signedFilter, {}, pooling, poolSize);
+    }
+    verifyPooling<alignment, int8_t>(p, signedFilter, {2, 2, 1, 1}, pooling, 2);
+  }
+
+  TestConvolver<alignment> conv(unsignedFilter);
+  ASSERT_TRUE(conv.read(p));
+  ASSERT_FALSE(conv.convolve(core::Pooling::kMax, 0));
+}
+
+TEST(ConvolverTest, StoreRaw) {
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage.bmp";
+  createTestImage(13, 17).save(p.c_str());
+
+  constexpr uint32_t alignment = 4;
+  auto filter = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, 3, 2, std::vector<uint8_t>(54, 1));
+  TestConvolver<alignment> conv(filter);
+  ASSERT_TRUE(conv.read(p));
+  ASSERT_TRUE(conv.convolve());
+
+  io::Image reference(17, 13, 2);
+  ASSERT_TRUE(conv.store(reference, 0, 0));
+
+  // the output is narrowed directly into the mapped file
+  fs::path q = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageOutput.raw";
+  {
+    io::Image out{};
+    ASSERT_TRUE(out.createRaw(q, 17, 13, 2));
+    ASSERT_TRUE(conv.store(out, 0, 0));
+  }
+
+  io::Image out{};
+  ASSERT_TRUE(out.read(q));
+  ASSERT_EQ(*out.getImageBuffer(), *reference.getImageBuffer());
+}
+
+TEST(ConvolverTest, Pointwise) {
+  constexpr uint32_t alignment = 8;
+  constexpr uint32_t imgWidth = 19;
+  constexpr uint32_t imgHeight = 11;
+  constexpr uint32_t inputChannels = 3;
+  constexpr uint32_t outputChannels = 5;
+
+  io::Image image(imgWidth, imgHeight, inputChannels);
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<uint32_t> pixels(0, 255);
+  std::generate(image.getImageBuffer()->begin(), image.getImageBuffer()->end(), [&]() { return pixels(generator); });
+
+  // signed color matrix with one row of input channel weights per output channel
+  std::vector<int8_t> elements(inputChannels * outputChannels);
+  std::uniform_int_distribution<int32_t> weights(-128, 127);
+  std::generate(elements.begin(), elements.end(), [&]() { return weights(generator); });
+  auto filter = std::make_shared<core::DynamicFilter<int8_t, alignment>>(1, 1, inputChannels, outputChannels, elements);
+
+  auto verify = [&](TestConvolver<alignment, int8_t> &conv, const core::Region &r, const uint32_t stride) {
+    auto output = conv.getTransformBuffer();
+    ASSERT_EQ(output->size(), r.width * r.height * alignment);
+    for (uint32_t y = 0; y < r.height; ++y) {
+      for (uint32_t x = 0; x < r.width; ++x) {
+        for (uint32_t oc = 0; oc < outputChannels; ++oc) {
+          int32_t expected = 0;
+          for (uint32_t ic = 0; ic < inputChannels; ++ic) {
+            expected += (*image.getImageBuffer())[image.calcImageBufferOffset((r.x + x) * stride, (r.y + y) * stride, ic)] * elements[oc * inputChannels + ic];
+          }
+          ASSERT_EQ((*output)[(y * r.width + x) * alignment + oc], expected);
+        }
+      }
+    }
+  };
+
+  TestConvolver<alignment, int8_t> conv(filter);
+  conv.setImage(image);
+  ASSERT_TRUE(conv.convolve());
+  verify(conv, core::Region{0, 0, imgWidth, imgHeight}, 1);
+
+  const core::Region region{3, 2, 9, 6};
+  ASSERT_TRUE(conv.convolve(region));
+  verify(conv, region, 1);
+
+  TestConvolver<alignment, int8_t> strided(filter, core::ConvolutionParams{2, 2, 1, 1});
+  strided.setImage(image);
+  ASSERT_TRUE(strided.convolve());
+  verify(strided, core::Region{0, 0, (imgWidth + 1) / 2, (imgHeight + 1) / 2}, 2);
+
+  // the image channels must match the input channels of the filter
+  TestConvolver<alignment, int8_t> mismatch(filter);
+  mismatch.setImage(io::Image(imgWidth, imgHeight, 4));
+  ASSERT_FALSE(mismatch.convolve());
+
+  // int8_t weights can't overflow the 32Bit accumulator, the largest uint8_t weights can overflow the 16Bit accumulator
+  ASSERT_TRUE((core::pointwiseFits<int32_t, uint8_t>(filter->getColumnBuffer(), inputChannels, alignment)));
+  auto large = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(1, 1, inputChannels, 1, std::vector<uint8_t>(inputChannels, 255));
+  ASSERT_FALSE((core::pointwiseFits<uint16_t, uint8_t>(large->getColumnBuffer(), inputChannels, alignment)));
+
+  // such filters detect the overflow of each multiply-accumulate, dim images don't overflow
+  io::Image dim(imgWidth, imgHeight, inputChannels);
+  std::fill(dim.getImageBuffer()->begin(), dim.getImageBuffer()->end(), 80);
+  TestConvolver<alignment> checked(large);
+  checked.setImage(dim);
+  ASSERT_TRUE(checked.convolve());
+  ASSERT_EQ((*checked.getTransformBuffer())[0], 3 * 80 * 255);
+
+  io::Image bright(imgWidth, imgHeight, inputChannels);
+  std::fill(bright.getImageBuffer()->begin(), bright.getImageBuffer()->end(), 255);
+  checked.setImage(bright);
+  ASSERT_ANY_THROW(checked.convolve());
+}
+
+TEST(ConvolverTest, InterleavedLayout) {
+  constexpr uint32_t alignment = 8;
+  constexpr uint32_t imgWidth = 23;
+  constexpr uint32_t imgHeight = 14;
+
+  std::mt19937 generator(11);
+  std::uniform_int_distribution<uint32_t> values(0, 255);
+
+  struct Case {
+    uint32_t height, width, channels, groups;
+    core::ConvolutionParams params;
+  };
+  // specialized and generic kernels, stride, dilation and grouped filters
+  const std::vector<Case> cases = {
+      {3, 3, 3, 1, {}}, {5, 5, 4, 1, {}}, {7, 7, 1, 1, {}}, {1, 1, 3, 1, {}}, {1, 3, 2, 1, {}},
+      {3, 3, 3, 1, {2, 2, 1, 1}}, {3, 3, 4, 1, {1, 1, 2, 2}}, {3, 3, 2, 2, {}},
+  };
+
+  for (const Case &c : cases) {
+    const uint32_t imgChannels = c.channels * c.groups;
+    io::Image planar(imgWidth, imgHeight, imgChannels);
+    std::generate(planar.getImageBuffer()->begin(), planar.getImageBuffer()->end(), [&]() { return values(generator); });
+    io::Image interleaved = planar;
+    interleaved.convert(io::Layout::kInterleaved);
+    ASSERT_EQ(interleaved.layout(), io::Layout::kInterleaved);
+
+    std::vector<uint8_t> elements(c.height * c.width * c.channels * 4);
+    std::generate(elements.begin(), elements.end(), [&]() { return values(generator) % 3; });
+    std::shared_ptr<core::IFilter<uint8_t>> filter;
+    if (c.groups == 1) {
+      filter = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(c.height, c.width, c.channels, 4, elements);
+    } else {
+      filter = std::make_shared<core::GroupedFilter<uint8_t, alignment>>(c.height, c.width, c.groups, c.channels, 4 / c.groups, elements);
+    }
+
+    // both layouts produce the same output
+    TestConvolver<alignment, uint8_t, uint8_t> reference(filter, c.params);
+    reference.setImage(planar);
+    ASSERT_TRUE(reference.convolve());
+    TestConvolver<alignment, uint8_t, uint8_t> conv(filter, c.params);
+    conv.setImage(interleaved);
+    ASSERT_TRUE(conv.convolve());
+    ASSERT_EQ(*conv.getTransformBuffer(), *reference.getTransformBuffer());
+
+    const core::Region region{2, 3, 5, 4};
+    ASSERT_TRUE(reference.convolve(region));
+    ASSERT_TRUE(conv.convolve(region));
+    ASSERT_EQ(*conv.getTransformBuffer(), *reference.getTransformBuffer());
+
+    // the output is stored into interleaved images as well
+    io::Image out(region.width, region.height, 4, io::Layout::kInterleaved);
+    io::Image expected(region.width, region.height, 4);
+    ASSERT_TRUE(conv.store(out, 0, 0));
+    ASSERT_TRUE(reference.store(expected, 0, 0));
+    out.convert(io::Layout::kPlanar);
+    ASSERT_EQ(*out.getImageBuffer(), *expected.getImageBuffer());
+  }
+}
+
+/// convolve with a mostly zero filter using the sparse engine and the dense multiplication
+template <typename WeightT, typename DataT>
+void verifySparseConvolution(const uint32_t kHeight, const uint32_t kWidth, const uint32_t channels, const uint32_t groups, const io::Layout layout, core::ConvolutionParams params) {
+  constexpr uint32_t alignment = 4;
+  constexpr uint32_t numOutputChannels = 4;
+  std::mt19937 generator(kHeight * kWidth + channels);
+  std::uniform_int_distribution<uint32_t> values(0, 255);
+
+  io::BasicImage<DataT> image(19, 14, channels * groups);
+  std::generate(image.getImageBuffer()->begin(), image.getImageBuffer()->end(), [&]() { return static_cast<DataT>(values(generator)); });
+  image.convert(layout);
+
+  // about one weight in six is non-zero, signed weights are negative as well
+  std::vector<WeightT> elements(kHeight * kWidth * channels * numOutputChannels);
+  std::generate(elements.begin(), elements.end(), [&]() {
+    const uint32_t v = values(generator);
+    return static_cast<WeightT>(v % 6 == 0 ? (std::is_signed_v<WeightT> ? static_cast<int32_t>(v % 5) - 2 : 1 + v % 5) : 0);
+  });
+  std::shared_ptr<core::IFilter<WeightT>> filter;
+  if (groups == 1) {
+    filter = std::make_shared<core::DynamicFilter<WeightT, alignment>>(kHeight, kWidth, channels, numOutputChannels, elements);
+  } else {
+    filter = std::make_shared<core::GroupedFilter<WeightT, alignment>>(kHeight, kWidth, groups, channels, numOutputChannels / groups, elements);
+  }
+
+  TestConvolver<alignment, WeightT, DataT> sparse(filter, params);
+  sparse.setImage(image);
+  ASSERT_TRUE(sparse.convolve());
+  ASSERT_TRUE(sparse.isSparse());
+
+  params.sparseDensity = 0;
+  TestConvolver<alignment, WeightT, DataT> dense(filter, params);
+  dense.setImage(image);
+  ASSERT_TRUE(dense.convolve());
+  ASSERT_FALSE(dense.isSparse());
+  ASSERT_EQ(*sparse.getTransformBuffer(), *dense.getTransformBuffer());
+}
+
+TEST(ConvolverTest, SparseFilter) {
+  verifySparseConvolution<uint8_t, uint8_t>(3, 3, 3, 1, io::Layout::kPlanar, {});
+  verifySparseConvolution<uint8_t, uint8_t>(5, 5, 3, 1, io::Layout::kInterleaved, {});
+  verifySparseConvolution<uint8_t, uint8_t>(3, 5, 2, 2, io::Layout::kPlanar, {2, 2, 1, 1});
+  verifySparseConvolution<int8_t, uint8_t>(7, 7, 3, 1, io::Layout::kPlanar, {1, 1, 2, 2});
+  verifySparseConvolution<float, float>(5, 5, 3, 1, io::Layout::kPlanar, {});
+  verifySparseConvolution<float, float>(3, 3, 3, 1, io::Layout::kInterleaved, {});
+
+  // dense filters use the dense multiplication
+  io::BasicImage<uint8_t> image(9, 7, 3);
+  std::fill(image.getImageBuffer()->begin(), image.getImageBuffer()->end(), 1);
+  std::vector<uint8_t> elements(108);
+  std::iota(elements.begin(), elements.end(), 1);
+  TestConvolver<4> dense(std::make_shared<core::DynamicFilter<uint8_t, 4>>(3, 3, 3, 4, elements));
+  dense.setImage(image);
+  ASSERT_TRUE(dense.convolve());
+  ASSERT_FALSE(dense.isSparse());
+
+  // the density is measured against the aligned filter, whose padding the dense multiplication applies as well
+  TestConvolver<8> padded(std::make_shared<core::DynamicFilter<uint8_t, 8>>(3, 3, 3, 1, std::vector<uint8_t>(elements.begin(), elements.begin() + 27)));
+  padded.setImage(image);
+  ASSERT_TRUE(padded.convolve());
+  ASSERT_TRUE(padded.isSparse());
+  TestConvolver<8> reference(std::make_shared<core::DynamicFilter<uint8_t, 8>>(3, 3, 3, 1, std::vector<uint8_t>(elements.begin(), elements.begin() + 27)), {1, 1, 1, 1, 0});
+  reference.setImage(image);
+  ASSERT_TRUE(reference.convolve());
+  ASSERT_FALSE(reference.isSparse());
+  ASSERT_EQ(*padded.getTransformBuffer(), *reference.getTransformBuffer());
+}
+
+/// convolve with a box filter using the window sums and the multiplication of all taps
+template <typename WeightT, typename DataT>
+void verifyBoxConvolution(const uint32_t kHeight, const uint32_t kWidth, const uint32_t channels, const uint32_t groups, const io::Layout layout, core::ConvolutionParams params,
+                          const std::optional<core::Region> region = std::nullopt) {
+  constexpr uint32_t alignment = 4;
+  constexpr uint32_t numOutputChannels = 4;
+  std::mt19937 generator(kHeight * kWidth + channels);
+  // 16Bit accumulators of 8Bit data overflow for large filters of bright images
+  std::uniform_int_distribution<uint32_t> values(0, sizeof(DataT) == 1 ? 15 : std::numeric_limits<DataT>::max());
+
+  io::BasicImage<DataT> image(23, 17, channels * groups);
+  std::generate(image.getImageBuffer()->begin(), image.getImageBuffer()->end(), [&]() { return static_cast<DataT>(values(generator)); });
+  image.convert(layout);
+
+  // a single weight per pair of channels, signed weights are negative as well
+  std::vector<WeightT> elements;
+  for (uint32_t oc = 0; oc < numOutputChannels / groups * groups; ++oc) {
+    for (uint32_t ic = 0; ic < channels; ++ic) {
+      const WeightT weight = static_cast<WeightT>(std::is_signed_v<WeightT> ? static_cast<int32_t>(oc + ic) - 3 : oc + ic);
+      elements.insert(elements.end(), kHeight * kWidth, weight);
+    }
+  }
+  std::shared_ptr<core::IFilter<WeightT>> filter;
+  if (groups == 1) {
+    filter = std::make_shared<core::DynamicFilter<WeightT, alignment>>(kHeight, kWidth, channels, numOutputChannels, elements);
+  } else {
+    filter = std::make_shared<core::GroupedFilter<WeightT, alignment>>(kHeight, kWidth, groups, channels, numOutputChannels / groups, elements);
+  }
+
+  auto convolve = [&](TestConvolver<alignment, WeightT, DataT> &conv) { return region ? conv.convolve(*region) : conv.convolve(); };
+  TestConvolver<alignment, WeightT, DataT> box(filter, params);
+  box.setImage(image);
+  ASSERT_TRUE(convolve(box));
+  ASSERT_TRUE(box.isBox());
+
+  params.boxFilters = false;
+  params.sparseDensity = 0;
+  TestConvolver<alignment, WeightT, DataT> dense(filter, params);
+  dense.setImage(image);
+  ASSERT_TRUE(convolve(dense));
+  ASSERT_FALSE(dense.isBox());
+  ASSERT_EQ(*box.getTransformBuffer(), *dense.getTransformBuffer());
+}
+
+TEST(ConvolverTest, BoxFilter) {
+  verifyBoxConvolution<uint8_t, uint8_t>(3, 3, 3, 1, io::Layout::kPlanar, {});
+  verifyBoxConvolution<uint8_t, uint8_t>(9, 9, 3, 1, io::Layout::kPlanar, {});
+  verifyBoxConvolution<uint8_t, uint8_t>(15, 15, 1, 1, io::Layout::kPlanar, {});
+  verifyBoxConvolution<uint8_t, uint8_t>(3, 3, 3, 1, io::Layout::kPlanar, {4, 4, 1, 1});
+  verifyBoxConvolution<uint8_t, uint8_t>(5, 7, 3, 1, io::Layout::kInterleaved, {});
+  verifyBoxConvolution<uint8_t, uint8_t>(7, 3, 2, 2, io::Layout::kPlanar, {});
+  verifyBoxConvolution<int8_t, uint8_t>(5, 5, 3, 1, io::Layout::kPlanar, {2, 3, 1, 1});
+  verifyBoxConvolution<int8_t, uint8_t>(5, 5, 3, 1, io::Layout::kPlanar, {1, 1, 2, 3});
+  verifyBoxConvolution<uint8_t, uint16_t>(11, 11, 3, 1, io::Layout::kInterleaved, {3, 3, 2, 2});
+  verifyBoxConvolution<uint8_t, uint8_t>(9, 9, 3, 1, io::Layout::kPlanar, {}, core::Region{4, 3, 11, 9});
+  verifyBoxConvolution<uint8_t, uint8_t>(9, 9, 3, 1, io::Layout::kPlanar, {2, 2, 3, 3}, core::Region{1, 2, 8, 5});
+
+  // the window sums of float images aren't bit-identical to the multiplication, which is used instead
+  core::ConvolutionParams params;
+  TestConvolver<4, float, float> conv(std::make_shared<core::DynamicFilter<float, 4>>(3, 3, 1, 1, std::vector<float>(9, 1.0f / 9)), params);
+  io::BasicImage<float> image(9, 7, 1);
+  conv.setImage(image);
+  ASSERT_TRUE(conv.convolve());
+  ASSERT_FALSE(conv.isBox());
+}
+
+/// a filter forwarding to another filter, which can be replaced between convolutions
+class SwitchFilter : public core::IFilter<uint8_t> {
+ public:
+  explicit SwitchFilter(std::shared_ptr<core::IFilter<uint8_t>> f) : active(std::move(f)) {}
+  void set(std::shared_ptr<core::IFilter<uint8_t>> f) { active = std::move(f); }
+
+  uint32_t height() const override { return active->height(); }
+  uint32_t width() const override { return active->width(); }
+  uint32_t numInputChannels() const override { return active->numInputChannels(); }
+  uint32_t numOutputChannels() const override { return active->numOutputChannels(); }
+  uint32_t numGroups() const override { return active->numGroups(); }
+  uint32_t leftPadding() const override { return active->leftPadding(); }
+  uint32_t rightPadding() const override { return active->rightPadding(); }
+  uint32_t topPadding() const override { return active->topPadding(); }
+  uint32_t bottomPadding() const override { return active->bottomPadding(); }
+  uint8_t *getFilterBuffer() override { return active->getFilterBuffer(); }
+  const uint8_t *getFilterBuffer() const override { return active->getFilterBuffer(); }
+  uint8_t *getColumnBuffer() override { return active->getColumnBuffer(); }
+  const uint8_t *getColumnBuffer() const override { return active->getColumnBuffer(); }
+
+ private:
+  std::shared_ptr<core::IFilter<uint8_t>> active;
+};
+
+TEST(ConvolverTest, EngineFlags) {
+  constexpr uint32_t alignment = 4;
+  io::BasicImage<uint8_t> image(9, 7, 1);
+  std::fill(image.getImageBuffer()->begin(), image.getImageBuffer()->end(), 1);
+
+  std::vector<uint8_t> sparseElements(25, 0);
+  sparseElements[12] = 1;
+  auto box = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, 1, 1, std::vector<uint8_t>(9, 1));
+  auto sparse = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(5, 5, 1, 1, sparseElements);
+  auto pointwise = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(1, 1, 1, 1, std::vector<uint8_t>{2});
+
+  // a pointwise convolution following a box or sparse convolution reports neither engine
+  auto filter = std::make_shared<SwitchFilter>(box);
+  TestConvolver<alignment> conv(filter);
+  conv.setImage(image);
+  ASSERT_TRUE(conv.convolve());
+  ASSERT_TRUE(conv.isBox());
+
+  filter->set(pointwise);
+  conv.setImage(image);
+  ASSERT_TRUE(conv.convolve());
+  ASSERT_FALSE(conv.isBox());
+  ASSERT_FALSE(conv.isSparse());
+  ASSERT_EQ((*conv.getTransformBuffer())[0], 2);
+
+  filter->set(sparse);
+  conv.setImage(image);
+  ASSERT_TRUE(conv.convolve());
+  ASSERT_TRUE(conv.isSparse());
+
+  filter->set(pointwise);
+  conv.setImage(image);
+  ASSERT_TRUE(conv.convolve());
+  ASSERT_FALSE(conv.isBox());
+  ASSERT_FALSE(conv.isSparse());
+}
+
+TEST(ConvolverTest, WriteOutput) {
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage.bmp";
+  createTestImage(13, 17).save(p.c_str());
+
+  constexpr uint32_t alignment = 4;
+  std::vector<uint8_t> elements(3 * 3 * 3 * 5);
+  for (size_t i = 0; i < elements.size(); ++i) {
+    elements[i] = i % 3;
+  }
+  auto filter = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, 3, 5, elements);
+  TestConvolver<alignment> conv(filter);
+  ASSERT_TRUE(conv.read(p));
+  ASSERT_TRUE(conv.convolve());
+
+  io::Image reference(17, 13, 5);
+  ASSERT_TRUE(conv.store(reference, 0, 0));
+
+  // 5 output channels are packed into an RGBA and a gray file, encoded in parallel
+  fs::path prefix = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageOutput";
+  core::OutputParams params;
+  params.channelsPerFile = 4;
+  params.threads = 2;
+  params.png.compressionLevel = 1;
+  params.png.filter = io::PngFilter::kNone;
+  ASSERT_TRUE(conv.write(prefix, params));
+
+  io::Image rgba{};
+  ASSERT_TRUE(rgba.read(prefix.string() + "_0.png"));
+  ASSERT_EQ(rgba.channels(), 4);
+  io::Image gray{};
+  ASSERT_TRUE(gray.read(prefix.string() + "_1.png"));
+  ASSERT_EQ(gray.channels(), 1);
+
+  const uint64_t planeSize = reference.pixels();
+  auto expected = reference.getImageBuffer();
+  ASSERT_TRUE(std::equal(rgba.getImageBuffer()->begin(), rgba.getImageBuffer()->end(), expected->begin()));
+  ASSERT_TRUE(std::equal(gray.getImageBuffer()->begin(), gray.getImageBuffer()->end(), expected->begin() + 4 * planeSize));
+
+  // one file per output channel by default
+  ASSERT_TRUE(conv.write(prefix));
+  for (uint32_t oc = 0; oc < 5; ++oc) {
+    io::Image channel{};
+    ASSERT_TRUE(channel.read(prefix.string() + "_" + std::to_string(oc) + ".png"));
+    ASSERT_EQ(channel.channels(), 1);
+    ASSERT_TRUE(std::equal(channel.getImageBuffer()->begin(), channel.getImageBuffer()->end(), expected->begin() + oc * planeSize));
+  }
+
+  params.channelsPerFile = 5;
+  ASSERT_FALSE(conv.write(prefix, params));
+}
+
+/// compare the statistics collected by the last convolution with the ones of its transform buffer
+template <typename ConvolverT>
+void verifyStats(const ConvolverT &conv, const uint32_t numOutputChannels, const uint32_t numPixels, const bool withHistogram) {
+  using TransformDataT = typename ConvolverT::TransformDataT;
+  const uint32_t N = static_cast<uint32_t>(conv.getTransformBuffer()->size() / numPixels);
+  const auto &stats = conv.getStats();
+  ASSERT_EQ(stats.size(), numOutputChannels);
+
+  for (uint32_t oc = 0; oc < numOutputChannels; ++oc) {
+    TransformDataT min = std::numeric_limits<TransformDataT>::max();
+    TransformDataT max = std::numeric_limits<TransformDataT>::lowest();
+    int64_t sum = 0;
+    std::vector<uint64_t> histogram(256);
+    for (uint32_t p = 0; p < numPixels; ++p) {
+      const TransformDataT value = (*conv.getTransformBuffer())[static_cast<size_t>(p) * N + oc];
+      min = std::min(min, value);
+      max = std::max(max, value);
+      sum += value;
+      const double bin = (value - stats[oc].lower) * 256 / (stats[oc].upper - stats[oc].lower);
+      ++histogram[static_cast<uint32_t>(std::clamp(bin, 0.0, 255.0))];
+    }
+    ASSERT_EQ(stats[oc].min, min);
+    ASSERT_EQ(stats[oc].max, max);
+    ASSERT_EQ(stats[oc].sum, sum);
+    ASSERT_EQ(stats[oc].count, numPixels);
+    ASSERT_EQ(stats[oc].histogram.empty(), !withHistogram);
+    if (withHistogram) {
+      ASSERT_LE(stats[oc].lower, min);
+      ASSERT_GE(stats[oc].upper, max);
+      ASSERT_EQ(stats[oc].histogram, histogram);
+    }
+  }
+}
+
+TEST(ConvolverTest, OutputStatistics) {
+  constexpr uint32_t alignment = 4;
+  constexpr uint32_t width = 21;
+  constexpr uint32_t height = 15;
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<uint32_t> values(0, 255);
+
+  io::Image image(width, height, 3);
+  std::generate(image.getImageBuffer()->begin(), image.getImageBuffer()->end(), [&]() { return static_cast<uint8_t>(values(generator)); });
+
+  std::vector<int8_t> elements(3 * 3 * 3 * 3);
+  std::generate(elements.begin(), elements.end(), [&]() { return static_cast<int8_t>(static_cast<int32_t>(values(generator) % 9) - 4); });
+  auto filter = std::make_shared<core::DynamicFilter<int8_t, alignment>>(3, 3, 3, 3, elements);
+
+  core::ConvolutionParams params;
+  params.statistics = core::Statistics::kHistogram;
+  TestConvolver<alignment, int8_t, uint8_t> conv(filter, params);
+  conv.setImage(image);
+  ASSERT_TRUE(conv.convolve());
+  verifyStats(conv, 3, width * height, true);
+
+  // the statistics cover the region, the pooled output and the outputs of the pointwise and box filters as well
+  ASSERT_TRUE(conv.convolve(core::Region{3, 2, 9, 7}));
+  verifyStats(conv, 3, 9 * 7, true);
+  ASSERT_TRUE(conv.convolve(core::Pooling::kMax, 2));
+  verifyStats(conv, 3, 11 * 8, true);
+
+  params.statistics = core::Statistics::kRange;
+  TestConvolver<alignment> pointwise(std::make_shared<core::DynamicFilter<uint8_t, alignment>>(1, 1, 3, 2, std::vector<uint8_t>{1, 2, 3, 4, 5, 6}), params);
+  pointwise.setImage(image);
+  ASSERT_TRUE(pointwise.convolve());
+  verifyStats(pointwise, 2, width * height, false);
+
+  TestConvolver<alignment> box(std::make_shared<core::DynamicFilter<uint8_t, alignment>>(5, 5, 3, 1, std::vector<uint8_t>(75, 1)), params);
+  box.setImage(image);
+  ASSERT_TRUE(box.convolve());
+  ASSERT_TRUE(box.isBox());
+  verifyStats(box, 1, width * height, false);
+
+  // normalized output maps the minimum and maximum of each output channel to 0 and 255
+  io::Image normalized(width, height, 3);
+  ASSERT_TRUE(conv.convolve());
+  ASSERT_TRUE(conv.store(normalized, 0, 0, true));
+  const auto &stats = conv.getStats();
+  for (uint32_t oc = 0; oc < 3; ++oc) {
+    const auto first = normalized.getImageBuffer()->begin() + oc * normalized.pixels();
+    ASSERT_EQ(*std::min_element(first, first + normalized.pixels()), 0);
+    ASSERT_EQ(*std::max_element(first, first + normalized.pixels()), 255);
+    for (uint32_t p = 0; p < width * height; ++p) {
+      const double value = (*conv.getTransformBuffer())[static_cast<size_t>(p) * alignment + oc];
+      ASSERT_EQ(first[p], std::lround((value - stats[oc].min) * 255 / (stats[oc].max - stats[oc].min)));
+    }
+  }
+
+  fs::path prefix = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageNormalized";
+  core::OutputParams outputParams;
+  outputParams.channelsPerFile = 3;
+  outputParams.normalize = true;
+  ASSERT_TRUE(conv.write(prefix, outputParams));
+  io::Image written{};
+  ASSERT_TRUE(written.read(prefix.string() + "_0.png"));
+  ASSERT_TRUE(std::equal(written.getImageBuffer()->begin(), written.getImageBuffer()->end(), normalized.getImageBuffer()->begin()));
+
+  // normalization requires the statistics
+  TestConvolver<alignment, int8_t, uint8_t> plain(filter);
+  plain.setImage(image);
+  ASSERT_TRUE(plain.convolve());
+  ASSERT_TRUE(plain.getStats().empty());
+  ASSERT_FALSE(plain.store(normalized, 0, 0, true));
+  ASSERT_FALSE(plain.write(prefix, outputParams));
+}
+
 TEST(Convolution, ColorFilter) {
   constexpr uint32_t P = 8;
   constexpr uint32_t kHeight = 1;
@@ -0,0 +1,109 @@
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace convolution;
+
+namespace {
+
+template <class T>
+class DynamicFilterTestFixture : public testing::Test {
+};
+
+}  // namespace
+
+typedef ::testing::Types<uint8_t> Implementations;
+TYPED_TEST_SUITE(DynamicFilterTestFixture, Implementations);
+
+TYPED_TEST(DynamicFilterTestFixture, Instantiate) {
+  constexpr uint32_t kHeight = 3;
+  constexpr uint32_t kWidth = 5;
+  constexpr uint32_t alignment = 2;
+
+  auto elements = core::test::getRandomVector<TypeParam>(kHeight * kWidth);
+  using TestFilter = core::DynamicFilter<TypeParam, alignment>;
+  ASSERT_NO_THROW(TestFilter f(kHeight, kWidth, 1, 1, elements));
+  ASSERT_THROW(TestFilter f(kHeight, kWidth, 2, 1, elements), std::out_of_range);
+  ASSERT_THROW(TestFilter f(kHeight, 4, 1, 1), std::invalid_argument);
+  ASSERT_THROW(TestFilter f(kHeight, kWidth, 0, 1), std::invalid_argument);
+}
+
+TYPED_TEST(DynamicFilterTestFixture, ColumnBufferMatchesFilter) {
+  constexpr uint32_t kHeight = 3;
+  constexpr uint32_t kWidth = 5;
+  constexpr uint32_t kInputChannels = 3;
+  constexpr uint32_t kOutputChannels = 3;
+  constexpr uint32_t alignment = 4;
+
+  using StaticFilter = core::Filter<TypeParam, kHeight, kWidth, kInputChannels, kOutputChannels, alignment>;
+  using TestFilter = core::DynamicFilter<TypeParam, alignment>;
+
+  auto elements = core::test::getRandomVector<TypeParam>(StaticFilter::kNumElements);
+  StaticFilter reference(elements);
+  TestFilter filter(kHeight, kWidth, kInputChannels, kOutputChannels, elements);
+
+  ASSERT_EQ(filter.numElementsAligned(), StaticFilter::kNumElementsAligned);
+  ASSERT_EQ(filter.leftPadding(), reference.leftPadding());
+  ASSERT_EQ(filter.topPadding(), reference.topPadding());
+  ASSERT_EQ(memcmp(filter.getFilterBuffer(), reference.getFilterBuffer(), StaticFilter::kNumElements * sizeof(TypeParam)), 0);
+  ASSERT_EQ(memcmp(filter.getColumnBuffer(), reference.getColumnBuffer(), StaticFilter::kNumElementsAligned * sizeof(TypeParam)), 0);
+}
+
+TYPED_TEST(DynamicFilterTestFixture, Set) {
+  constexpr uint32_t kHeight = 3;
+  constexpr uint32_t kWidth = 3;
+  constexpr uint32_t kInputChannels = 3;
+  constexpr uint32_t kOutputChannels = 2;
+  constexpr uint32_t alignment = 2;
+
+  core::DynamicFilter<TypeParam, alignment> filter(kHeight, kWidth, kInputChannels, kOutputChannels);
+
+  uint32_t cnt = 0;
+  for (uint32_t oc = 0; oc < kOutputChannels; ++oc) {
+    for (uint32_t ic = 0; ic < kInputChannels; ++ic) {
+      for (uint32_t fy = 0; fy < kHeight; ++fy) {
+        for (uint32_t fx = 0; fx < kWidth; ++fx) {
+          filter.set(fy, fx, ic, oc, cnt);
+          ASSERT_EQ(filter.at(fy, fx, ic, oc), cnt);
+          ASSERT_EQ(filter.getColumnBuffer()[filter.calcColumnBufferOffset(fx, fy, ic, oc)], cnt);
+          ++cnt;
+        }
+      }
+    }
+  }
+
+  ASSERT_THROW(filter.set(kHeight, 0, 0, 0, 1), std::out_of_range);
+}
+
+TYPED_TEST(DynamicFilterTestFixture, ChannelWeights) {
+  constexpr uint32_t kHeight = 3;
+  constexpr uint32_t kWidth = 5;
+  constexpr uint32_t kInputChannels = 2;
+  constexpr uint32_t kOutputChannels = 3;
+  constexpr uint32_t alignment = 4;
+
+  core::DynamicFilter<TypeParam, alignment> filter(kHeight, kWidth, kInputChannels, kOutputChannels);
+  for (uint32_t oc = 0; oc < kOutputChannels; ++oc) {
+    for (uint32_t ic = 0; ic < kInputChannels; ++ic) {
+      for (uint32_t fy = 0; fy < kHeight; ++fy) {
+        for (uint32_t fx = 0; fx < kWidth; ++fx) {
+          filter.set(fy, fx, ic, oc, oc * kInputChannels + ic);
+        }
+      }
+    }
+  }
+
+  std::vector<TypeParam> weights;
+  ASSERT_TRUE(filter.template getChannelWeights<alignment>(weights));
+  ASSERT_EQ(weights.size(), kInputChannels * kOutputChannels);
+  for (uint32_t i = 0; i < weights.size(); ++i) {
+    ASSERT_EQ(weights[i], i);
+  }
+
+  filter.set(2, 4, 1, 2, 0);
+  ASSERT_FALSE(filter.template getChannelWeights<alignment>(weights));
+}
@@ -0,0 +1,149 @@
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/Executor.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <convolution/io/Image.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace convolution;
+
+namespace {
+
+constexpr uint32_t alignment = 4;
+using FilterPtr = std::shared_ptr<core::IFilter<uint8_t>>;
+using ExecutorT = core::Executor<alignment>;
+
+}  // namespace
+
+TEST(ExecutorTest, Futures) {
+  spdlog::set_level(spdlog::level::warn);
+  const std::vector<FilterPtr> filters = {core::test::createFilter<alignment>(3, 3, 2, 41), core::test::createFilter<alignment>(5, 3, 4, 69)};
+  core::ConvolutionParams strided;
+  strided.strideX = 2;
+  strided.strideY = 2;
+
+  ExecutorT executor(3, 4);
+  ASSERT_EQ(executor.numThreads(), 3u);
+
+  std::vector<io::Image> images;
+  std::vector<ExecutorT::Job> jobs;
+  std::atomic<uint32_t> callbacks = 0;
+  for (uint32_t i = 0; i < 12; ++i) {
+    images.push_back(core::test::createImage(20 + i, 15 + i, 3, i));
+    jobs.push_back(executor.submit(images.back(), filters[i % 2], i % 3 ? core::ConvolutionParams() : strided, [&callbacks](const ExecutorT::Result &result) {
+      if (result.status == core::JobStatus::kCompleted) {
+        ++callbacks;
+      }
+    }));
+  }
+
+  for (uint32_t i = 0; i < jobs.size(); ++i) {
+    const ExecutorT::Result result = jobs[i].result.get();
+    ASSERT_EQ(result.status, core::JobStatus::kCompleted);
+    ASSERT_EQ(core::test::toVector(result.output), core::test::convolveImage<alignment>(images[i], filters[i % 2], i % 3 ? core::ConvolutionParams() : strided)) << "job " << i;
+  }
+  ASSERT_EQ(callbacks, 12u);
+
+  // images which don't match the filter fail
+  ExecutorT::Job job = executor.submit(core::test::createImage(8, 8, 1, 0), filters[0]);
+  ASSERT_EQ(job.result.get().status, core::JobStatus::kFailed);
+}
+
+TEST(ExecutorTest, BackpressureAndCancellation) {
+  spdlog::set_level(spdlog::level::warn);
+  FilterPtr filter = core::test::createFilter<alignment>(3, 3, 2, 41);
+  const io::Image image = core::test::createImage(16, 16, 3, 1);
+
+  // the callback of the first job blocks the single worker until the gate is opened
+  std::promise<void> entered;
+  std::promise<void> gate;
+  std::shared_future<void> opened = gate.get_future().share();
+  ExecutorT executor(1, 2);
+  ExecutorT::Job first = executor.submit(image, filter, core::ConvolutionParams(), [&](const ExecutorT::Result &) {
+    entered.set_value();
+    opened.wait();
+  });
+  entered.get_future().wait();
+
+  // the queue holds two jobs
+  ExecutorT::Job second = executor.submit(image, filter);
+  std::optional<ExecutorT::Job> third = executor.trySubmit(image, filter);
+  ASSERT_TRUE(third);
+  ASSERT_FALSE(executor.trySubmit(image, filter));
+  ASSERT_EQ(executor.numQueued(), 2u);
+
+  // cancelling a queued job frees its slot
+  bool cancelledCallback = false;
+  ASSERT_TRUE(executor.cancel(third->id));
+  ASSERT_EQ(third->result.get().status, core::JobStatus::kCancelled);
+  std::optional<ExecutorT::Job> fourth = executor.trySubmit(image, filter, core::ConvolutionParams(), [&](const ExecutorT::Result &result) { cancelledCallback = result.status == core::JobStatus::kCancelled; });
+  ASSERT_TRUE(fourth);
+  ASSERT_TRUE(executor.cancel(fourth->id));
+  ASSERT_TRUE(cancelledCallback);
+  ASSERT_FALSE(executor.cancel(fourth->id));
+
+  // running jobs can't be cancelled
+  ASSERT_FALSE(executor.cancel(first.id));
+  gate.set_value();
+  ASSERT_EQ(first.result.get().status, core::JobStatus::kCompleted);
+  const ExecutorT::Result result = second.result.get();
+  ASSERT_EQ(result.status, core::JobStatus::kCompleted);
+  ASSERT_EQ(core::test::toVector(result.output), core::test::convolveImage<alignment>(image, filter));
+}
+
+TEST(ExecutorTest, Destruction) {
+  spdlog::set_level(spdlog::level::warn);
+  FilterPtr filter = core::test::createFilter<alignment>(3, 3, 2, 41);
+  const io::Image image = core::test::createImage(16, 16, 3, 2);
+
+  std::promise<void> entered;
+  std::promise<void> gate;
+  std::shared_future<void> opened = gate.get_future().share();
+  std::future<ExecutorT::Result> running;
+  std::future<ExecutorT::Result> queued;
+  {
+    ExecutorT executor(1, 4);
+    running = executor.submit(image, filter, core::ConvolutionParams(), [&](const ExecutorT::Result &) {
+      entered.set_value();
+      opened.wait();
+    }).result;
+    entered.get_future().wait();
+    queued = executor.submit(image, filter).result;
+    gate.set_value();
+  }
+
+  // the running job completes, the queued job may have been picked up before the destruction
+  ASSERT_EQ(running.get().status, core::JobStatus::kCompleted);
+  const core::JobStatus status = queued.get().status;
+  ASSERT_TRUE(status == core::JobStatus::kCompleted || status == core::JobStatus::kCancelled);
+}
+
+TEST(ExecutorTest, Exceptions) {
+  spdlog::set_level(spdlog::level::off);
+  FilterPtr filter = core::test::createFilter<alignment>(3, 3, 2, 41);
+  const io::Image image = core::test::createImage(16, 16, 3, 3);
+
+  // the 16Bit accumulators overflow for the largest weights on a bright image
+  FilterPtr overflowing = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, 3, 1, std::vector<uint8_t>(27, 255));
+  io::Image bright(16, 16, 3);
+  std::fill(bright.getImageBuffer()->begin(), bright.getImageBuffer()->end(), 255);
+
+  ExecutorT executor(1, 4);
+  ExecutorT::Job failed = executor.submit(bright, overflowing);
+  ExecutorT::Job throwing = executor.submit(image, filter, core::ConvolutionParams(), [](const ExecutorT::Result &) { throw std::runtime_error("callback"); });
+  ExecutorT::Job completed = executor.submit(image, filter);
+
+  // neither the convolution nor the callback terminate the worker
+  ASSERT_EQ(failed.result.get().status, core::JobStatus::kFailed);
+  ASSERT_EQ(throwing.result.get().status, core::JobStatus::kCompleted);
+  const ExecutorT::Result result = completed.result.get();
+  ASSERT_EQ(result.status, core::JobStatus::kCompleted);
+  ASSERT_EQ(core::test::toVector(result.output), core::test::convolveImage<alignment>(image, filter));
+}
@@ -0,0 +1,89 @@
+#include <convolution/core/ConstFilter.h>
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/FilterBank.h>
+#include <convolution/core/GroupedFilter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace convolution;
+
+TEST(FilterBankTest, Instantiate) {
+  constexpr uint32_t alignment = 4;
+  using Bank = core::FilterBank<uint8_t, alignment>;
+  auto a = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, 3, 2);
+  auto b = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, 3, 1);
+  auto c = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(5, 5, 3, 1);
+  auto d = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, 1, 1);
+  auto grouped = core::GroupedFilter<uint8_t, alignment>::depthwise(3, 3, 3, std::vector<uint8_t>(27));
+
+  ASSERT_NO_THROW(Bank bank({a, b}));
+  ASSERT_THROW(Bank bank({}), std::invalid_argument);
+  ASSERT_THROW(Bank bank({a, c}), std::invalid_argument);
+  ASSERT_THROW(Bank bank({a, d}), std::invalid_argument);
+  ASSERT_THROW(Bank bank({a, grouped}), std::invalid_argument);
+
+  Bank bank({a, b, a});
+  ASSERT_EQ(bank.numFilters(), 3u);
+  ASSERT_EQ(bank.numOutputChannels(), 5u);
+  ASSERT_EQ(bank.outputChannelOffset(0), 0u);
+  ASSERT_EQ(bank.outputChannelOffset(1), 2u);
+  ASSERT_EQ(bank.outputChannelOffset(2), 3u);
+  ASSERT_EQ(bank.numOutputChannels(1), 1u);
+  ASSERT_EQ(bank.numOutputChannels(2), 2u);
+}
+
+TEST(FilterBankTest, ColumnBuffer) {
+  constexpr uint32_t kHeight = 3;
+  constexpr uint32_t kWidth = 3;
+  constexpr uint32_t kInputChannels = 3;
+  constexpr uint32_t alignment = 4;
+
+  auto a = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(kHeight, kWidth, kInputChannels, 2, core::test::getRandomVector<uint8_t>(kHeight * kWidth * kInputChannels * 2));
+  auto b = std::make_shared<core::Filter<uint8_t, kHeight, kWidth, kInputChannels, 3, alignment>>(core::test::getRandomVector<uint8_t>(kHeight * kWidth * kInputChannels * 3));
+  core::FilterBank<uint8_t, alignment> bank({a, b});
+
+  // the output channels of the filters are concatenated in the order provided
+  for (uint32_t fy = 0; fy < kHeight; ++fy) {
+    for (uint32_t fx = 0; fx < kWidth; ++fx) {
+      for (uint32_t ic = 0; ic < kInputChannels; ++ic) {
+        for (uint32_t oc = 0; oc < 2; ++oc) {
+          ASSERT_EQ(bank.at(fy, fx, ic, oc), a->at(fy, fx, ic, oc));
+          ASSERT_EQ(bank.getColumnBuffer()[bank.calcColumnBufferOffset(fx, fy, ic, oc)], a->at(fy, fx, ic, oc));
+        }
+        for (uint32_t oc = 0; oc < 3; ++oc) {
+          ASSERT_EQ(bank.at(fy, fx, ic, 2 + oc), b->at(fy, fx, ic, oc));
+          ASSERT_EQ(bank.getColumnBuffer()[bank.calcColumnBufferOffset(fx, fy, ic, 2 + oc)], b->at(fy, fx, ic, oc));
+        }
+      }
+    }
+  }
+}
+
+TEST(FilterBankTest, Split) {
+  constexpr uint32_t alignment = 4;
+  constexpr uint32_t kPixels = 6;
+  auto a = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(1, 1, 1, 2);
+  auto b = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(1, 1, 1, 1);
+  core::FilterBank<uint8_t, alignment> bank({a, b});
+
+  // row-major output with 3 channels aligned to 4 per pixel
+  std::vector<uint16_t> output(kPixels * 4);
+  for (uint32_t idx = 0; idx < output.size(); ++idx) {
+    output[idx] = idx;
+  }
+
+  auto outputs = bank.split(output, kPixels);
+  ASSERT_EQ(outputs.size(), 2u);
+  ASSERT_EQ(outputs[0].size(), kPixels * 2);
+  ASSERT_EQ(outputs[1].size(), kPixels);
+  for (uint32_t pixel = 0; pixel < kPixels; ++pixel) {
+    ASSERT_EQ(outputs[0][pixel * 2 + 0], output[pixel * 4 + 0]);
+    ASSERT_EQ(outputs[0][pixel * 2 + 1], output[pixel * 4 + 1]);
+    ASSERT_EQ(outputs[1][pixel], output[pixel * 4 + 2]);
+  }
+
+  ASSERT_TRUE(bank.split(output, kPixels + 1).empty());
+}
@@ -0,0 +1,56 @@
+#include <convolution/core/GroupedFilter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <gtest/gtest.h>
+
+#include <limits>
+
+using namespace convolution;
+
+TEST(GroupedFilterTest, Instantiate) {
+  using TestFilter = core::GroupedFilter<uint8_t, 2>;
+  ASSERT_NO_THROW(TestFilter f(3, 3, 2, 2, 1, std::vector<uint8_t>(36)));
+  ASSERT_THROW(TestFilter f(3, 3, 2, 2, 1, std::vector<uint8_t>(35)), std::out_of_range);
+  ASSERT_THROW(TestFilter f(3, 2, 2, 2, 1, std::vector<uint8_t>(24)), std::invalid_argument);
+  ASSERT_THROW(TestFilter f(3, 3, 0, 2, 1, std::vector<uint8_t>()), std::invalid_argument);
+
+  auto depthwise = TestFilter::depthwise(5, 5, 3, std::vector<uint8_t>(75));
+  ASSERT_EQ(depthwise->numGroups(), 3u);
+  ASSERT_EQ(depthwise->numInputChannels(), 1u);
+  ASSERT_EQ(depthwise->numOutputChannels(), 3u);
+}
+
+TEST(GroupedFilterTest, ColumnBuffer) {
+  constexpr uint32_t kHeight = 3;
+  constexpr uint32_t kWidth = 5;
+  constexpr uint32_t kGroups = 3;
+  constexpr uint32_t kInputChannels = 2;
+  constexpr uint32_t kOutputChannels = 3;
+  constexpr uint32_t alignment = 4;
+
+  std::vector<uint8_t> data(kHeight * kWidth * kInputChannels * kOutputChannels * kGroups);
+  for (uint32_t idx = 0; idx < data.size(); ++idx) {
+    data[idx] = idx;
+  }
+
+  core::GroupedFilter<uint8_t, alignment> filter(kHeight, kWidth, kGroups, kInputChannels, kOutputChannels, data);
+
+  // each group is a separate KxN block in the column buffer
+  const uint32_t K = core::getAlignedSize<uint32_t, alignment>(kHeight * kWidth * kInputChannels);
+  const uint32_t N = core::getAlignedSize<uint32_t, alignment>(kOutputChannels);
+  ASSERT_EQ(filter.groupSizeAligned(), K * N);
+
+  uint32_t cnt = 0;
+  const uint8_t *columnData = filter.getColumnBuffer();
+  for (uint32_t oc = 0; oc < kOutputChannels * kGroups; ++oc) {
+    const uint8_t *block = columnData + (oc / kOutputChannels) * K * N;
+    for (uint32_t ic = 0; ic < kInputChannels; ++ic) {
+      for (uint32_t fy = 0; fy < kHeight; ++fy) {
+        for (uint32_t fx = 0; fx < kWidth; ++fx) {
+          const uint32_t k = ic * kHeight * kWidth + fy * kWidth + fx;
+          ASSERT_EQ(block[k * N + oc % kOutputChannels], static_cast<uint8_t>(cnt++));
+        }
+      }
+    }
+  }
+}
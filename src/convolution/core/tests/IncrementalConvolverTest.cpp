@@ -0,0 +1,126 @@
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/IncrementalConvolver.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <convolution/io/Image.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace convolution;
+
+namespace {
+
+constexpr uint32_t alignment = 4;
+using FilterPtr = std::shared_ptr<core::IFilter<uint8_t>>;
+
+/// change a single pixel of a copy of the frame
+io::Image changePixel(const io::Image &frame, const uint32_t x, const uint32_t y, const uint32_t c) {
+  io::Image changed(frame.width(), frame.height(), frame.channels(), frame.layout());
+  *changed.getImageBuffer() = *frame.getImageBuffer();
+  (*changed.getImageBuffer())[changed.calcImageBufferOffset(x, y, c)] += 1;
+  return changed;
+}
+
+/// compare the incremental output against the convolution of the whole frame
+void verifyOutput(const core::IncrementalConvolver<alignment> &incremental, const io::Image &frame, FilterPtr filter, const core::ConvolutionParams &params) {
+  ASSERT_EQ(core::test::toVector(incremental.getOutput()), core::test::convolveImage<alignment>(frame, filter, params));
+}
+
+}  // namespace
+
+TEST(IncrementalConvolverTest, ChangedTiles) {
+  FilterPtr filter = core::test::createFilter<alignment>(3, 3, 2, 95);
+  core::IncrementalConvolver<alignment> incremental(filter, 16, 8);
+
+  // the first frame is convolved as a whole
+  io::Image frame = core::test::createImage(64, 40, 3, 2560);
+  ASSERT_TRUE(incremental(frame));
+  ASSERT_EQ(incremental.numTiles(), 4 * 5);
+  ASSERT_EQ(incremental.numChangedTiles(), incremental.numTiles());
+  verifyOutput(incremental, frame, filter, {});
+
+  // an unchanged frame doesn't require any computation
+  ASSERT_TRUE(incremental(frame));
+  ASSERT_EQ(incremental.numChangedTiles(), 0);
+  verifyOutput(incremental, frame, filter, {});
+
+  // a pixel inside of a tile only affects its tile
+  frame = changePixel(frame, 20, 12, 1);
+  ASSERT_TRUE(incremental(frame));
+  ASSERT_EQ(incremental.numChangedTiles(), 1);
+  verifyOutput(incremental, frame, filter, {});
+
+  // the halo of a pixel at a tile corner reaches the 4 neighbouring tiles
+  frame = changePixel(frame, 32, 16, 2);
+  ASSERT_TRUE(incremental(frame));
+  ASSERT_EQ(incremental.numChangedTiles(), 4);
+  verifyOutput(incremental, frame, filter, {});
+
+  // a frame of a different size is convolved as a whole
+  frame = core::test::createImage(30, 20, 3, 600);
+  ASSERT_TRUE(incremental(frame));
+  ASSERT_EQ(incremental.numChangedTiles(), incremental.numTiles());
+  verifyOutput(incremental, frame, filter, {});
+
+  incremental.reset();
+  ASSERT_TRUE(incremental(frame));
+  ASSERT_EQ(incremental.numChangedTiles(), incremental.numTiles());
+}
+
+TEST(IncrementalConvolverTest, StrideAndDilation) {
+  FilterPtr filter = core::test::createFilter<alignment>(5, 3, 3, 158);
+  for (const core::ConvolutionParams &params : {core::ConvolutionParams{2, 2, 1, 1}, core::ConvolutionParams{1, 1, 2, 2}, core::ConvolutionParams{2, 3, 2, 1}}) {
+    core::IncrementalConvolver<alignment> incremental(filter, 7, 5, params);
+    io::Image frame = core::test::createImage(53, 37, 3, 1961);
+    ASSERT_TRUE(incremental(frame));
+    verifyOutput(incremental, frame, filter, params);
+
+    for (const auto &[x, y] : {std::make_pair(0u, 0u), std::make_pair(52u, 36u), std::make_pair(14u, 10u), std::make_pair(27u, 19u)}) {
+      frame = changePixel(frame, x, y, 0);
+      ASSERT_TRUE(incremental(frame));
+      ASSERT_GT(incremental.numChangedTiles(), 0);
+      ASSERT_LT(incremental.numChangedTiles(), incremental.numTiles());
+      verifyOutput(incremental, frame, filter, params);
+    }
+  }
+}
+
+TEST(IncrementalConvolverTest, InterleavedFrames) {
+  FilterPtr filter = core::test::createFilter<alignment>(3, 4, 2, 95);
+  core::IncrementalConvolver<alignment> incremental(filter, 8, 8);
+
+  io::Image frame = core::test::createImage(40, 24, 4, 960, io::Layout::kInterleaved);
+  ASSERT_TRUE(incremental(frame));
+  frame = changePixel(frame, 12, 12, 3);
+  ASSERT_TRUE(incremental(frame));
+  ASSERT_EQ(incremental.numChangedTiles(), 1);
+  verifyOutput(incremental, frame, filter, {});
+}
+
+TEST(IncrementalConvolverTest, FailedFrame) {
+  spdlog::set_level(spdlog::level::off);
+  // dark frames fit the 16Bit accumulator, a bright pixel overflows it
+  FilterPtr filter = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, 1, 1, std::vector<uint8_t>(9, 255));
+  core::IncrementalConvolver<alignment> incremental(filter, 8, 8);
+
+  io::Image frame(32, 24, 1);
+  std::fill(frame.getImageBuffer()->begin(), frame.getImageBuffer()->end(), 10);
+  ASSERT_TRUE(incremental(frame));
+
+  io::Image bright(32, 24, 1);
+  *bright.getImageBuffer() = *frame.getImageBuffer();
+  (*bright.getImageBuffer())[bright.calcImageBufferOffset(12, 12, 0)] = 255;
+  ASSERT_ANY_THROW(incremental(bright));
+
+  // the failed frame isn't taken as the previous frame, so that repeating it convolves it again
+  ASSERT_ANY_THROW(incremental(bright));
+
+  // the frame following a failed frame is convolved as a whole
+  ASSERT_TRUE(incremental(frame));
+  ASSERT_EQ(incremental.numChangedTiles(), incremental.numTiles());
+  verifyOutput(incremental, frame, filter, {});
+  spdlog::set_level(spdlog::level::info);
+}
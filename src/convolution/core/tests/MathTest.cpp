@@ -35,3 +35,11 @@ TYPED_TEST(MathTestFixture, AlignmentLargerThanSize) {
   const TypeParam alignedSize = core::getAlignedSize<TypeParam, alignment>(size);
   ASSERT_EQ(alignment, alignedSize);
 }
+
+TYPED_TEST(MathTestFixture, Address64Bit) {
+  // a 200 MP RGB image with a 3x3 filter has a column buffer exceeding 4 GiB
+  constexpr uint32_t M = 200000000;
+  constexpr uint32_t N = 27;
+  ASSERT_EQ(core::address<core::MatrixOrder::kRowMajor>(M, N, M - 1, N - 1), uint64_t(M) * N - 1);
+  ASSERT_EQ(core::address<core::MatrixOrder::kColumnMajor>(M, N, M - 1, N - 1), uint64_t(M) * N - 1);
+}
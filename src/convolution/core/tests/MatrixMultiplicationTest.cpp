@@ -3,6 +3,7 @@
 #include <convolution/core/tests/TestResources.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <limits>
 #include <random>
 
@@ -166,3 +167,56 @@ TYPED_TEST(MatrixMultiplicationTestFixture, HardwareMultiplier) {
 
   ASSERT_EQ(memcmp(c_test.data(), c_reference.data(), c_test.size() * sizeof(TypeParam)), 0);
 }
+
+TEST(MatrixMultiplicationTest, SignedWeights) {
+  constexpr uint32_t M = 37;
+  constexpr uint32_t N = 8;
+  constexpr uint32_t K = 16;
+  constexpr uint32_t P = 8;
+
+  std::vector<uint8_t> a(M * K);
+  std::vector<int8_t> b(K * N);
+  std::vector<int32_t> c_test(M * N);
+  std::vector<int32_t> c_reference(M * N);
+
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int32_t> activations(0, std::numeric_limits<uint8_t>::max());
+  std::uniform_int_distribution<int32_t> weights(std::numeric_limits<int8_t>::min(), std::numeric_limits<int8_t>::max());
+  std::generate(a.begin(), a.end(), [&]() { return activations(generator); });
+  std::generate(b.begin(), b.end(), [&]() { return weights(generator); });
+
+  std::fill(c_test.begin(), c_test.end(), 0);
+  std::fill(c_reference.begin(), c_reference.end(), 0);
+
+  // create the reference multiplication using core::gemm()
+  bool referenceDidNotOverflow = core::gemm<int32_t, uint8_t, core::MatrixOrder::kColumnMajor, core::MatrixOrder::kColumnMajor, core::MatrixOrder::kRowMajor, true>(M, N, K, c_reference.data(), a.data(), b.data());
+  ASSERT_TRUE(referenceDidNotOverflow);
+
+  // create the test multiplication using core::mult(), which uses the u8 x s8 kernel
+  bool testDidNotOverflow = core::mult<int32_t, uint8_t, core::MatrixOrder::kColumnMajor, core::MatrixOrder::kColumnMajor, core::MatrixOrder::kRowMajor, P, true>(M, N, K, c_test.data(), a.data(), b.data());
+  ASSERT_TRUE(testDidNotOverflow);
+
+  ASSERT_EQ(c_test, c_reference);
+}
+
+TEST(MatrixMultiplicationTest, SignedDetectOverflow) {
+  constexpr uint32_t M = 5;
+
+  // 255 * -128 * 5 does not fit into a 16Bit result
+  std::vector<uint8_t> a(M * M, std::numeric_limits<uint8_t>::max());
+  std::vector<int8_t> b(M * M, std::numeric_limits<int8_t>::min());
+  std::vector<int16_t> c(M * M, 0);
+
+  bool didNotOverflow = core::gemm<int16_t, uint8_t, core::MatrixOrder::kRowMajor, true>(M, M, M, c.data(), a.data(), b.data());
+  ASSERT_FALSE(didNotOverflow);
+
+  // a pair of 255 * -128 products exceeds 16Bit, but is accumulated exactly into the 32Bit result
+  constexpr uint32_t P = 2;
+  std::vector<int32_t> c32(M * P, 0);
+  ASSERT_TRUE((core::gemmU8S8<P, true>(M, c32.data(), a.data(), b.data())));
+  ASSERT_EQ(c32[0], 2 * 255 * -128);
+
+  // the 32Bit result underflows
+  std::fill(c32.begin(), c32.end(), std::numeric_limits<int32_t>::min() + 1);
+  ASSERT_FALSE((core::gemmU8S8<P, true>(M, c32.data(), a.data(), b.data())));
+}
@@ -0,0 +1,101 @@
+#include <convolution/core/Convolver.h>
+#include <convolution/core/GroupedFilter.h>
+#include <convolution/core/Pipeline.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+using namespace convolution;
+
+namespace {
+
+constexpr uint32_t alignment = 4;
+using FilterPtr = std::shared_ptr<core::IFilter<uint8_t>>;
+
+io::Image createTestImage(const uint32_t width, const uint32_t height, const uint32_t channels) {
+  io::Image image(width, height, channels);
+  auto buffer = image.getImageBuffer();
+  for (uint32_t c = 0; c < channels; ++c) {
+    for (uint32_t y = 0; y < height; ++y) {
+      for (uint32_t x = 0; x < width; ++x) {
+        (*buffer)[image.calcImageBufferOffset(x, y, c)] = (29 * c + 13 * y + 7 * x + x * y) % 256;
+      }
+    }
+  }
+  return image;
+}
+
+/// apply the layers one after the other with separate convolvers
+io::Image applyLayers(const io::Image &input, const std::vector<FilterPtr> &layers) {
+  io::Image current = input;
+  for (const auto &filter : layers) {
+    core::Convolver<alignment> conv(filter);
+    conv.setImage(current);
+    EXPECT_TRUE(conv.convolve());
+    io::Image next(input.width(), input.height(), filter->numOutputChannels());
+    EXPECT_TRUE(conv.store(next, 0, 0));
+    current = next;
+  }
+  return current;
+}
+
+}  // namespace
+
+TEST(PipelineTest, Instantiate) {
+  using PipelineT = core::Pipeline<alignment>;
+  ASSERT_THROW(PipelineT pipeline({}), std::invalid_argument);
+  ASSERT_THROW(PipelineT pipeline({core::test::createFilter<alignment>(3, 3, 2, 1), core::test::createFilter<alignment>(3, 3, 1, 2)}), std::invalid_argument);
+  ASSERT_NO_THROW(PipelineT pipeline({core::test::createFilter<alignment>(3, 3, 2, 1), core::test::createFilter<alignment>(3, 2, 1, 2)}));
+
+  // a depthwise layer expects as many input channels as it has groups
+  FilterPtr depthwise = core::GroupedFilter<uint8_t, alignment>::depthwise(3, 3, 2, std::vector<uint8_t>(18, 1));
+  ASSERT_NO_THROW(PipelineT pipeline({core::test::createFilter<alignment>(3, 3, 2, 1), depthwise}));
+}
+
+TEST(PipelineTest, MatchesLayers) {
+  const io::Image input = createTestImage(29, 23, 3);
+  FilterPtr depthwise = core::GroupedFilter<uint8_t, alignment>::depthwise(3, 3, 2, std::vector<uint8_t>{1, 2, 1, 0, 1, 0, 1, 2, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0});
+  const std::vector<FilterPtr> layers = {core::test::createFilter<alignment>(3, 3, 4, 1), core::test::createFilter<alignment>(5, 4, 2, 2), depthwise, core::test::createFilter<alignment>(1, 2, 1, 3)};
+
+  // the reference runs each layer as a separate convolution
+  const io::Image reference = applyLayers(input, layers);
+  const size_t pixels = reference.pixels();
+
+  // unfused and fused with bands smaller than, equal to and larger than the halo
+  for (const uint32_t rows : {0u, 1u, 2u, 5u, 64u}) {
+    core::Pipeline<alignment> pipeline(layers, rows);
+    io::Image output{};
+    ASSERT_TRUE(pipeline(input, output));
+    ASSERT_EQ(output.width(), input.width());
+    ASSERT_EQ(output.height(), input.height());
+    ASSERT_EQ(output.channels(), 1u);
+    ASSERT_TRUE(std::equal(reference.getImageBuffer()->begin(), reference.getImageBuffer()->begin() + pixels, output.getImageBuffer()->begin())) << "fused rows " << rows;
+
+    // the buffers are planned once and reused by following runs
+    const size_t bufferSize = pipeline.bufferSize();
+    auto outputBuffer = output.getImageBuffer();
+    ASSERT_TRUE(pipeline(input, output));
+    ASSERT_EQ(pipeline.bufferSize(), bufferSize);
+    ASSERT_EQ(output.getImageBuffer(), outputBuffer);
+  }
+}
+
+TEST(PipelineTest, FusedBuffers) {
+  const io::Image input = createTestImage(32, 64, 1);
+  const std::vector<FilterPtr> layers = {core::test::createFilter<alignment>(3, 1, 2, 1), core::test::createFilter<alignment>(3, 2, 2, 2), core::test::createFilter<alignment>(3, 2, 1, 3)};
+
+  core::Pipeline<alignment> unfused(layers);
+  core::Pipeline<alignment> fused(layers, 4);
+  io::Image unfusedOutput{};
+  io::Image fusedOutput{};
+  ASSERT_TRUE(unfused(input, unfusedOutput));
+  ASSERT_TRUE(fused(input, fusedOutput));
+  ASSERT_EQ(*unfusedOutput.getImageBuffer(), *fusedOutput.getImageBuffer());
+
+  // unfused intermediate results cover the whole image, fused ones only a band of 4 rows plus a halo of 2x2 rows
+  ASSERT_EQ(unfused.bufferSize(), 2u * 32 * 64 * 2);
+  ASSERT_EQ(fused.bufferSize(), 2u * 32 * 8 * 2);
+}
@@ -0,0 +1,215 @@
+#include <convolution/core/StreamConvolver.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <convolution/io/FrameStream.h>
+#include <convolution/io/Image.h>
+#include <fcntl.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+/// number of allocations of the test executable, used to verify the steady state of the stream
+static std::atomic<uint64_t> allocations{0};
+
+void *operator new(size_t size) {
+  ++allocations;
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+// the replaced operators pair malloc and free, which gcc can't match against the new expressions
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { std::free(ptr); }
+
+using namespace convolution;
+
+namespace {
+
+constexpr uint32_t alignment = 4;
+using FilterPtr = std::shared_ptr<core::IFilter<uint8_t>>;
+
+std::vector<io::Image> createFrames(const uint32_t count, const uint32_t width, const uint32_t height, const uint32_t channels) {
+  std::mt19937 generator(width * height + channels);
+  std::uniform_int_distribution<uint32_t> distribution(0, 255);
+  std::vector<io::Image> frames;
+  for (uint32_t i = 0; i < count; ++i) {
+    frames.emplace_back(width, height, channels);
+    std::generate(frames.back().getImageBuffer()->begin(), frames.back().getImageBuffer()->end(), [&]() { return distribution(generator); });
+  }
+  return frames;
+}
+
+/// temporary file which is removed with the test
+class TempFile {
+ public:
+  fs::path path;
+  int fd = -1;
+
+  explicit TempFile(const std::string &name) : path(fs::temp_directory_path() / name) { fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644); }
+  ~TempFile() {
+    close(fd);
+    fs::remove(path);
+  }
+  void rewind() { lseek(fd, 0, SEEK_SET); }
+};
+
+/// convolve the frames of the reader and verify the outputs, frames following the first one must not allocate memory
+void verifyStream(io::FrameReader &reader, const std::vector<io::Image> &frames, FilterPtr filter, const core::ConvolutionParams &params) {
+  std::vector<std::vector<uint8_t>> expected;
+  for (const io::Image &frame : frames) {
+    expected.push_back(core::test::convolveImage<alignment>(frame, filter, params));
+  }
+  std::vector<std::vector<uint8_t>> outputs(frames.size(), std::vector<uint8_t>(expected.front().size()));
+  std::vector<uint64_t> counts(frames.size());
+
+  core::StreamConvolver<alignment> stream(filter, params);
+  size_t index = 0;
+  auto sink = [&](const io::Image &out) {
+    if (index >= outputs.size() || out.getImageBuffer()->size() < outputs[index].size()) {
+      return false;
+    }
+    std::copy_n(out.getImageBuffer()->data(), outputs[index].size(), outputs[index].data());
+    counts[index++] = allocations;
+    return true;
+  };
+  ASSERT_TRUE(stream(reader, sink));
+  ASSERT_TRUE(reader.eof());
+  ASSERT_EQ(stream.numFrames(), frames.size());
+  ASSERT_EQ(index, frames.size());
+
+  for (size_t i = 0; i < frames.size(); ++i) {
+    ASSERT_EQ(outputs[i], expected[i]) << "frame " << i;
+  }
+  for (size_t i = 1; i < frames.size(); ++i) {
+    ASSERT_EQ(counts[i], counts[i - 1]) << "frame " << i << " allocated memory";
+  }
+}
+
+}  // namespace
+
+TEST(StreamConvolverTest, RawFrames) {
+  spdlog::set_level(spdlog::level::warn);
+  const std::vector<io::Image> frames = createFrames(5, 37, 23, 3);
+  FilterPtr filter = core::test::createFilter<alignment>(3, 3, 2, 53);
+
+  TempFile file("StreamConvolverTest_raw.bin");
+  ASSERT_GE(file.fd, 0);
+  auto writer = io::FrameWriter::raw(file.fd, 37, 23, 3, io::RawType::kUInt8);
+  ASSERT_TRUE(writer);
+  for (const io::Image &frame : frames) {
+    ASSERT_TRUE(writer->write(frame.getImageBuffer()->data()));
+  }
+  file.rewind();
+
+  auto reader = io::FrameReader::raw(file.fd, 37, 23, 3, io::RawType::kUInt8);
+  ASSERT_TRUE(reader);
+  verifyStream(*reader, frames, filter, core::ConvolutionParams());
+}
+
+TEST(StreamConvolverTest, Y4MFrames) {
+  spdlog::set_level(spdlog::level::warn);
+  const std::vector<io::Image> frames = createFrames(4, 31, 17, 3);
+  FilterPtr filter = core::test::createFilter<alignment>(5, 3, 4, 89);
+  core::ConvolutionParams params;
+  params.strideX = 2;
+  params.strideY = 2;
+
+  TempFile file("StreamConvolverTest_444.y4m");
+  ASSERT_GE(file.fd, 0);
+  auto writer = io::FrameWriter::y4m(file.fd, 31, 17, 3);
+  ASSERT_TRUE(writer);
+  for (const io::Image &frame : frames) {
+    ASSERT_TRUE(writer->write(frame.getImageBuffer()->data()));
+  }
+  file.rewind();
+
+  auto reader = io::FrameReader::y4m(file.fd);
+  ASSERT_TRUE(reader);
+  ASSERT_EQ(reader->width(), 31u);
+  ASSERT_EQ(reader->height(), 17u);
+  ASSERT_EQ(reader->channels(), 3u);
+  verifyStream(*reader, frames, filter, params);
+}
+
+TEST(StreamConvolverTest, Y4MLuma) {
+  spdlog::set_level(spdlog::level::warn);
+  const std::vector<io::Image> frames = createFrames(3, 9, 7, 1);
+  FilterPtr filter = core::test::createFilter<alignment>(3, 1, 1, 52);
+
+  // 4:2:0 frames with frame parameters, the chroma planes of 5x4 pixels are skipped
+  TempFile file("StreamConvolverTest_420.y4m");
+  ASSERT_GE(file.fd, 0);
+  const std::string header = "YUV4MPEG2 W9 H7 F30:1 Ip A1:1 C420jpeg XYSCSS=420JPEG\n";
+  ASSERT_EQ(::write(file.fd, header.data(), header.size()), static_cast<ssize_t>(header.size()));
+  const std::vector<uint8_t> chroma(2 * 5 * 4, 128);
+  for (const io::Image &frame : frames) {
+    const std::string frameHeader = "FRAME Ixyz\n";
+    ASSERT_EQ(::write(file.fd, frameHeader.data(), frameHeader.size()), static_cast<ssize_t>(frameHeader.size()));
+    ASSERT_EQ(::write(file.fd, frame.getImageBuffer()->data(), 9 * 7), 9 * 7);
+    ASSERT_EQ(::write(file.fd, chroma.data(), chroma.size()), static_cast<ssize_t>(chroma.size()));
+  }
+  file.rewind();
+
+  auto reader = io::FrameReader::y4m(file.fd);
+  ASSERT_TRUE(reader);
+  ASSERT_EQ(reader->channels(), 1u);
+  verifyStream(*reader, frames, filter, core::ConvolutionParams());
+}
+
+TEST(StreamConvolverTest, StreamToStream) {
+  spdlog::set_level(spdlog::level::warn);
+  const std::vector<io::Image> frames = createFrames(3, 16, 12, 1);
+  FilterPtr filter = core::test::createFilter<alignment>(3, 1, 3, 54);
+
+  TempFile input("StreamConvolverTest_input.y4m");
+  TempFile output("StreamConvolverTest_output.y4m");
+  ASSERT_GE(input.fd, 0);
+  ASSERT_GE(output.fd, 0);
+  auto writer = io::FrameWriter::y4m(input.fd, 16, 12, 1);
+  ASSERT_TRUE(writer);
+  for (const io::Image &frame : frames) {
+    ASSERT_TRUE(writer->write(frame.getImageBuffer()->data()));
+  }
+  input.rewind();
+
+  auto reader = io::FrameReader::y4m(input.fd);
+  auto outWriter = io::FrameWriter::y4m(output.fd, 16, 12, 3);
+  ASSERT_TRUE(reader);
+  ASSERT_TRUE(outWriter);
+  core::StreamConvolver<alignment> stream(filter);
+  ASSERT_TRUE(stream(*reader, *outWriter));
+  output.rewind();
+
+  // the output stream contains 4:4:4 frames of the 3 output channels
+  auto outReader = io::FrameReader::y4m(output.fd);
+  ASSERT_TRUE(outReader);
+  ASSERT_EQ(outReader->channels(), 3u);
+  std::vector<uint8_t> planes(16 * 12 * 3);
+  for (const io::Image &frame : frames) {
+    ASSERT_TRUE(outReader->read(planes.data()));
+    ASSERT_EQ(planes, core::test::convolveImage<alignment>(frame, filter));
+  }
+  ASSERT_FALSE(outReader->read(planes.data()));
+  ASSERT_TRUE(outReader->eof());
+
+  // the filter expects a single channel, type mismatches are rejected
+  input.rewind();
+  auto floatReader = io::FrameReader::raw(input.fd, 16, 12, 1, io::RawType::kFloat32);
+  ASSERT_TRUE(floatReader);
+  ASSERT_FALSE(stream(*floatReader, *outWriter));
+}
@@ -1,11 +1,18 @@
 #ifndef CONVOLUTION_CORE_TEST_TESTRESOURCES_H
 #define CONVOLUTION_CORE_TEST_TESTRESOURCES_H
 
+#include <convolution/core/Convolver.h>
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/Filter.h>
 #include <convolution/core/math.h>
+#include <convolution/io/Image.h>
+#include <gtest/gtest.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <random>
 #include <sstream>
 #include <vector>
@@ -70,6 +77,39 @@ void print(const uint32_t M, const uint32_t N, const T *data) {
   std::cout << ss.str() << std::endl;
 }
 
+/// \brief create a filter with random weights in [0, 2], which keep the accumulators of 8Bit images from overflowing
+template <uint32_t alignment>
+std::shared_ptr<IFilter<uint8_t>> createFilter(const uint32_t size, const uint32_t inputChannels, const uint32_t outputChannels, const uint32_t seed) {
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<uint32_t> distribution(0, 2);
+  std::vector<uint8_t> elements(size * size * inputChannels * outputChannels);
+  std::generate(elements.begin(), elements.end(), [&]() { return static_cast<uint8_t>(distribution(generator)); });
+  return std::make_shared<DynamicFilter<uint8_t, alignment>>(size, size, inputChannels, outputChannels, elements);
+}
+
+/// \brief create an image with random pixels
+inline io::Image createImage(const uint32_t width, const uint32_t height, const uint32_t channels, const uint32_t seed, const io::Layout layout = io::Layout::kPlanar) {
+  io::Image image(width, height, channels, layout);
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<uint32_t> distribution(0, 255);
+  std::generate(image.getImageBuffer()->begin(), image.getImageBuffer()->end(), [&]() { return distribution(generator); });
+  return image;
+}
+
+/// \brief returns the planar output of convolving the whole image with a separate Convolver, the reference of the tests
+template <uint32_t alignment>
+std::vector<uint8_t> convolveImage(const io::Image &image, std::shared_ptr<IFilter<uint8_t>> filter, const ConvolutionParams &params = ConvolutionParams()) {
+  Convolver<alignment> conv(filter, params);
+  conv.setImage(image);
+  EXPECT_TRUE(conv.convolve());
+  io::Image reference(getOutputSize(image.width(), params.strideX), getOutputSize(image.height(), params.strideY), filter->numOutputChannels());
+  EXPECT_TRUE(conv.store(reference, 0, 0));
+  return std::vector<uint8_t>(reference.getImageBuffer()->begin(), reference.getImageBuffer()->end());
+}
+
+/// \brief returns a copy of the pixels of the image
+inline std::vector<uint8_t> toVector(const io::Image &image) { return std::vector<uint8_t>(image.getImageBuffer()->begin(), image.getImageBuffer()->end()); }
+
 }  // namespace test
 }  // namespace core
 }  // namespace convolution
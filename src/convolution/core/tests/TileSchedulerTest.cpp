@@ -0,0 +1,99 @@
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/TileScheduler.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <convolution/io/Image.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace convolution;
+
+namespace {
+
+constexpr uint32_t alignment = 4;
+using FilterPtr = std::shared_ptr<core::IFilter<uint8_t>>;
+using SchedulerT = core::TileScheduler<alignment>;
+
+/// a huge image followed by many tiny images of different sizes
+std::vector<io::Image> createBatch() {
+  std::vector<io::Image> images = {core::test::createImage(257, 190, 3, 0)};
+  for (uint32_t i = 1; i <= 60; ++i) {
+    images.push_back(core::test::createImage(4 + i % 9, 3 + i % 7, 3, i));
+  }
+  return images;
+}
+
+void verifyBatch(const std::vector<io::Image> &images, const std::vector<io::Image> &outputs, FilterPtr filter, const core::ConvolutionParams &params) {
+  ASSERT_EQ(outputs.size(), images.size());
+  for (size_t i = 0; i < images.size(); ++i) {
+    ASSERT_EQ(core::test::toVector(outputs[i]), core::test::convolveImage<alignment>(images[i], filter, params)) << "image " << i;
+  }
+}
+
+}  // namespace
+
+TEST(TileSchedulerTest, HeterogeneousBatch) {
+  spdlog::set_level(spdlog::level::warn);
+  const std::vector<io::Image> images = createBatch();
+  FilterPtr filter = core::test::createFilter<alignment>(3, 3, 5, 38);
+
+  // small bands split the huge image into many tasks
+  SchedulerT scheduler(filter, core::ConvolutionParams(), 4, 1000);
+  ASSERT_EQ(scheduler.numWorkers(), 4u);
+  std::vector<io::Image> outputs;
+  ASSERT_TRUE(scheduler(images, outputs));
+  verifyBatch(images, outputs, filter, core::ConvolutionParams());
+
+  // the outputs and the buffers of the threads are reused by the next batch
+  ASSERT_TRUE(scheduler(images, outputs));
+  verifyBatch(images, outputs, filter, core::ConvolutionParams());
+}
+
+TEST(TileSchedulerTest, StrideAndDilation) {
+  spdlog::set_level(spdlog::level::warn);
+  const std::vector<io::Image> images = createBatch();
+  FilterPtr filter = core::test::createFilter<alignment>(5, 3, 2, 57);
+  core::ConvolutionParams params;
+  params.strideX = 2;
+  params.strideY = 3;
+  params.dilationY = 2;
+
+  SchedulerT scheduler(filter, params, 3, 64);
+  std::vector<io::Image> outputs;
+  ASSERT_TRUE(scheduler(images, outputs));
+  verifyBatch(images, outputs, filter, params);
+
+  // a single thread never steals
+  SchedulerT single(filter, params, 1);
+  ASSERT_TRUE(single(images, outputs));
+  ASSERT_EQ(single.numSteals(), 0u);
+  verifyBatch(images, outputs, filter, params);
+}
+
+TEST(TileSchedulerTest, InvalidImage) {
+  spdlog::set_level(spdlog::level::off);
+  FilterPtr filter = core::test::createFilter<alignment>(3, 3, 2, 35);
+  SchedulerT scheduler(filter, core::ConvolutionParams(), 2);
+  std::vector<io::Image> outputs;
+
+  std::vector<io::Image> images = createBatch();
+  images.push_back(core::test::createImage(9, 9, 1, 0));
+  ASSERT_FALSE(scheduler(images, outputs));
+
+  images.back() = io::Image();
+  ASSERT_FALSE(scheduler(images, outputs));
+
+  std::vector<io::Image> empty;
+  ASSERT_TRUE(scheduler(empty, outputs));
+  ASSERT_TRUE(outputs.empty());
+
+  // the accumulators overflow for the largest weights on a bright image
+  FilterPtr overflowing = std::make_shared<core::DynamicFilter<uint8_t, alignment>>(3, 3, 3, 1, std::vector<uint8_t>(27, 255));
+  SchedulerT failing(overflowing, core::ConvolutionParams(), 2, 16);
+  images = createBatch();
+  std::fill(images[0].getImageBuffer()->begin(), images[0].getImageBuffer()->end(), 255);
+  ASSERT_FALSE(failing(images, outputs));
+}
@@ -0,0 +1,104 @@
+#include <convolution/core/Convolver.h>
+#include <convolution/core/GroupedFilter.h>
+#include <convolution/core/TiledConvolver.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <convolution/io/Image.h>
+#include <gtest/gtest.h>
+
+#include <boost/preprocessor/stringize.hpp>
+
+#include <memory>
+#include <vector>
+
+using namespace convolution;
+
+namespace {
+
+constexpr uint32_t alignment = 4;
+using FilterPtr = std::shared_ptr<core::IFilter<uint8_t>>;
+
+fs::path getPath(const std::string &filename) {
+  return fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / filename;
+}
+
+/// create a raw tensor test image
+void createTestImage(const fs::path &p, const uint32_t width, const uint32_t height, const uint32_t channels) {
+  io::Image image{};
+  ASSERT_TRUE(image.createRaw(p, width, height, channels));
+  auto buffer = image.getImageBuffer();
+  for (uint32_t c = 0; c < channels; ++c) {
+    for (uint32_t y = 0; y < height; ++y) {
+      for (uint32_t x = 0; x < width; ++x) {
+        (*buffer)[image.calcImageBufferOffset(x, y, c)] = (37 * c + 11 * y + 3 * x + x * y) % 256;
+      }
+    }
+  }
+}
+
+/// compare the tiled convolution against the convolution of the whole image in memory
+void verifyTiles(const fs::path &input, FilterPtr filter, const uint32_t tileWidth, const uint32_t tileHeight, const core::ConvolutionParams &params = core::ConvolutionParams()) {
+  core::Convolver<alignment> conv(filter, params);
+  ASSERT_TRUE(conv.read(input));
+  ASSERT_TRUE(conv.convolve());
+
+  io::Image image{};
+  ASSERT_TRUE(image.read(input));
+  io::Image reference(core::getOutputSize(image.width(), params.strideX), core::getOutputSize(image.height(), params.strideY), filter->numOutputChannels());
+  ASSERT_TRUE(conv.store(reference, 0, 0));
+
+  const fs::path output = getPath("TestImageTiledOutput.raw");
+  core::TiledConvolver<alignment> tiled(filter, tileWidth, tileHeight, params);
+  ASSERT_TRUE(tiled(input, output));
+
+  io::Image result{};
+  ASSERT_TRUE(result.read(output));
+  ASSERT_EQ(result.width(), reference.width());
+  ASSERT_EQ(result.height(), reference.height());
+  ASSERT_EQ(result.channels(), reference.channels());
+  ASSERT_EQ(*result.getImageBuffer(), *reference.getImageBuffer()) << "tiles " << tileWidth << "x" << tileHeight;
+}
+
+}  // namespace
+
+TEST(TiledConvolverTest, Instantiate) {
+  ASSERT_THROW(core::TiledConvolver<alignment> tiled(core::test::createFilter<alignment>(3, 3, 1, 94), 0, 8), std::invalid_argument);
+
+  // the input must be a raw tensor of the image data type
+  core::TiledConvolver<alignment> tiled(core::test::createFilter<alignment>(3, 3, 1, 94), 8, 8);
+  ASSERT_FALSE(tiled(getPath("DoesNotExist.raw"), getPath("TestImageTiledOutput.raw")));
+
+  io::Image16 image{};
+  ASSERT_TRUE(image.createRaw(getPath("TestImageTiled16.raw"), 4, 4, 3));
+  ASSERT_FALSE(tiled(getPath("TestImageTiled16.raw"), getPath("TestImageTiledOutput.raw")));
+}
+
+TEST(TiledConvolverTest, MatchesConvolver) {
+  const fs::path input = getPath("TestImageTiled.raw");
+  createTestImage(input, 37, 29, 3);
+
+  // tiles smaller than the filter, uneven tiles and a single tile covering the whole image
+  for (const auto &[tileWidth, tileHeight] : std::vector<std::pair<uint32_t, uint32_t>>{{1, 1}, {8, 5}, {16, 16}, {64, 64}}) {
+    verifyTiles(input, core::test::createFilter<alignment>(3, 3, 2, 95), tileWidth, tileHeight);
+    verifyTiles(input, core::test::createFilter<alignment>(5, 3, 1, 156), tileWidth, tileHeight);
+  }
+
+  FilterPtr depthwise = core::GroupedFilter<uint8_t, alignment>::depthwise(3, 3, 3, std::vector<uint8_t>(27, 1));
+  verifyTiles(input, depthwise, 7, 6);
+
+  // stride and dilation
+  verifyTiles(input, core::test::createFilter<alignment>(3, 3, 2, 95), 5, 4, {2, 2, 1, 1});
+  verifyTiles(input, core::test::createFilter<alignment>(3, 3, 2, 95), 5, 4, {3, 2, 2, 3});
+  verifyTiles(input, core::test::createFilter<alignment>(5, 3, 1, 156), 4, 3, {2, 3, 1, 2});
+}
+
+TEST(TiledConvolverTest, BoundedMemory) {
+  const fs::path input = getPath("TestImageTiled.raw");
+  createTestImage(input, 200, 150, 3);
+
+  core::TiledConvolver<alignment> tiled(core::test::createFilter<alignment>(5, 3, 2, 157), 16, 8);
+  ASSERT_TRUE(tiled(input, getPath("TestImageTiledOutput.raw")));
+
+  // the buffers only hold an input tile with a halo of 2 pixels and an output tile
+  ASSERT_LE(tiled.bufferSize(), (16u + 4) * (8 + 4) * 3 + 16 * 8 * 2);
+}
@@ -0,0 +1,230 @@
+#include <convolution/io/FrameStream.h>
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace convolution {
+namespace io {
+
+namespace {
+
+/// maximum length of a Y4M stream header or frame header line that is interpreted, longer lines are consumed but truncated
+constexpr size_t kMaxY4MLine = 1024;
+
+}  // namespace
+
+FrameReader::FrameReader(int fd, const FrameFormat format, const uint32_t width, const uint32_t height, const uint32_t channels, const RawType type)
+    : fd(fd), format(format), frameWidth(width), frameHeight(height), frameChannels(channels), frameType(type) {}
+
+/// \brief open a stream of planar frames without any header, e.g. produced by ffmpeg -f rawvideo -pix_fmt gbrp
+/// \param fd(int) file descriptor of the stream, which is not closed by the reader
+/// \param width(const uint32_t) frame width in pixels
+/// \param height(const uint32_t) frame height in pixels
+/// \param channels(const uint32_t) number of frame channels
+/// \param type(const RawType) data type of a single channel pixel
+/// \return the frame reader on success, nullptr otherwise
+std::unique_ptr<FrameReader> FrameReader::raw(int fd, const uint32_t width, const uint32_t height, const uint32_t channels, const RawType type) {
+  if (fd < 0 || width == 0 || height == 0 || channels == 0 || getRawTypeSize(type) == 0) {
+    spdlog::error("Invalid raw frame stream {}x{}x{} of type {} on descriptor {}.", width, height, channels, static_cast<uint32_t>(type), fd);
+    return nullptr;
+  }
+  return std::unique_ptr<FrameReader>(new FrameReader(fd, FrameFormat::kRaw, width, height, channels, type));
+}
+
+/// \brief open a YUV4MPEG2 stream and parse its header
+/// \param fd(int) file descriptor of the stream, which is not closed by the reader
+/// \return the frame reader on success, nullptr otherwise
+std::unique_ptr<FrameReader> FrameReader::y4m(int fd) {
+  std::unique_ptr<FrameReader> reader(new FrameReader(fd, FrameFormat::kY4M, 0, 0, 0, RawType::kUInt8));
+
+  char line[kMaxY4MLine];
+  if (fd < 0 || !reader->readLine(line, sizeof(line), false) || std::strncmp(line, "YUV4MPEG2", 9) != 0) {
+    spdlog::error("Stream on descriptor {} is not a YUV4MPEG2 stream.", fd);
+    return nullptr;
+  }
+
+  // default chroma subsampling of the format is 4:2:0
+  const char *colorSpace = "420";
+  char *state = nullptr;
+  for (char *token = strtok_r(line + 9, " ", &state); token != nullptr; token = strtok_r(nullptr, " ", &state)) {
+    switch (token[0]) {
+      case 'W':
+        reader->frameWidth = std::strtoul(token + 1, nullptr, 10);
+        break;
+      case 'H':
+        reader->frameHeight = std::strtoul(token + 1, nullptr, 10);
+        break;
+      case 'C':
+        colorSpace = token + 1;
+        break;
+      default:
+        break;
+    }
+  }
+
+  const size_t chromaWidth = (reader->frameWidth + 1) / 2;
+  size_t skipSize = 0;
+  if (std::strcmp(colorSpace, "mono") == 0) {
+    reader->frameChannels = 1;
+  } else if (std::strcmp(colorSpace, "444") == 0) {
+    reader->frameChannels = 3;
+  } else if (std::strcmp(colorSpace, "444alpha") == 0) {
+    reader->frameChannels = 4;
+  } else if (std::strncmp(colorSpace, "420", 3) == 0) {
+    reader->frameChannels = 1;
+    skipSize = 2 * chromaWidth * ((reader->frameHeight + 1) / 2);
+  } else if (std::strcmp(colorSpace, "422") == 0) {
+    reader->frameChannels = 1;
+    skipSize = 2 * chromaWidth * reader->frameHeight;
+  } else {
+    spdlog::error("YUV4MPEG2 color space {} is not supported.", colorSpace);
+    return nullptr;
+  }
+
+  if (reader->frameWidth == 0 || reader->frameHeight == 0) {
+    spdlog::error("YUV4MPEG2 stream has an invalid frame size {}x{}.", reader->frameWidth, reader->frameHeight);
+    return nullptr;
+  }
+
+  if (skipSize > 0) {
+    spdlog::info("Reading the luma of the YUV4MPEG2 stream with color space {}, the chroma planes are skipped.", colorSpace);
+    reader->skipBuffer.resize(skipSize);
+  }
+  return reader;
+}
+
+/// \brief read exactly size bytes, the end of the stream is only accepted before the first byte of a frame
+bool FrameReader::readBytes(void *dst, const size_t size, const bool atFrameStart) {
+  uint8_t *bytes = static_cast<uint8_t *>(dst);
+  size_t remaining = size;
+  while (remaining > 0) {
+    const ssize_t result = ::read(fd, bytes, remaining);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result == 0 && atFrameStart && remaining == size) {
+      endOfStream = true;
+      return false;
+    }
+    if (result <= 0) {
+      spdlog::error("Failed to read frame from descriptor {}: {}", fd, result == 0 ? "truncated frame" : std::strerror(errno));
+      return false;
+    }
+    bytes += result;
+    remaining -= result;
+  }
+  return true;
+}
+
+/// \brief read a line terminated by a newline, characters that exceed the line buffer are dropped
+bool FrameReader::readLine(char *line, const size_t size, const bool atFrameStart) {
+  size_t length = 0;
+  char c = 0;
+  if (!readBytes(&c, 1, atFrameStart)) {
+    return false;
+  }
+  while (c != '\n') {
+    if (length + 1 < size) {
+      line[length++] = c;
+    }
+    if (!readBytes(&c, 1, false)) {
+      return false;
+    }
+  }
+  line[length] = '\0';
+  return true;
+}
+
+/// \brief read the next frame into planes
+/// \param planes(void *) planar buffer of width x height x channels elements of the frame type
+/// \return true if a frame has been read, false at the end of the stream or on error, which are distinguished by eof()
+bool FrameReader::read(void *planes) {
+  if (endOfStream) {
+    return false;
+  }
+
+  const size_t size = static_cast<size_t>(frameWidth) * frameHeight * frameChannels * getRawTypeSize(frameType);
+  if (format == FrameFormat::kRaw) {
+    return readBytes(planes, size, true);
+  }
+
+  char line[kMaxY4MLine];
+  if (!readLine(line, sizeof(line), true)) {
+    return false;
+  }
+  if (std::strncmp(line, "FRAME", 5) != 0) {
+    spdlog::error("Expected a YUV4MPEG2 frame header on descriptor {}.", fd);
+    return false;
+  }
+  return readBytes(planes, size, false) && (skipBuffer.empty() || readBytes(skipBuffer.data(), skipBuffer.size(), false));
+}
+
+/// \brief create a stream of planar frames without any header
+/// \param fd(int) file descriptor of the stream, which is not closed by the writer
+/// \return the frame writer on success, nullptr otherwise
+std::unique_ptr<FrameWriter> FrameWriter::raw(int fd, const uint32_t width, const uint32_t height, const uint32_t channels, const RawType type) {
+  if (fd < 0 || getRawTypeSize(type) == 0) {
+    spdlog::error("Invalid raw frame stream of type {} on descriptor {}.", static_cast<uint32_t>(type), fd);
+    return nullptr;
+  }
+  const size_t frameSize = static_cast<size_t>(width) * height * channels * getRawTypeSize(type);
+  return std::unique_ptr<FrameWriter>(new FrameWriter(fd, FrameFormat::kRaw, frameSize));
+}
+
+/// \brief create a YUV4MPEG2 stream of 8Bit frames and write its header
+/// \param fd(int) file descriptor of the stream, which is not closed by the writer
+/// \param channels(const uint32_t) 1 for monochrome, 3 for 4:4:4 and 4 for 4:4:4 with alpha
+/// \return the frame writer on success, nullptr otherwise
+std::unique_ptr<FrameWriter> FrameWriter::y4m(int fd, const uint32_t width, const uint32_t height, const uint32_t channels) {
+  const char *colorSpace = channels == 1 ? "mono" : channels == 3 ? "444" : channels == 4 ? "444alpha" : nullptr;
+  if (fd < 0 || colorSpace == nullptr) {
+    spdlog::error("YUV4MPEG2 streams of {} channels are not supported.", channels);
+    return nullptr;
+  }
+
+  const size_t frameSize = static_cast<size_t>(width) * height * channels;
+  std::unique_ptr<FrameWriter> writer(new FrameWriter(fd, FrameFormat::kY4M, frameSize));
+
+  char header[kMaxY4MLine];
+  const int length = std::snprintf(header, sizeof(header), "YUV4MPEG2 W%u H%u F25:1 Ip A1:1 C%s\n", width, height, colorSpace);
+  if (!writer->writeBytes(header, length)) {
+    return nullptr;
+  }
+  return writer;
+}
+
+bool FrameWriter::writeBytes(const void *src, const size_t size) {
+  const uint8_t *bytes = static_cast<const uint8_t *>(src);
+  size_t remaining = size;
+  while (remaining > 0) {
+    const ssize_t result = ::write(fd, bytes, remaining);
+    if (result < 0 && errno == EINTR) {
+      continue;
+    }
+    if (result <= 0) {
+      spdlog::error("Failed to write frame to descriptor {}: {}", fd, std::strerror(errno));
+      return false;
+    }
+    bytes += result;
+    remaining -= result;
+  }
+  return true;
+}
+
+/// \brief write the next frame
+/// \param planes(const void *) planar buffer of the frame
+/// \return true on success, false otherwise
+bool FrameWriter::write(const void *planes) {
+  static constexpr char kFrameHeader[] = "FRAME\n";
+  if (format == FrameFormat::kY4M && !writeBytes(kFrameHeader, sizeof(kFrameHeader) - 1)) {
+    return false;
+  }
+  return writeBytes(planes, frameSize);
+}
+
+}  // namespace io
+}  // namespace convolution
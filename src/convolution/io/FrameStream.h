@@ -0,0 +1,81 @@
+#ifndef CONVOLUTION_IO_FRAMESTREAM_H
+#define CONVOLUTION_IO_FRAMESTREAM_H
+
+#include <convolution/core/logging.h>
+#include <convolution/io/RawFormat.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace convolution {
+namespace io {
+
+/// \brief container formats of frame streams
+enum class FrameFormat {
+  kRaw,  ///< planar frames of a fixed size and type without any header
+  kY4M,  ///< YUV4MPEG2 stream of 8Bit frames, each preceded by a FRAME marker
+};
+
+/// \class FrameReader
+/// \brief reads a sequence of planar frames from a file descriptor, e.g. a pipe, a socket or a file
+/// Each frame is read directly into the planar buffer provided by the caller. Y4M streams with 4:4:4 chroma are read
+/// as 3 channel frames (4 with alpha), monochrome streams and the luma of subsampled streams as single channel frames.
+/// No memory is allocated after the stream has been opened.
+class FrameReader {
+ private:
+  int fd = -1;                      ///< file descriptor of the stream, not owned by the reader
+  FrameFormat format;               ///< container format of the stream
+  uint32_t frameWidth = 0;          ///< frame width in pixels
+  uint32_t frameHeight = 0;         ///< frame height in pixels
+  uint32_t frameChannels = 0;       ///< number of channels read into the frame buffer
+  RawType frameType;                ///< data type of a single channel pixel
+  std::vector<uint8_t> skipBuffer;  ///< receives the subsampled chroma planes of Y4M streams, which are not used
+  bool endOfStream = false;         ///< the end of the stream has been reached at a frame boundary
+
+  FrameReader(int fd, const FrameFormat format, const uint32_t width, const uint32_t height, const uint32_t channels, const RawType type);
+  bool readBytes(void *dst, const size_t size, const bool atFrameStart);
+  bool readLine(char *line, const size_t size, const bool atFrameStart);
+
+ public:
+  FrameReader(const FrameReader &rhs) = delete;
+  FrameReader &operator=(const FrameReader &rhs) = delete;
+
+  static std::unique_ptr<FrameReader> raw(int fd, const uint32_t width, const uint32_t height, const uint32_t channels, const RawType type);
+  static std::unique_ptr<FrameReader> y4m(int fd);
+
+  uint32_t width() const { return frameWidth; }        ///< returns the frame width in pixels
+  uint32_t height() const { return frameHeight; }      ///< returns the frame height in pixels
+  uint32_t channels() const { return frameChannels; }  ///< returns the number of channels of a frame
+  RawType type() const { return frameType; }           ///< returns the data type of a single channel pixel
+  bool eof() const { return endOfStream; }             ///< returns true once the end of the stream has been reached
+
+  bool read(void *planes);
+};
+
+/// \class FrameWriter
+/// \brief writes a sequence of planar frames to a file descriptor
+/// Y4M streams are written for 8Bit frames with 1 (monochrome), 3 (4:4:4) or 4 (4:4:4 with alpha) channels.
+class FrameWriter {
+ private:
+  int fd = -1;           ///< file descriptor of the stream, not owned by the writer
+  FrameFormat format;    ///< container format of the stream
+  size_t frameSize = 0;  ///< size of a single frame in bytes
+
+  FrameWriter(int fd, const FrameFormat format, const size_t frameSize) : fd(fd), format(format), frameSize(frameSize) {}
+  bool writeBytes(const void *src, const size_t size);
+
+ public:
+  FrameWriter(const FrameWriter &rhs) = delete;
+  FrameWriter &operator=(const FrameWriter &rhs) = delete;
+
+  static std::unique_ptr<FrameWriter> raw(int fd, const uint32_t width, const uint32_t height, const uint32_t channels, const RawType type);
+  static std::unique_ptr<FrameWriter> y4m(int fd, const uint32_t width, const uint32_t height, const uint32_t channels);
+
+  bool write(const void *planes);
+};
+
+}  // namespace io
+}  // namespace convolution
+
+#endif  // CONVOLUTION_IO_FRAMESTREAM_H
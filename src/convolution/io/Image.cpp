@@ -1,40 +1,297 @@
 #include <convolution/core/math.h>
 #include <convolution/io/Image.h>
 
+#include <jpeglib.h>
+#include <png.h>
+
 #include <algorithm>
+#include <array>
+#include <cerrno>
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <vector>
 
 namespace convolution {
 namespace io {
 
+namespace {
+
+/// image formats decoded without CImg
+enum class Format {
+  kUnknown,
+  kRaw,
+  kPng,
+  kJpeg,
+};
+
+/// \brief detect the image format from the signature at the start of the file
+Format detectFormat(const fs::path &path) {
+  std::array<uint8_t, 8> signature{};
+  std::ifstream file(path, std::ios::binary);
+  file.read(reinterpret_cast<char *>(signature.data()), signature.size());
+  if (file.gcount() < 4) {
+    return Format::kUnknown;
+  }
+
+  if (memcmp(signature.data(), RawHeader::kMagic, sizeof(RawHeader::kMagic)) == 0) {
+    return Format::kRaw;
+  }
+  if (file.gcount() == static_cast<std::streamsize>(signature.size()) && png_sig_cmp(signature.data(), 0, signature.size()) == 0) {
+    return Format::kPng;
+  }
+  if (signature[0] == 0xff && signature[1] == 0xd8 && signature[2] == 0xff) {
+    return Format::kJpeg;
+  }
+  return Format::kUnknown;
+}
+
+/// \brief store a decoded row of interleaved samples into an image buffer of the layout provided
+template <typename T, typename S>
+void storeRow(const S *row, T *buffer, const uint32_t y, const uint32_t width, const uint32_t channels, const uint64_t planeSize, const Layout layout) {
+  if (layout == Layout::kInterleaved) {
+    std::copy_n(row, static_cast<size_t>(width) * channels, buffer + static_cast<uint64_t>(y) * width * channels);
+  } else {
+    interleavedToPlanar(row, buffer + static_cast<uint64_t>(y) * width, width, channels, planeSize);
+  }
+}
+
+/// libjpeg error manager returning control to the decoder instead of terminating the process
+struct JpegErrorManager {
+  jpeg_error_mgr pub;
+  jmp_buf jump;
+};
+
+void jpegErrorExit(j_common_ptr cinfo) {
+  char message[JMSG_LENGTH_MAX];
+  (*cinfo->err->format_message)(cinfo, message);
+  spdlog::error("libjpeg: {}", message);
+  longjmp(reinterpret_cast<JpegErrorManager *>(cinfo->err)->jump, 1);
+}
+
+/// \brief decodes a PNG image into a planar or interleaved buffer
+/// The buffers live in the decoder rather than in decode(), so that they are not affected when libpng reports an
+/// error by jumping back into decode().
+template <typename T, typename S>
+struct PngDecoder {
+  std::shared_ptr<S> buffer;
+  std::vector<png_byte> rows;
+  std::vector<png_bytep> rowPointers;
+  Layout layout = Layout::kPlanar;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t channels = 0;
+
+  bool decode(png_structp png, png_infop info, FILE *fp) {
+    if (setjmp(png_jmpbuf(png))) {
+      return false;
+    }
+
+    png_init_io(png, fp);
+    png_read_info(png, info);
+
+    const png_byte colorType = png_get_color_type(png, info);
+    const png_byte bitDepth = png_get_bit_depth(png, info);
+    if (colorType == PNG_COLOR_TYPE_PALETTE) {
+      png_set_palette_to_rgb(png);
+    }
+    if (colorType == PNG_COLOR_TYPE_GRAY && bitDepth < 8) {
+      png_set_expand_gray_1_2_4_to_8(png);
+    }
+    if (png_get_valid(png, info, PNG_INFO_tRNS)) {
+      png_set_tRNS_to_alpha(png);
+    }
+    if (bitDepth == 16 && sizeof(T) == 1) {
+      png_set_strip_16(png);
+    }
+    if (bitDepth == 16 && sizeof(T) != 1 && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) {
+      png_set_swap(png);  // PNG stores 16Bit samples big-endian
+    }
+    const int passes = png_set_interlace_handling(png);
+    png_read_update_info(png, info);
+
+    width = png_get_image_width(png, info);
+    height = png_get_image_height(png, info);
+    channels = png_get_channels(png, info);
+    const size_t rowBytes = png_get_rowbytes(png, info);
+    const uint64_t planeSize = static_cast<uint64_t>(width) * height;
+
+    buffer = std::make_shared<S>(planeSize * channels);
+    if (passes > 1) {
+      rows.resize(rowBytes * height);
+      rowPointers.resize(height);
+      for (uint32_t y = 0; y < height; ++y) {
+        rowPointers[y] = rows.data() + y * rowBytes;
+      }
+      png_read_image(png, rowPointers.data());
+      for (uint32_t y = 0; y < height; ++y) {
+        store(rowPointers[y], y, planeSize, png_get_bit_depth(png, info) == 16);
+      }
+    } else {
+      rows.resize(rowBytes);
+      for (uint32_t y = 0; y < height; ++y) {
+        png_read_row(png, rows.data(), nullptr);
+        store(rows.data(), y, planeSize, png_get_bit_depth(png, info) == 16);
+      }
+    }
+
+    png_read_end(png, nullptr);
+    return true;
+  }
+
+  void store(const png_byte *row, const uint32_t y, const uint64_t planeSize, const bool is16Bit) {
+    if (is16Bit) {
+      storeRow(reinterpret_cast<const uint16_t *>(row), buffer->data(), y, width, channels, planeSize, layout);
+    } else {
+      storeRow(row, buffer->data(), y, width, channels, planeSize, layout);
+    }
+  }
+};
+
+/// \brief decodes a JPEG image into a planar or interleaved buffer, optionally scaled down in the DCT domain
+/// \see PngDecoder
+template <typename T, typename S>
+struct JpegDecoder {
+  std::shared_ptr<S> buffer;
+  std::vector<JSAMPLE> row;
+  Layout layout = Layout::kPlanar;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  uint32_t channels = 0;
+
+  bool decode(jpeg_decompress_struct &cinfo, JpegErrorManager &error, FILE *fp, const uint32_t scaleDenominator) {
+    if (setjmp(error.jump)) {
+      return false;
+    }
+
+    jpeg_stdio_src(&cinfo, fp);
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scaleDenominator;
+    jpeg_start_decompress(&cinfo);
+
+    width = cinfo.output_width;
+    height = cinfo.output_height;
+    channels = cinfo.output_components;
+    const uint64_t planeSize = static_cast<uint64_t>(width) * height;
+
+    buffer = std::make_shared<S>(planeSize * channels);
+    row.resize(static_cast<size_t>(width) * channels);
+    while (cinfo.output_scanline < height) {
+      const uint32_t y = cinfo.output_scanline;
+      JSAMPROW rowPtr = row.data();
+      jpeg_read_scanlines(&cinfo, &rowPtr, 1);
+      storeRow(row.data(), buffer->data(), y, width, channels, planeSize, layout);
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    return true;
+  }
+};
+
+}  // namespace
+
+/// \brief create an image with a cleared image buffer
+/// \param width(const uint32_t) image width in pixels
+/// \param height(const uint32_t) image height in pixels
+/// \param channels(const uint32_t) number of image channels
+/// \param layout(const Layout) memory layout of the image buffer
+template <typename T>
+BasicImage<T>::BasicImage(const uint32_t width, const uint32_t height, const uint32_t channels, const Layout layout)
+    : imgWidth(width), imgHeight(height), imgChannels(channels), imgLayout(layout), imgBufferPtr(std::make_shared<StorageT>(static_cast<size_t>(width) * height * channels)) {}
+
+/// \brief create an image using the buffer provided as storage, which allows to reuse buffers between images
+/// The buffer is grown if it is too small for the image, its content is kept otherwise.
+/// \param width(const uint32_t) image width in pixels
+/// \param height(const uint32_t) image height in pixels
+/// \param channels(const uint32_t) number of image channels
+/// \param buffer(StoragePtr) storage of the image buffer
+/// \param layout(const Layout) memory layout of the image buffer
+template <typename T>
+BasicImage<T>::BasicImage(const uint32_t width, const uint32_t height, const uint32_t channels, StoragePtr buffer, const Layout layout)
+    : imgWidth(width), imgHeight(height), imgChannels(channels), imgLayout(layout), imgBufferPtr(buffer ? buffer : std::make_shared<StorageT>()) {
+  const size_t numElements = static_cast<size_t>(width) * height * channels;
+  if (imgBufferPtr->size() < numElements) {
+    imgBufferPtr->resize(numElements);
+  }
+}
+
 /// \brief Calculate an offset into the image buffer using image coordinates
 /// \param img_x (const uint32_t) x-position of the pixel in the image
 /// \param img_y (const uint32_t) y-position of the pixel in the image
 /// \param img_c (const uint32_t) channel of the pixel in the image
-/// \return (uint32_t) the offset into the image buffer to lookup the pixel data
-uint32_t Image::calcImageBufferOffset(const uint32_t img_x, const uint32_t img_y, const uint32_t img_c) const {
-  return pixels() * img_c + width() * img_y + img_x;
+/// \return (uint64_t) the offset into the image buffer to lookup the pixel data
+template <typename T>
+uint64_t BasicImage<T>::calcImageBufferOffset(const uint32_t img_x, const uint32_t img_y, const uint32_t img_c) const {
+  if (imgLayout == Layout::kInterleaved) {
+    return (static_cast<uint64_t>(width()) * img_y + img_x) * channels() + img_c;
+  }
+  return pixels() * img_c + static_cast<uint64_t>(width()) * img_y + img_x;
+}
+
+/// \brief convert the image buffer into the layout provided
+/// The pixels are converted into a new image buffer, images sharing the previous buffer are not affected.
+/// \param layout(const Layout) memory layout of the image buffer
+template <typename T>
+void BasicImage<T>::convert(const Layout layout) {
+  if (layout == imgLayout || !imgBufferPtr) {
+    imgLayout = layout;
+    return;
+  }
+
+  auto buffer = std::make_shared<StorageT>(pixels() * channels());
+  if (layout == Layout::kInterleaved) {
+    planarToInterleaved(imgBufferPtr->data(), buffer->data(), pixels(), channels(), pixels());
+  } else {
+    interleavedToPlanar(imgBufferPtr->data(), buffer->data(), pixels(), channels(), pixels());
+  }
+  imgBufferPtr = buffer;
+  imgLayout = layout;
 }
 
 /// \brief read image at the path provided into the image buffer
+/// The format is detected from the file content: raw tensors are mapped using readRaw(), PNG and JPEG files are decoded
+/// directly into the image buffer using readPng() and readJpeg(), all other files are decoded by CImg.
 /// \param path(const fs::path &) path to image on disk
+/// \param layout(const Layout) memory layout of the image buffer
 /// \return true on success, false otherwise
-bool Image::read(const fs::path &path) {
+template <typename T>
+bool BasicImage<T>::read(const fs::path &path, const Layout layout) {
   if (!fs::exists(path)) {
     spdlog::error("File {} doesn't exist.", path.c_str());
     return false;
   }
 
-  CImg<uint8_t> image(path.c_str());
+  switch (detectFormat(path)) {
+    case Format::kRaw:
+      if (!readRaw(path)) {
+        return false;
+      }
+      convert(layout);
+      return true;
+    case Format::kPng:
+      return readPng(path, layout);
+    case Format::kJpeg:
+      return readJpeg(path, 1, layout);
+    default:
+      break;
+  }
+
+  CImg<T> image(path.c_str());
   imgWidth = image.width();
   imgHeight = image.height();
   imgChannels = image.spectrum();
 
-  const uint32_t numElements = imgWidth * imgHeight * imgChannels;
+  const size_t numElements = static_cast<size_t>(imgWidth) * imgHeight * imgChannels;
   imgBufferPtr = std::make_shared<StorageT>(numElements);
-  StorageT &imgBuffer = *imgBufferPtr;
-  memcpy(imgBuffer.data(), image.data(), numElements);
+  memcpy(imgBufferPtr->data(), image.data(), numElements * sizeof(T));
+  imgLayout = Layout::kPlanar;
+  // converting replaces the buffer
+  convert(layout);
 
-  spdlog::info("Read image {} {}x{}x{} {} Byte", path.c_str(), width(), height(), channels(), imgBuffer.size());
+  spdlog::info("Read image {} {}x{}x{} {} Byte", path.c_str(), width(), height(), channels(), imgBufferPtr->size() * sizeof(T));
   return true;
 }
 
@@ -42,20 +299,273 @@ bool Image::read(const fs::path &path) {
 /// \param path(const fs::path &) path on filesystem to write image
 /// \param oc(const uint32_t) output channel to write
 /// \return true on success, false otherwise
-bool Image::write(const fs::path &path, const uint32_t oc) const {
-  CImg<uint8_t> image(width(), height(), 1, 1);
+template <typename T>
+bool BasicImage<T>::write(const fs::path &path, const uint32_t oc) const {
+  if (std::is_integral_v<T> && path.extension() == ".png") {
+    return writePng(path, oc, 1);
+  }
+
+  CImg<T> image(width(), height(), 1, 1);
 
   for (uint32_t img_y = 0; img_y < height(); ++img_y) {
     for (uint32_t img_x = 0; img_x < width(); ++img_x) {
-      uint32_t read = calcImageBufferOffset(img_x, img_y, oc);
+      uint64_t read = calcImageBufferOffset(img_x, img_y, oc);
       image(img_x, img_y, 0, 0) = (*imgBufferPtr)[read];
     }
   }
 
   image.save(path.c_str());
-  spdlog::info("Write image {} {}x{}x{} {} Byte", path.c_str(), width(), height(), 1, width() * height());
+  spdlog::info("Write image {} {}x{}x{} {} Byte", path.c_str(), width(), height(), 1, width() * height() * sizeof(T));
+  return true;
+}
+
+/// \brief decode a PNG file directly into the planar image buffer
+/// Palette and low bit depth images are expanded to 8Bit, transparency is expanded to an alpha channel. 16Bit images
+/// keep their precision unless the image data type is 8Bit. The rows are decoded one by one and deinterleaved into the
+/// image buffer, only interlaced images are decoded as a whole first.
+/// \param path(const fs::path &) path to image on disk
+/// \param layout(const Layout) memory layout of the image buffer, interleaved rows are stored without conversion
+/// \return true on success, false otherwise
+template <typename T>
+bool BasicImage<T>::readPng(const fs::path &path, const Layout layout) {
+  FILE *fp = fopen(path.c_str(), "rb");
+  if (!fp) {
+    spdlog::error("Failed to open {}: {}", path.c_str(), std::strerror(errno));
+    return false;
+  }
+
+  png_structp png = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  png_infop info = png ? png_create_info_struct(png) : nullptr;
+  if (!info) {
+    spdlog::error("Failed to initialize libpng.");
+    png_destroy_read_struct(&png, nullptr, nullptr);
+    fclose(fp);
+    return false;
+  }
+
+  PngDecoder<T, StorageT> decoder;
+  decoder.layout = layout;
+  const bool success = decoder.decode(png, info, fp);
+  png_destroy_read_struct(&png, &info, nullptr);
+  fclose(fp);
+  if (!success) {
+    spdlog::error("Failed to decode PNG {}.", path.c_str());
+    return false;
+  }
+
+  imgWidth = decoder.width;
+  imgHeight = decoder.height;
+  imgChannels = decoder.channels;
+  imgLayout = layout;
+  imgBufferPtr = decoder.buffer;
+
+  spdlog::info("Read PNG {} {}x{}x{} {} Byte", path.c_str(), width(), height(), channels(), imgBufferPtr->size() * sizeof(T));
+  return true;
+}
+
+/// \brief decode a JPEG file directly into the planar image buffer
+/// The scanlines are decoded one by one and deinterleaved into the image buffer. libjpeg can scale the image down
+/// while decoding in the DCT domain, which is considerably faster than decoding the full resolution.
+/// \param path(const fs::path &) path to image on disk
+/// \param scaleDenominator(const uint32_t) the image is scaled by 1 / scaleDenominator, one of 1, 2, 4 or 8
+/// \param layout(const Layout) memory layout of the image buffer, interleaved scanlines are stored without conversion
+/// \return true on success, false otherwise
+template <typename T>
+bool BasicImage<T>::readJpeg(const fs::path &path, const uint32_t scaleDenominator, const Layout layout) {
+  if (scaleDenominator != 1 && scaleDenominator != 2 && scaleDenominator != 4 && scaleDenominator != 8) {
+    spdlog::error("JPEG scale 1/{} is not supported, use 1/1, 1/2, 1/4 or 1/8.", scaleDenominator);
+    return false;
+  }
+
+  FILE *fp = fopen(path.c_str(), "rb");
+  if (!fp) {
+    spdlog::error("Failed to open {}: {}", path.c_str(), std::strerror(errno));
+    return false;
+  }
+
+  jpeg_decompress_struct cinfo;
+  JpegErrorManager error;
+  cinfo.err = jpeg_std_error(&error.pub);
+  error.pub.error_exit = jpegErrorExit;
+  jpeg_create_decompress(&cinfo);
+
+  JpegDecoder<T, StorageT> decoder;
+  decoder.layout = layout;
+  const bool success = decoder.decode(cinfo, error, fp, scaleDenominator);
+  jpeg_destroy_decompress(&cinfo);
+  fclose(fp);
+  if (!success) {
+    spdlog::error("Failed to decode JPEG {}.", path.c_str());
+    return false;
+  }
+
+  imgWidth = decoder.width;
+  imgHeight = decoder.height;
+  imgChannels = decoder.channels;
+  imgLayout = layout;
+  imgBufferPtr = decoder.buffer;
+
+  spdlog::info("Read JPEG {} {}x{}x{} {} Byte", path.c_str(), width(), height(), channels(), imgBufferPtr->size() * sizeof(T));
+  return true;
+}
+
+/// \brief encode up to 4 consecutive channels of the image buffer into a single PNG file
+/// 1, 2, 3 or 4 channels are written as gray, gray with alpha, RGB or RGBA image. Each row is interleaved into a small
+/// row buffer and passed to the encoder, so that no copy of the image is made. Floating point images can't be encoded.
+/// \param path(const fs::path &) path on filesystem to write image
+/// \param firstChannel(const uint32_t) first channel to write
+/// \param numChannels(const uint32_t) number of channels to write, 1 to 4
+/// \param params(const PngParams &) compression level and row filters
+/// \return true on success, false otherwise
+template <typename T>
+bool BasicImage<T>::writePng(const fs::path &path, const uint32_t firstChannel, const uint32_t numChannels, const PngParams &params) const {
+  if constexpr (std::is_floating_point_v<T>) {
+    spdlog::error("Floating point images can't be written to PNG file {}.", path.c_str());
+    return false;
+  } else {
+    if (firstChannel + numChannels > channels()) {
+      spdlog::error("Channels {} to {} exceed the {} image channels.", firstChannel, firstChannel + numChannels, channels());
+      return false;
+    }
+
+    auto writer = PngWriter::create(path, width(), height(), numChannels, 8 * sizeof(T), params);
+    if (!writer) {
+      return false;
+    }
+
+    std::vector<T> row(static_cast<size_t>(width()) * numChannels);
+    const uint32_t stride = pixelStride();
+    for (uint32_t img_y = 0; img_y < height(); ++img_y) {
+      for (uint32_t c = 0; c < numChannels; ++c) {
+        const T *src = imgBufferPtr->data() + calcImageBufferOffset(0, img_y, firstChannel + c);
+        for (uint32_t img_x = 0; img_x < width(); ++img_x) {
+          row[img_x * numChannels + c] = src[img_x * stride];
+        }
+      }
+      if (!writer->writeRow(row.data())) {
+        return false;
+      }
+    }
+
+    if (!writer->finish()) {
+      return false;
+    }
+    spdlog::info("Write PNG {} {}x{}x{} {} Byte", path.c_str(), width(), height(), numChannels, pixels() * numChannels * sizeof(T));
+    return true;
+  }
+}
+
+/// \brief read an image in the raw tensor format
+/// The file is mapped copy-on-write and used as image buffer without a copy if the rows are not padded, i.e. the stride
+/// equals the width. Changes to the image buffer are not written back to the file.
+/// \param path(const fs::path &) path to image on disk
+/// \return true on success, false otherwise
+template <typename T>
+bool BasicImage<T>::readRaw(const fs::path &path) {
+  auto file = MappedFile::open(path);
+  if (!file) {
+    return false;
+  }
+
+  RawHeader header;
+  if (file->size() < sizeof(RawHeader)) {
+    spdlog::error("File {} is too small for a raw tensor header.", path.c_str());
+    return false;
+  }
+  memcpy(&header, file->data(), sizeof(RawHeader));
+
+  if (memcmp(header.magic, RawHeader::kMagic, sizeof(header.magic)) != 0 || header.version != RawHeader::kVersion) {
+    spdlog::error("File {} is not a raw tensor of version {}.", path.c_str(), RawHeader::kVersion);
+    return false;
+  }
+
+  if (header.type != getRawType<T>()) {
+    spdlog::error("Raw tensor {} has type {}, expected {}.", path.c_str(), static_cast<uint32_t>(header.type), static_cast<uint32_t>(getRawType<T>()));
+    return false;
+  }
+
+  const uint64_t numElements = static_cast<uint64_t>(header.stride) * header.height * header.channels;
+  if (header.stride < header.width || header.dataOffset % alignof(T) != 0 || header.dataOffset + numElements * sizeof(T) > file->size()) {
+    spdlog::error("Raw tensor {} {}x{}x{} with stride {} doesn't match the file size {} Byte.", path.c_str(), header.width, header.height, header.channels, header.stride, file->size());
+    return false;
+  }
+
+  imgWidth = header.width;
+  imgHeight = header.height;
+  imgChannels = header.channels;
+  imgLayout = Layout::kPlanar;
+
+  if (header.stride == header.width) {
+    // the mapping is used as image buffer, the allocator skips the initialization of the elements
+    imgBufferPtr = std::make_shared<StorageT>(numElements, MappedAllocator<T>(file, header.dataOffset));
+  } else {
+    imgBufferPtr = std::make_shared<StorageT>(pixels() * channels());
+    const T *src = reinterpret_cast<const T *>(file->data() + header.dataOffset);
+    for (uint64_t row = 0; row < static_cast<uint64_t>(height()) * channels(); ++row) {
+      memcpy(imgBufferPtr->data() + row * width(), src + row * header.stride, width() * sizeof(T));
+    }
+  }
+
+  spdlog::info("Read raw tensor {} {}x{}x{} {} Byte", path.c_str(), width(), height(), channels(), imgBufferPtr->size() * sizeof(T));
   return true;
 }
 
+/// \brief write all channels of the image buffer in the raw tensor format
+/// Raw tensors are planar, interleaved images are converted while writing.
+/// \param path(const fs::path &) path on filesystem to write image
+/// \return true on success, false otherwise
+template <typename T>
+bool BasicImage<T>::writeRaw(const fs::path &path) const {
+  BasicImage<T> out{};
+  if (!out.createRaw(path, width(), height(), channels())) {
+    return false;
+  }
+  if (imgLayout == Layout::kInterleaved) {
+    interleavedToPlanar(imgBufferPtr->data(), out.getImageBuffer()->data(), pixels(), channels(), pixels());
+  } else {
+    memcpy(out.getImageBuffer()->data(), imgBufferPtr->data(), pixels() * channels() * sizeof(T));
+  }
+  return true;
+}
+
+/// \brief create a file in the raw tensor format and map it as planar image buffer
+/// All changes to the image buffer are written to the file, e.g. the output of a convolution can be stored directly
+/// into the file. The file is complete once the image buffer is released.
+/// \param path(const fs::path &) path on filesystem to create the image, an existing file is replaced
+/// \param width(const uint32_t) image width in pixels
+/// \param height(const uint32_t) image height in pixels
+/// \param channels(const uint32_t) number of image channels
+/// \return true on success, false otherwise
+template <typename T>
+bool BasicImage<T>::createRaw(const fs::path &path, const uint32_t width, const uint32_t height, const uint32_t channels) {
+  const uint64_t numElements = static_cast<uint64_t>(width) * height * channels;
+  auto file = MappedFile::create(path, kRawDataOffset + numElements * sizeof(T));
+  if (!file) {
+    return false;
+  }
+
+  RawHeader header;
+  header.width = width;
+  header.height = height;
+  header.channels = channels;
+  header.type = getRawType<T>();
+  header.stride = width;
+  header.dataOffset = kRawDataOffset;
+  memcpy(file->data(), &header, sizeof(RawHeader));
+
+  imgWidth = width;
+  imgHeight = height;
+  imgChannels = channels;
+  imgLayout = Layout::kPlanar;
+  imgBufferPtr = std::make_shared<StorageT>(numElements, MappedAllocator<T>(file, kRawDataOffset));
+
+  spdlog::info("Create raw tensor {} {}x{}x{} {} Byte", path.c_str(), width, height, channels, file->size());
+  return true;
+}
+
+template class BasicImage<uint8_t>;
+template class BasicImage<uint16_t>;
+template class BasicImage<float>;
+
 }  // namespace io
 }  // namespace convolution
\ No newline at end of file
@@ -4,10 +4,15 @@
 #include <convolution/core/Filter.h>
 #include <convolution/core/logging.h>
 #include <convolution/core/math.h>
+#include <convolution/io/Layout.h>
+#include <convolution/io/MappedFile.h>
+#include <convolution/io/PngWriter.h>
+#include <convolution/io/RawFormat.h>
 
 #include <cstdint>
 #include <filesystem>
 #include <memory>
+#include <vector>
 
 #include "CImg.h"
 
@@ -17,31 +22,62 @@ namespace fs = std::filesystem;
 namespace convolution {
 namespace io {
 
-/// \class Image class to support reading and writing images from and to disk
-class Image {
+/// \class BasicImage class to support reading and writing images from and to disk
+/// Besides the formats supported by CImg, images can be read and written in the raw tensor format (.raw), which maps the
+/// file into the image buffer without a copy. PNG and JPEG files are decoded directly into the image buffer and integral
+/// images are encoded directly from the image buffer into PNG files. The image buffer is planar by default, decoders
+/// and producers of interleaved pixels can store them in the interleaved layout without conversion.
+/// \tparam T(typename) the C++ type used to represent a single channel pixel, instantiated for uint8_t, uint16_t and float
+template <typename T>
+class BasicImage {
  public:
-  using StorageT = std::vector<uint8_t>;  ///< storage type used to store a single channel pixel
+  using DataT = T;                  ///< the C++ type used to represent a single channel pixel
+  using StorageT = std::vector<T, MappedAllocator<T>>;  ///< storage type used to store a single channel pixel, may be placed in a mapped file
   using StoragePtr = std::shared_ptr<StorageT>;
 
  private:
-  uint32_t imgWidth = 0;              ///< image width in pixels
-  uint32_t imgHeight = 0;             ///< image height in pixels
-  uint32_t imgChannels = 0;           ///< number of image channels
-  StoragePtr imgBufferPtr = nullptr;  ///< image buffer in row-major format
+  uint32_t imgWidth = 0;               ///< image width in pixels
+  uint32_t imgHeight = 0;              ///< image height in pixels
+  uint32_t imgChannels = 0;            ///< number of image channels
+  Layout imgLayout = Layout::kPlanar;  ///< memory layout of the image buffer
+  StoragePtr imgBufferPtr = nullptr;   ///< image buffer in row-major format
 
  public:
-  bool read(const fs::path &path);
+  BasicImage() = default;
+  BasicImage(const uint32_t width, const uint32_t height, const uint32_t channels, const Layout layout = Layout::kPlanar);
+  BasicImage(const uint32_t width, const uint32_t height, const uint32_t channels, StoragePtr buffer, const Layout layout = Layout::kPlanar);
+
+  bool read(const fs::path &path, const Layout layout = Layout::kPlanar);
   bool write(const fs::path &path, const uint32_t oc) const;
+  bool writePng(const fs::path &path, const uint32_t firstChannel, const uint32_t numChannels, const PngParams &params = PngParams()) const;
+
+  bool readPng(const fs::path &path, const Layout layout = Layout::kPlanar);
+  bool readJpeg(const fs::path &path, const uint32_t scaleDenominator = 1, const Layout layout = Layout::kPlanar);
+  bool readRaw(const fs::path &path);
+  bool writeRaw(const fs::path &path) const;
+  bool createRaw(const fs::path &path, const uint32_t width, const uint32_t height, const uint32_t channels);
 
   uint32_t width() const { return imgWidth; };               ///< returns the width of the image in pixel
   uint32_t height() const { return imgHeight; };             ///< returns the height of the image in pixel
   uint32_t channels() const { return imgChannels; };         ///< returns the number of image channels
-  uint32_t pixels() const { return imgWidth * imgHeight; };  ///< returns the number of image pixels
+  uint64_t pixels() const { return static_cast<uint64_t>(imgWidth) * imgHeight; };  ///< returns the number of image pixels
+  Layout layout() const { return imgLayout; }                                         ///< returns the memory layout of the image buffer
+  uint32_t pixelStride() const { return imgLayout == Layout::kInterleaved ? imgChannels : 1; }  ///< returns the distance between horizontally adjacent pixels of a channel
+
+  void convert(const Layout layout);
 
   StoragePtr getImageBuffer() const { return imgBufferPtr; }  ///< returns the image buffer containing the pixel data
-  uint32_t calcImageBufferOffset(const uint32_t ix, const uint32_t iy, const uint32_t channel) const;
+  uint64_t calcImageBufferOffset(const uint32_t ix, const uint32_t iy, const uint32_t channel) const;
 };
 
+using Image = BasicImage<uint8_t>;     ///< 8Bit image
+using Image16 = BasicImage<uint16_t>;  ///< 16Bit image, e.g. read from 16Bit PNG files
+using ImageF = BasicImage<float>;      ///< single precision floating point image
+
+extern template class BasicImage<uint8_t>;
+extern template class BasicImage<uint16_t>;
+extern template class BasicImage<float>;
+
 }  // namespace io
 }  // namespace convolution
 
@@ -0,0 +1,93 @@
+#ifndef CONVOLUTION_IO_LAYOUT_H
+#define CONVOLUTION_IO_LAYOUT_H
+
+#include <cstdint>
+
+namespace convolution {
+namespace io {
+
+/// \brief memory layout of the pixels in an image buffer
+enum class Layout {
+  kPlanar,       ///< one plane per channel (CHW), the offset of a pixel is pixels * c + width * y + x
+  kInterleaved,  ///< the channels of a pixel are adjacent (HWC), the offset of a pixel is (width * y + x) * channels + c
+};
+
+/// \brief convert interleaved pixels into planes, kernel with the channel count resolved at compile time
+template <uint32_t kChannels, typename T, typename S>
+inline void interleavedToPlanarKernel(const S *src, T *dst, const uint64_t count, const uint64_t planeSize) {
+  for (uint32_t c = 0; c < kChannels; ++c) {
+    T *plane = dst + c * planeSize;
+    for (uint64_t i = 0; i < count; ++i) {
+      plane[i] = static_cast<T>(src[i * kChannels + c]);
+    }
+  }
+}
+
+/// \brief convert planes into interleaved pixels, kernel with the channel count resolved at compile time
+template <uint32_t kChannels, typename T, typename S>
+inline void planarToInterleavedKernel(const S *src, T *dst, const uint64_t count, const uint64_t planeSize) {
+  for (uint64_t i = 0; i < count; ++i) {
+    for (uint32_t c = 0; c < kChannels; ++c) {
+      dst[i * kChannels + c] = static_cast<T>(src[c * planeSize + i]);
+    }
+  }
+}
+
+/// \brief convert a run of interleaved pixels into planes
+/// The common channel counts 1 to 4 use kernels with a constant stride, which the compiler vectorizes using shuffles.
+/// \param src(const S *) count interleaved pixels with channels samples each
+/// \param dst(T *) first pixel of the run in the first plane
+/// \param count(const uint64_t) number of pixels to convert
+/// \param channels(const uint32_t) number of channels
+/// \param planeSize(const uint64_t) distance between the planes of the destination in elements
+template <typename T, typename S>
+void interleavedToPlanar(const S *src, T *dst, const uint64_t count, const uint32_t channels, const uint64_t planeSize) {
+  switch (channels) {
+    case 1:
+      return interleavedToPlanarKernel<1>(src, dst, count, planeSize);
+    case 2:
+      return interleavedToPlanarKernel<2>(src, dst, count, planeSize);
+    case 3:
+      return interleavedToPlanarKernel<3>(src, dst, count, planeSize);
+    case 4:
+      return interleavedToPlanarKernel<4>(src, dst, count, planeSize);
+    default:
+      for (uint32_t c = 0; c < channels; ++c) {
+        for (uint64_t i = 0; i < count; ++i) {
+          dst[c * planeSize + i] = static_cast<T>(src[i * channels + c]);
+        }
+      }
+  }
+}
+
+/// \brief convert a run of planar pixels into interleaved pixels
+/// \see interleavedToPlanar
+/// \param src(const S *) first pixel of the run in the first plane
+/// \param dst(T *) receives count interleaved pixels with channels samples each
+/// \param count(const uint64_t) number of pixels to convert
+/// \param channels(const uint32_t) number of channels
+/// \param planeSize(const uint64_t) distance between the planes of the source in elements
+template <typename T, typename S>
+void planarToInterleaved(const S *src, T *dst, const uint64_t count, const uint32_t channels, const uint64_t planeSize) {
+  switch (channels) {
+    case 1:
+      return planarToInterleavedKernel<1>(src, dst, count, planeSize);
+    case 2:
+      return planarToInterleavedKernel<2>(src, dst, count, planeSize);
+    case 3:
+      return planarToInterleavedKernel<3>(src, dst, count, planeSize);
+    case 4:
+      return planarToInterleavedKernel<4>(src, dst, count, planeSize);
+    default:
+      for (uint64_t i = 0; i < count; ++i) {
+        for (uint32_t c = 0; c < channels; ++c) {
+          dst[i * channels + c] = static_cast<T>(src[c * planeSize + i]);
+        }
+      }
+  }
+}
+
+}  // namespace io
+}  // namespace convolution
+
+#endif  // CONVOLUTION_IO_LAYOUT_H
@@ -0,0 +1,78 @@
+#include <convolution/io/MappedFile.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace convolution {
+namespace io {
+
+MappedFile::~MappedFile() {
+  if (ptr) {
+    munmap(ptr, length);
+  }
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+/// \brief map an existing file copy-on-write, so that the content is read without a copy and changes are not written back
+/// \param path(const fs::path &) path to the file on disk
+/// \return the mapped file on success, nullptr otherwise
+std::shared_ptr<MappedFile> MappedFile::open(const fs::path &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    spdlog::error("Failed to open {}: {}", path.c_str(), std::strerror(errno));
+    return nullptr;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    spdlog::error("Failed to map {}, file is empty or not accessible.", path.c_str());
+    close(fd);
+    return nullptr;
+  }
+
+  void *ptr = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  if (ptr == MAP_FAILED) {
+    spdlog::error("Failed to map {}: {}", path.c_str(), std::strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+
+  return std::shared_ptr<MappedFile>(new MappedFile(fd, static_cast<uint8_t *>(ptr), st.st_size));
+}
+
+/// \brief create a file of the size provided and map it shared, so that all changes are written to the file
+/// \param path(const fs::path &) path to the file on disk, an existing file is truncated
+/// \param size(const size_t) size of the file in bytes
+/// \return the mapped file on success, nullptr otherwise
+std::shared_ptr<MappedFile> MappedFile::create(const fs::path &path, const size_t size) {
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    spdlog::error("Failed to create {}: {}", path.c_str(), std::strerror(errno));
+    return nullptr;
+  }
+
+  if (ftruncate(fd, size) != 0) {
+    spdlog::error("Failed to resize {} to {} Byte: {}", path.c_str(), size, std::strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+
+  void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (ptr == MAP_FAILED) {
+    spdlog::error("Failed to map {}: {}", path.c_str(), std::strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+
+  return std::shared_ptr<MappedFile>(new MappedFile(fd, static_cast<uint8_t *>(ptr), size));
+}
+
+}  // namespace io
+}  // namespace convolution
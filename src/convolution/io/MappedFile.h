@@ -0,0 +1,120 @@
+#ifndef CONVOLUTION_IO_MAPPEDFILE_H
+#define CONVOLUTION_IO_MAPPEDFILE_H
+
+#include <convolution/core/logging.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace fs = std::filesystem;
+
+namespace convolution {
+namespace io {
+
+/// \class MappedFile
+/// \brief RAII wrapper of a file mapped into memory
+class MappedFile {
+ private:
+  int fd = -1;               ///< file descriptor of the mapped file
+  uint8_t *ptr = nullptr;    ///< first byte of the mapping
+  size_t length = 0;         ///< size of the mapping in bytes
+
+  MappedFile(int fd, uint8_t *ptr, size_t length) : fd(fd), ptr(ptr), length(length) {}
+
+ public:
+  MappedFile(const MappedFile &rhs) = delete;
+  MappedFile &operator=(const MappedFile &rhs) = delete;
+  ~MappedFile();
+
+  static std::shared_ptr<MappedFile> open(const fs::path &path);
+  static std::shared_ptr<MappedFile> create(const fs::path &path, const size_t size);
+
+  uint8_t *data() const { return ptr; }   ///< returns the first byte of the mapping
+  size_t size() const { return length; }  ///< returns the size of the mapping in bytes
+};
+
+/// \class MappedAllocator
+/// \brief allocator placing a container into a mapped file, so that the file content is used without a copy
+///
+///  The first allocation fitting into the mapping behind offset is served by the mapping, all other allocations use the heap.
+///  The mapping is served only once by an allocator and its copies, so a container regrown or copy-assigned with this
+///  allocator never aliases the file memory of another one. The elements constructed by the container right after it
+///  adopted the mapping are not initialized, i.e. they keep the content of the file, all later elements are value
+///  initialized as usual, e.g. by resize(). Copies of a container use the heap, moves keep the mapping.
+///
+/// \tparam T(typename) the C++ type of the elements
+template <typename T>
+class MappedAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  std::shared_ptr<MappedFile> file;           ///< the mapped file, nullptr for heap only allocators
+  size_t offset = 0;                          ///< offset of the container data in the mapping
+  std::shared_ptr<std::atomic<bool>> served;  ///< the mapping has been handed out, shared by all copies of the allocator
+  size_t adopted = 0;                         ///< number of elements still to be constructed with the content of the file
+
+  MappedAllocator() = default;
+  MappedAllocator(std::shared_ptr<MappedFile> f, const size_t o) : file(f), offset(o), served(std::make_shared<std::atomic<bool>>(false)) {}
+  template <typename U>
+  MappedAllocator(const MappedAllocator<U> &rhs) : file(rhs.file), offset(rhs.offset), served(rhs.served) {}
+
+  T *allocate(const size_t n) {
+    if (file && offset + n * sizeof(T) <= file->size() && !served->exchange(true)) {
+      adopted = n;
+      return reinterpret_cast<T *>(file->data() + offset);
+    }
+    return std::allocator<T>().allocate(n);
+  }
+
+  void deallocate(T *p, const size_t n) {
+    if (!isMapped(p)) {
+      std::allocator<T>().deallocate(p, n);
+    }
+  }
+
+  template <typename U, typename... Args>
+  void construct(U *p, Args &&...args) {
+    ::new (static_cast<void *>(p)) U(std::forward<Args>(args)...);
+  }
+
+  /// value initialization is skipped for the elements adopting the file content only
+  template <typename U>
+  void construct(U *p) {
+    if (adopted > 0 && isMapped(p)) {
+      --adopted;
+      return;
+    }
+    ::new (static_cast<void *>(p)) U();
+  }
+
+  MappedAllocator select_on_container_copy_construction() const { return MappedAllocator(); }
+
+  /// returns true if p points into the mapping
+  bool isMapped(const void *p) const {
+    const uint8_t *bytes = static_cast<const uint8_t *>(p);
+    return file && bytes >= file->data() && bytes < file->data() + file->size();
+  }
+
+  template <typename U>
+  bool operator==(const MappedAllocator<U> &rhs) const {
+    return file == rhs.file && offset == rhs.offset;
+  }
+
+  template <typename U>
+  bool operator!=(const MappedAllocator<U> &rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+}  // namespace io
+}  // namespace convolution
+
+#endif  // CONVOLUTION_IO_MAPPEDFILE_H
@@ -0,0 +1,106 @@
+#include <convolution/io/PngWriter.h>
+
+#include <png.h>
+
+#include <cerrno>
+#include <csetjmp>
+#include <cstring>
+
+namespace convolution {
+namespace io {
+
+PngWriter::~PngWriter() {
+  if (png) {
+    png_destroy_write_struct(&png, info ? &info : nullptr);
+  }
+  if (fp) {
+    fclose(fp);
+  }
+}
+
+/// \brief create a PNG file and write the image header, an existing file is replaced
+/// \param path(const fs::path &) path to the file on disk
+/// \param width(const uint32_t) image width in pixels
+/// \param height(const uint32_t) image height in pixels
+/// \param channels(const uint32_t) number of interleaved channels per pixel, 1 to 4
+/// \param bitDepth(const uint32_t) bits per sample, 8 or 16
+/// \param params(const PngParams &) compression level and row filters
+/// \return the writer on success, nullptr otherwise
+std::unique_ptr<PngWriter> PngWriter::create(const fs::path &path, const uint32_t width, const uint32_t height, const uint32_t channels, const uint32_t bitDepth, const PngParams &params) {
+  if (channels < 1 || channels > 4 || (bitDepth != 8 && bitDepth != 16) || params.compressionLevel < 0 || params.compressionLevel > 9) {
+    spdlog::error("PNG with {} channels of {}Bit and compression level {} is not supported.", channels, bitDepth, params.compressionLevel);
+    return nullptr;
+  }
+
+  std::unique_ptr<PngWriter> writer(new PngWriter());
+  writer->fp = fopen(path.c_str(), "wb");
+  if (!writer->fp) {
+    spdlog::error("Failed to create {}: {}", path.c_str(), std::strerror(errno));
+    return nullptr;
+  }
+
+  writer->png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  writer->info = writer->png ? png_create_info_struct(writer->png) : nullptr;
+  if (!writer->info || !writer->init(width, height, channels, bitDepth, params)) {
+    spdlog::error("Failed to write the PNG header of {}.", path.c_str());
+    return nullptr;
+  }
+  return writer;
+}
+
+/// \brief write the image header, libpng errors return to this function
+bool PngWriter::init(const uint32_t width, const uint32_t height, const uint32_t channels, const uint32_t bitDepth, const PngParams &params) {
+  if (setjmp(png_jmpbuf(png))) {
+    failed = true;
+    return false;
+  }
+
+  static constexpr int kColorTypes[] = {PNG_COLOR_TYPE_GRAY, PNG_COLOR_TYPE_GRAY_ALPHA, PNG_COLOR_TYPE_RGB, PNG_COLOR_TYPE_RGB_ALPHA};
+  png_init_io(png, fp);
+  png_set_compression_level(png, params.compressionLevel);
+  png_set_filter(png, PNG_FILTER_TYPE_BASE, static_cast<int>(params.filter));
+  png_set_IHDR(png, info, width, height, bitDepth, kColorTypes[channels - 1], PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+  png_write_info(png, info);
+  if (bitDepth == 16 && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) {
+    png_set_swap(png);  // PNG stores 16Bit samples big-endian
+  }
+  rows = height;
+  return true;
+}
+
+/// \brief encode the next row of the image
+/// \param row(const void *) width * channels interleaved samples
+/// \return true on success, false otherwise
+bool PngWriter::writeRow(const void *row) {
+  if (failed || rows == 0) {
+    spdlog::error("No more rows can be written to the PNG file.");
+    return false;
+  }
+
+  if (setjmp(png_jmpbuf(png))) {
+    failed = true;
+    return false;
+  }
+  png_write_row(png, static_cast<png_const_bytep>(row));
+  --rows;
+  return true;
+}
+
+/// \brief complete the file after all rows have been written
+/// \return true on success, false otherwise
+bool PngWriter::finish() {
+  if (failed || rows != 0) {
+    spdlog::error("PNG file is incomplete, {} rows are missing.", rows);
+    return false;
+  }
+
+  if (setjmp(png_jmpbuf(png))) {
+    failed = true;
+    return false;
+  }
+  png_write_end(png, nullptr);
+  return fflush(fp) == 0;
+}
+
+}  // namespace io
+}  // namespace convolution
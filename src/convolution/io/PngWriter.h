@@ -0,0 +1,64 @@
+#ifndef CONVOLUTION_IO_PNGWRITER_H
+#define CONVOLUTION_IO_PNGWRITER_H
+
+#include <convolution/core/logging.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+
+namespace fs = std::filesystem;
+
+struct png_struct_def;
+struct png_info_def;
+
+namespace convolution {
+namespace io {
+
+/// \brief PNG row filters tried by the encoder, the values match the libpng PNG_FILTER_* flags
+/// Restricting the filters trades compression ratio for encoding speed, kNone is the fastest.
+enum class PngFilter : uint32_t {
+  kNone = 0x08,     ///< no filtering
+  kSub = 0x10,      ///< difference to the left pixel
+  kUp = 0x20,       ///< difference to the pixel above
+  kAverage = 0x40,  ///< difference to the average of the left and above pixel
+  kPaeth = 0x80,    ///< difference to the Paeth predictor
+  kAll = 0xf8,      ///< adaptive selection of all filters per row
+};
+
+/// \brief encoder parameters of PNG files
+struct PngParams {
+  int32_t compressionLevel = 6;        ///< zlib compression level from 0 (fastest) to 9 (smallest)
+  PngFilter filter = PngFilter::kAll;  ///< row filters tried by the encoder
+};
+
+/// \class PngWriter
+/// \brief encodes a PNG file row by row from interleaved samples
+/// Gray, gray with alpha, RGB and RGBA images are written for 1, 2, 3 and 4 channels, using 8Bit or 16Bit samples.
+class PngWriter {
+ private:
+  FILE *fp = nullptr;             ///< file receiving the encoded image
+  png_struct_def *png = nullptr;  ///< libpng write state
+  png_info_def *info = nullptr;   ///< libpng image information
+  uint32_t rows = 0;              ///< number of rows still to be written
+  bool failed = false;            ///< libpng reported an error, no further rows are written
+
+  PngWriter() = default;
+  bool init(const uint32_t width, const uint32_t height, const uint32_t channels, const uint32_t bitDepth, const PngParams &params);
+
+ public:
+  PngWriter(const PngWriter &rhs) = delete;
+  PngWriter &operator=(const PngWriter &rhs) = delete;
+  ~PngWriter();
+
+  static std::unique_ptr<PngWriter> create(const fs::path &path, const uint32_t width, const uint32_t height, const uint32_t channels, const uint32_t bitDepth, const PngParams &params = PngParams());
+
+  bool writeRow(const void *row);
+  bool finish();
+};
+
+}  // namespace io
+}  // namespace convolution
+
+#endif  // CONVOLUTION_IO_PNGWRITER_H
@@ -0,0 +1,141 @@
+#include <convolution/io/RawFile.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace convolution {
+namespace io {
+
+RawFile::~RawFile() {
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+/// \brief open an existing raw tensor file for reading
+/// \param path(const fs::path &) path to the file on disk
+/// \return the raw tensor file on success, nullptr otherwise
+std::unique_ptr<RawFile> RawFile::open(const fs::path &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    spdlog::error("Failed to open {}: {}", path.c_str(), std::strerror(errno));
+    return nullptr;
+  }
+
+  RawHeader header;
+  struct stat st;
+  if (pread(fd, &header, sizeof(RawHeader), 0) != sizeof(RawHeader) || fstat(fd, &st) != 0) {
+    spdlog::error("Failed to read the raw tensor header of {}.", path.c_str());
+    close(fd);
+    return nullptr;
+  }
+
+  if (memcmp(header.magic, RawHeader::kMagic, sizeof(header.magic)) != 0 || header.version != RawHeader::kVersion) {
+    spdlog::error("File {} is not a raw tensor of version {}.", path.c_str(), RawHeader::kVersion);
+    close(fd);
+    return nullptr;
+  }
+
+  const uint64_t size = header.dataOffset + header.stride * header.height * header.channels * getRawTypeSize(header.type);
+  if (getRawTypeSize(header.type) == 0 || header.stride < header.width || size > static_cast<uint64_t>(st.st_size)) {
+    spdlog::error("Raw tensor {} {}x{}x{} with stride {} doesn't match the file size {} Byte.", path.c_str(), header.width, header.height, header.channels, header.stride, st.st_size);
+    close(fd);
+    return nullptr;
+  }
+
+  return std::unique_ptr<RawFile>(new RawFile(fd, header));
+}
+
+/// \brief create a raw tensor file with unpadded rows, an existing file is replaced
+/// \param path(const fs::path &) path to the file on disk
+/// \param width(const uint32_t) image width in pixels
+/// \param height(const uint32_t) image height in pixels
+/// \param channels(const uint32_t) number of image channels
+/// \param type(const RawType) data type of a single channel pixel
+/// \return the raw tensor file on success, nullptr otherwise
+std::unique_ptr<RawFile> RawFile::create(const fs::path &path, const uint32_t width, const uint32_t height, const uint32_t channels, const RawType type) {
+  int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    spdlog::error("Failed to create {}: {}", path.c_str(), std::strerror(errno));
+    return nullptr;
+  }
+
+  RawHeader header;
+  header.width = width;
+  header.height = height;
+  header.channels = channels;
+  header.type = type;
+  header.stride = width;
+  header.dataOffset = kRawDataOffset;
+
+  const uint64_t size = kRawDataOffset + static_cast<uint64_t>(width) * height * channels * getRawTypeSize(type);
+  if (pwrite(fd, &header, sizeof(RawHeader), 0) != sizeof(RawHeader) || ftruncate(fd, size) != 0) {
+    spdlog::error("Failed to create raw tensor {} {}x{}x{}: {}", path.c_str(), width, height, channels, std::strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+
+  return std::unique_ptr<RawFile>(new RawFile(fd, header));
+}
+
+uint64_t RawFile::calcFileOffset(const uint32_t x, const uint32_t y, const uint32_t c) const {
+  const uint64_t element = (static_cast<uint64_t>(c) * header.height + y) * header.stride + x;
+  return header.dataOffset + element * getRawTypeSize(header.type);
+}
+
+/// \brief read count pixels of a single row and channel starting at x
+/// \param dst(void *) destination of count elements of the raw tensor type
+/// \return true on success, false otherwise
+bool RawFile::read(const uint32_t x, const uint32_t y, const uint32_t c, const uint32_t count, void *dst) const {
+  if (x + count > header.width || y >= header.height || c >= header.channels) {
+    spdlog::error("Row segment {}+{} of row {} channel {} is outside of the raw tensor {}x{}x{}.", x, count, y, c, header.width, header.height, header.channels);
+    return false;
+  }
+
+  uint8_t *bytes = static_cast<uint8_t *>(dst);
+  size_t remaining = count * getRawTypeSize(header.type);
+  uint64_t offset = calcFileOffset(x, y, c);
+  while (remaining > 0) {
+    const ssize_t result = pread(fd, bytes, remaining, offset);
+    if (result <= 0) {
+      spdlog::error("Failed to read raw tensor row {} channel {}: {}", y, c, std::strerror(errno));
+      return false;
+    }
+    bytes += result;
+    offset += result;
+    remaining -= result;
+  }
+  return true;
+}
+
+/// \brief write count pixels of a single row and channel starting at x
+/// \param src(const void *) source of count elements of the raw tensor type
+/// \return true on success, false otherwise
+bool RawFile::write(const uint32_t x, const uint32_t y, const uint32_t c, const uint32_t count, const void *src) {
+  if (x + count > header.width || y >= header.height || c >= header.channels) {
+    spdlog::error("Row segment {}+{} of row {} channel {} is outside of the raw tensor {}x{}x{}.", x, count, y, c, header.width, header.height, header.channels);
+    return false;
+  }
+
+  const uint8_t *bytes = static_cast<const uint8_t *>(src);
+  size_t remaining = count * getRawTypeSize(header.type);
+  uint64_t offset = calcFileOffset(x, y, c);
+  while (remaining > 0) {
+    const ssize_t result = pwrite(fd, bytes, remaining, offset);
+    if (result <= 0) {
+      spdlog::error("Failed to write raw tensor row {} channel {}: {}", y, c, std::strerror(errno));
+      return false;
+    }
+    bytes += result;
+    offset += result;
+    remaining -= result;
+  }
+  return true;
+}
+
+}  // namespace io
+}  // namespace convolution
@@ -0,0 +1,44 @@
+#ifndef CONVOLUTION_IO_RAWFILE_H
+#define CONVOLUTION_IO_RAWFILE_H
+
+#include <convolution/core/logging.h>
+#include <convolution/io/RawFormat.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace fs = std::filesystem;
+
+namespace convolution {
+namespace io {
+
+/// \class RawFile
+/// \brief random access to row segments of a raw tensor file without reading the whole file into memory
+/// All offsets are computed using 64Bit, so that files larger than 4 GiB are supported.
+class RawFile {
+ private:
+  int fd = -1;       ///< file descriptor of the raw tensor file
+  RawHeader header;  ///< header of the raw tensor file
+
+  RawFile(int fd, const RawHeader &header) : fd(fd), header(header) {}
+  uint64_t calcFileOffset(const uint32_t x, const uint32_t y, const uint32_t c) const;
+
+ public:
+  RawFile(const RawFile &rhs) = delete;
+  RawFile &operator=(const RawFile &rhs) = delete;
+  ~RawFile();
+
+  static std::unique_ptr<RawFile> open(const fs::path &path);
+  static std::unique_ptr<RawFile> create(const fs::path &path, const uint32_t width, const uint32_t height, const uint32_t channels, const RawType type);
+
+  const RawHeader &getHeader() const { return header; }  ///< returns the header of the raw tensor file
+
+  bool read(const uint32_t x, const uint32_t y, const uint32_t c, const uint32_t count, void *dst) const;
+  bool write(const uint32_t x, const uint32_t y, const uint32_t c, const uint32_t count, const void *src);
+};
+
+}  // namespace io
+}  // namespace convolution
+
+#endif  // CONVOLUTION_IO_RAWFILE_H
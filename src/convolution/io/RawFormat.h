@@ -0,0 +1,69 @@
+#ifndef CONVOLUTION_IO_RAWFORMAT_H
+#define CONVOLUTION_IO_RAWFORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace convolution {
+namespace io {
+
+/// \brief pixel data types supported by the raw tensor format
+enum class RawType : uint32_t {
+  kUInt8 = 1,    ///< 8Bit unsigned integer
+  kUInt16 = 2,   ///< 16Bit unsigned integer
+  kFloat32 = 3,  ///< single precision floating point
+};
+
+/// \brief returns the raw tensor type of the C++ type provided
+template <typename T>
+constexpr RawType getRawType() {
+  static_assert(std::is_same_v<T, uint8_t> || std::is_same_v<T, uint16_t> || std::is_same_v<T, float>, "Unsupported raw tensor type");
+  if constexpr (std::is_same_v<T, uint8_t>) {
+    return RawType::kUInt8;
+  } else if constexpr (std::is_same_v<T, uint16_t>) {
+    return RawType::kUInt16;
+  } else {
+    return RawType::kFloat32;
+  }
+}
+
+/// \brief returns the size of a single channel pixel of the raw tensor type provided in bytes, 0 for unknown types
+constexpr size_t getRawTypeSize(const RawType type) {
+  switch (type) {
+    case RawType::kUInt8:
+      return sizeof(uint8_t);
+    case RawType::kUInt16:
+      return sizeof(uint16_t);
+    case RawType::kFloat32:
+      return sizeof(float);
+  }
+  return 0;
+}
+
+/// \brief header of the raw tensor format
+/// The header is followed by the planar pixel data at dataOffset, one plane per channel of height rows with stride
+/// elements each, using the native byte order. The data is aligned to kRawDataOffset bytes so that it can be mapped
+/// and used in place.
+struct RawHeader {
+  static constexpr char kMagic[4] = {'C', 'N', 'V', 'R'};
+  static constexpr uint32_t kVersion = 1;
+
+  char magic[4] = {kMagic[0], kMagic[1], kMagic[2], kMagic[3]};  ///< identifies the raw tensor format
+  uint32_t version = kVersion;                                    ///< version of the format
+  uint32_t width = 0;                                             ///< image width in pixels
+  uint32_t height = 0;                                            ///< image height in pixels
+  uint32_t channels = 0;                                          ///< number of image channels
+  RawType type = RawType::kUInt8;                                 ///< data type of a single channel pixel
+  uint64_t stride = 0;                                            ///< number of elements between the first pixels of two rows
+  uint64_t dataOffset = 0;                                        ///< offset of the pixel data from the start of the file in bytes
+};
+
+/// offset of the pixel data written by io::BasicImage
+constexpr uint64_t kRawDataOffset = 64;
+static_assert(sizeof(RawHeader) <= kRawDataOffset);
+
+}  // namespace io
+}  // namespace convolution
+
+#endif  // CONVOLUTION_IO_RAWFORMAT_H
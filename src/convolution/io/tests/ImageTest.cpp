@@ -8,6 +8,15 @@
 
 #include <boost/preprocessor/stringize.hpp>
 
+#include <jpeglib.h>
+#include <png.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
 #include "CImg.h"
 
 using namespace cimg_library;
@@ -30,6 +39,57 @@ CImg<uint8_t> createTestImage(uint32_t height, uint32_t width) {
   return img;
 }
 
+/// \brief encode interleaved 8Bit or 16Bit samples as PNG
+template <typename S>
+void writePng(const fs::path &path, const uint32_t width, const uint32_t height, const uint32_t channels, const std::vector<S> &samples, const bool interlaced = false) {
+  FILE *fp = fopen(path.c_str(), "wb");
+  ASSERT_NE(fp, nullptr);
+  png_structp png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+  png_infop info = png_create_info_struct(png);
+  png_init_io(png, fp);
+
+  const int colorType = channels == 1 ? PNG_COLOR_TYPE_GRAY : channels == 3 ? PNG_COLOR_TYPE_RGB : PNG_COLOR_TYPE_RGBA;
+  png_set_IHDR(png, info, width, height, 8 * sizeof(S), colorType, interlaced ? PNG_INTERLACE_ADAM7 : PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+  png_write_info(png, info);
+  if (sizeof(S) == 2) {
+    png_set_swap(png);
+  }
+
+  std::vector<png_bytep> rows(height);
+  for (uint32_t y = 0; y < height; ++y) {
+    rows[y] = reinterpret_cast<png_bytep>(const_cast<S *>(samples.data() + static_cast<size_t>(y) * width * channels));
+  }
+  png_write_image(png, rows.data());
+  png_write_end(png, nullptr);
+  png_destroy_write_struct(&png, &info);
+  fclose(fp);
+}
+
+/// \brief encode interleaved 8Bit samples as JPEG
+void writeJpeg(const fs::path &path, const uint32_t width, const uint32_t height, const uint32_t channels, const std::vector<uint8_t> &samples) {
+  FILE *fp = fopen(path.c_str(), "wb");
+  ASSERT_NE(fp, nullptr);
+  jpeg_compress_struct cinfo;
+  jpeg_error_mgr error;
+  cinfo.err = jpeg_std_error(&error);
+  jpeg_create_compress(&cinfo);
+  jpeg_stdio_dest(&cinfo, fp);
+  cinfo.image_width = width;
+  cinfo.image_height = height;
+  cinfo.input_components = channels;
+  cinfo.in_color_space = channels == 1 ? JCS_GRAYSCALE : JCS_RGB;
+  jpeg_set_defaults(&cinfo);
+  jpeg_set_quality(&cinfo, 95, TRUE);
+  jpeg_start_compress(&cinfo, TRUE);
+  while (cinfo.next_scanline < height) {
+    JSAMPROW row = const_cast<JSAMPLE *>(samples.data() + static_cast<size_t>(cinfo.next_scanline) * width * channels);
+    jpeg_write_scanlines(&cinfo, &row, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  fclose(fp);
+}
+
 }  // namespace
 
 TEST(ImageTest, TestImage) {
@@ -59,3 +119,313 @@ TEST(ImageTest, Read) {
   io::Image image{};
   ASSERT_TRUE(image.read(p));
 }
+
+TEST(ImageTest, Read16Bit) {
+  const uint32_t imgWidth = 17;
+  const uint32_t imgHeight = 13;
+  CImg<uint16_t> img(imgWidth, imgHeight, 1, 1);
+  for (uint32_t y = 0; y < imgHeight; ++y) {
+    for (uint32_t x = 0; x < imgWidth; ++x) {
+      img(x, y, 0, 0) = 256 * y + x;
+    }
+  }
+
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage16.png";
+  img.save(p.c_str());
+
+  io::Image16 image{};
+  ASSERT_TRUE(image.read(p));
+  ASSERT_EQ(image.channels(), 1u);
+  for (uint32_t y = 0; y < imgHeight; ++y) {
+    for (uint32_t x = 0; x < imgWidth; ++x) {
+      ASSERT_EQ((*image.getImageBuffer())[image.calcImageBufferOffset(x, y, 0)], 256 * y + x);
+    }
+  }
+}
+
+TEST(ImageTest, RawTensor) {
+  const uint32_t imgWidth = 17;
+  const uint32_t imgHeight = 13;
+  const uint32_t channels = 3;
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage16.raw";
+
+  // the image buffer of a created raw tensor is stored directly into the file
+  {
+    io::Image16 image{};
+    ASSERT_TRUE(image.createRaw(p, imgWidth, imgHeight, channels));
+    auto buffer = image.getImageBuffer();
+    ASSERT_TRUE(buffer->get_allocator().isMapped(buffer->data()));
+    for (uint32_t c = 0; c < channels; ++c) {
+      for (uint32_t y = 0; y < imgHeight; ++y) {
+        for (uint32_t x = 0; x < imgWidth; ++x) {
+          (*buffer)[image.calcImageBufferOffset(x, y, c)] = 1000 * c + 32 * y + x;
+        }
+      }
+    }
+  }
+  ASSERT_EQ(fs::file_size(p), io::kRawDataOffset + imgWidth * imgHeight * channels * sizeof(uint16_t));
+
+  // reading maps the file without a copy
+  io::Image16 image{};
+  ASSERT_TRUE(image.read(p));
+  ASSERT_EQ(image.width(), imgWidth);
+  ASSERT_EQ(image.height(), imgHeight);
+  ASSERT_EQ(image.channels(), channels);
+  auto buffer = image.getImageBuffer();
+  ASSERT_TRUE(buffer->get_allocator().isMapped(buffer->data()));
+  for (uint32_t c = 0; c < channels; ++c) {
+    for (uint32_t y = 0; y < imgHeight; ++y) {
+      for (uint32_t x = 0; x < imgWidth; ++x) {
+        ASSERT_EQ((*buffer)[image.calcImageBufferOffset(x, y, c)], 1000 * c + 32 * y + x);
+      }
+    }
+  }
+
+  // copies of a mapped image buffer are placed on the heap
+  io::Image16::StorageT copy = *buffer;
+  ASSERT_FALSE(copy.get_allocator().isMapped(copy.data()));
+  ASSERT_EQ(copy, *buffer);
+
+  // the mapping is served once, further allocations of the allocator and copy assignments use the heap
+  io::Image16::StorageT second(buffer->size(), buffer->get_allocator());
+  ASSERT_FALSE(second.get_allocator().isMapped(second.data()));
+  io::Image16::StorageT assigned(buffer->get_allocator());
+  assigned = *buffer;
+  ASSERT_FALSE(assigned.get_allocator().isMapped(assigned.data()));
+  ASSERT_EQ(assigned, *buffer);
+
+  // heap images are written with a single copy
+  fs::path q = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImage16Copy.raw";
+  io::Image16 heapImage(imgWidth, imgHeight, channels);
+  std::copy(buffer->begin(), buffer->end(), heapImage.getImageBuffer()->begin());
+  ASSERT_TRUE(heapImage.writeRaw(q));
+  io::Image16 copyImage{};
+  ASSERT_TRUE(copyImage.readRaw(q));
+  ASSERT_EQ(*copyImage.getImageBuffer(), *buffer);
+
+  // only the elements adopting the file keep its content, elements added later are value initialized
+  buffer->resize(10);
+  buffer->resize(20);
+  ASSERT_TRUE(buffer->get_allocator().isMapped(buffer->data()));
+  ASSERT_EQ((*buffer)[9], 9);
+  ASSERT_TRUE(std::all_of(buffer->begin() + 10, buffer->end(), [](const uint16_t v) { return v == 0; }));
+  buffer->clear();
+  buffer->resize(imgWidth);
+  ASSERT_TRUE(std::all_of(buffer->begin(), buffer->end(), [](const uint16_t v) { return v == 0; }));
+
+  // the pixel type must match
+  io::Image wrongType{};
+  ASSERT_FALSE(wrongType.readRaw(p));
+}
+
+TEST(ImageTest, RawTensorStride) {
+  const uint32_t imgWidth = 5;
+  const uint32_t imgHeight = 3;
+  const uint32_t stride = 8;
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageStride.raw";
+
+  // write a tensor with padded rows
+  io::RawHeader header;
+  header.width = imgWidth;
+  header.height = imgHeight;
+  header.channels = 1;
+  header.type = io::RawType::kUInt8;
+  header.stride = stride;
+  header.dataOffset = io::kRawDataOffset;
+  std::vector<uint8_t> data(io::kRawDataOffset + stride * imgHeight, 0xff);
+  memcpy(data.data(), &header, sizeof(header));
+  for (uint32_t y = 0; y < imgHeight; ++y) {
+    for (uint32_t x = 0; x < imgWidth; ++x) {
+      data[io::kRawDataOffset + y * stride + x] = 10 * y + x;
+    }
+  }
+  std::ofstream(p, std::ios::binary).write(reinterpret_cast<const char *>(data.data()), data.size());
+
+  // padded rows are copied into a packed image buffer
+  io::Image image{};
+  ASSERT_TRUE(image.read(p));
+  ASSERT_EQ(image.getImageBuffer()->size(), imgWidth * imgHeight);
+  for (uint32_t y = 0; y < imgHeight; ++y) {
+    for (uint32_t x = 0; x < imgWidth; ++x) {
+      ASSERT_EQ((*image.getImageBuffer())[image.calcImageBufferOffset(x, y, 0)], 10 * y + x);
+    }
+  }
+
+  // truncated files are rejected
+  std::ofstream(p, std::ios::binary).write(reinterpret_cast<const char *>(data.data()), data.size() - 1);
+  ASSERT_FALSE(image.read(p));
+}
+
+TEST(ImageTest, DecodePng) {
+  const uint32_t imgWidth = 19;
+  const uint32_t imgHeight = 11;
+  const uint32_t channels = 3;
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageDecode.png";
+
+  std::vector<uint8_t> rgb(imgWidth * imgHeight * channels);
+  for (size_t i = 0; i < rgb.size(); ++i) {
+    rgb[i] = (i * 37) % 251;
+  }
+
+  // interleaved rows are decoded into the planes of the image buffer, for progressive and interlaced images alike
+  for (const bool interlaced : {false, true}) {
+    writePng(p, imgWidth, imgHeight, channels, rgb, interlaced);
+    io::Image image{};
+    ASSERT_TRUE(image.read(p));
+    ASSERT_EQ(image.width(), imgWidth);
+    ASSERT_EQ(image.height(), imgHeight);
+    ASSERT_EQ(image.channels(), channels);
+    auto buffer = image.getImageBuffer();
+    for (uint32_t c = 0; c < channels; ++c) {
+      for (uint32_t y = 0; y < imgHeight; ++y) {
+        for (uint32_t x = 0; x < imgWidth; ++x) {
+          ASSERT_EQ((*buffer)[image.calcImageBufferOffset(x, y, c)], rgb[(y * imgWidth + x) * channels + c]);
+        }
+      }
+    }
+  }
+
+  // 16Bit samples keep their precision in 16Bit images and are reduced to the most significant byte otherwise
+  std::vector<uint16_t> gray(imgWidth * imgHeight);
+  for (size_t i = 0; i < gray.size(); ++i) {
+    gray[i] = 1000 + 251 * i;
+  }
+  writePng(p, imgWidth, imgHeight, 1, gray);
+  io::Image16 image16{};
+  ASSERT_TRUE(image16.read(p));
+  ASSERT_EQ(image16.channels(), 1);
+  ASSERT_EQ(std::vector<uint16_t>(image16.getImageBuffer()->begin(), image16.getImageBuffer()->end()), gray);
+
+  io::Image image8{};
+  ASSERT_TRUE(image8.readPng(p));
+  for (size_t i = 0; i < gray.size(); ++i) {
+    ASSERT_EQ((*image8.getImageBuffer())[i], gray[i] >> 8);
+  }
+}
+
+TEST(ImageTest, DecodeJpeg) {
+  const uint32_t imgWidth = 40;
+  const uint32_t imgHeight = 24;
+  const uint32_t channels = 3;
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageDecode.jpg";
+
+  std::vector<uint8_t> rgb(imgWidth * imgHeight * channels);
+  for (uint32_t y = 0; y < imgHeight; ++y) {
+    for (uint32_t x = 0; x < imgWidth; ++x) {
+      rgb[(y * imgWidth + x) * channels + 0] = 4 * x;
+      rgb[(y * imgWidth + x) * channels + 1] = 8 * y;
+      rgb[(y * imgWidth + x) * channels + 2] = 128;
+    }
+  }
+  writeJpeg(p, imgWidth, imgHeight, channels, rgb);
+
+  // JPEG is lossy, the smooth gradient is reproduced closely
+  io::Image image{};
+  ASSERT_TRUE(image.read(p));
+  ASSERT_EQ(image.width(), imgWidth);
+  ASSERT_EQ(image.height(), imgHeight);
+  ASSERT_EQ(image.channels(), channels);
+  auto buffer = image.getImageBuffer();
+  for (uint32_t c = 0; c < channels; ++c) {
+    for (uint32_t y = 0; y < imgHeight; ++y) {
+      for (uint32_t x = 0; x < imgWidth; ++x) {
+        ASSERT_NEAR((*buffer)[image.calcImageBufferOffset(x, y, c)], rgb[(y * imgWidth + x) * channels + c], 8);
+      }
+    }
+  }
+
+  // the image is scaled down while decoding
+  for (const uint32_t scale : {2, 4, 8}) {
+    io::Image scaled{};
+    ASSERT_TRUE(scaled.readJpeg(p, scale));
+    ASSERT_EQ(scaled.width(), (imgWidth + scale - 1) / scale);
+    ASSERT_EQ(scaled.height(), (imgHeight + scale - 1) / scale);
+    ASSERT_EQ(scaled.channels(), channels);
+    ASSERT_NEAR((*scaled.getImageBuffer())[scaled.calcImageBufferOffset(1, 1, 1)], 8 * (scale + scale / 2), 8);
+  }
+
+  io::Image invalid{};
+  ASSERT_FALSE(invalid.readJpeg(p, 3));
+}
+
+TEST(ImageTest, EncodePng) {
+  const uint32_t imgWidth = 23;
+  const uint32_t imgHeight = 9;
+  const uint32_t channels = 5;
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageEncode.png";
+
+  io::Image16 image(imgWidth, imgHeight, channels);
+  auto buffer = image.getImageBuffer();
+  for (size_t i = 0; i < buffer->size(); ++i) {
+    (*buffer)[i] = 257 * i;
+  }
+
+  // consecutive channels are packed into a single file, for all encoder parameters
+  for (const uint32_t numChannels : {1, 2, 3, 4}) {
+    for (const io::PngFilter filter : {io::PngFilter::kNone, io::PngFilter::kPaeth, io::PngFilter::kAll}) {
+      const io::PngParams params{numChannels == 1 ? 0 : 9, filter};
+      ASSERT_TRUE(image.writePng(p, 1, numChannels, params));
+      io::Image16 decoded{};
+      ASSERT_TRUE(decoded.read(p));
+      ASSERT_EQ(decoded.width(), imgWidth);
+      ASSERT_EQ(decoded.height(), imgHeight);
+      ASSERT_EQ(decoded.channels(), numChannels);
+      ASSERT_TRUE(std::equal(decoded.getImageBuffer()->begin(), decoded.getImageBuffer()->end(), buffer->begin() + image.pixels()));
+    }
+  }
+
+  ASSERT_FALSE(image.writePng(p, 2, 4));
+  ASSERT_FALSE(image.writePng(p, 0, 5));
+  ASSERT_FALSE(io::ImageF(imgWidth, imgHeight, 1).writePng(p, 0, 1));
+}
+
+TEST(ImageTest, Layout) {
+  const uint32_t imgWidth = 13;
+  const uint32_t imgHeight = 7;
+
+  // the conversion kernels cover the specialized and the generic channel counts
+  for (const uint32_t channels : {1, 2, 3, 4, 5}) {
+    io::Image16 planar(imgWidth, imgHeight, channels);
+    auto buffer = planar.getImageBuffer();
+    for (size_t i = 0; i < buffer->size(); ++i) {
+      (*buffer)[i] = i;
+    }
+
+    io::Image16 interleaved = planar;
+    interleaved.convert(io::Layout::kInterleaved);
+    ASSERT_EQ(interleaved.layout(), io::Layout::kInterleaved);
+    ASSERT_EQ(interleaved.pixelStride(), channels);
+    ASSERT_NE(interleaved.getImageBuffer(), buffer);
+    for (uint32_t c = 0; c < channels; ++c) {
+      for (uint32_t y = 0; y < imgHeight; ++y) {
+        for (uint32_t x = 0; x < imgWidth; ++x) {
+          ASSERT_EQ((*interleaved.getImageBuffer())[interleaved.calcImageBufferOffset(x, y, c)], (*buffer)[planar.calcImageBufferOffset(x, y, c)]);
+          ASSERT_EQ((*interleaved.getImageBuffer())[(y * imgWidth + x) * channels + c], (*buffer)[planar.calcImageBufferOffset(x, y, c)]);
+        }
+      }
+    }
+
+    interleaved.convert(io::Layout::kPlanar);
+    ASSERT_EQ(*interleaved.getImageBuffer(), *buffer);
+  }
+
+  // decoders store interleaved rows without conversion, raw tensors are converted to planes on writing
+  std::vector<uint8_t> rgb(imgWidth * imgHeight * 3);
+  for (size_t i = 0; i < rgb.size(); ++i) {
+    rgb[i] = (i * 13) % 256;
+  }
+  fs::path p = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageLayout.png";
+  writePng(p, imgWidth, imgHeight, 3, rgb);
+  io::Image image{};
+  ASSERT_TRUE(image.read(p, io::Layout::kInterleaved));
+  ASSERT_EQ(image.layout(), io::Layout::kInterleaved);
+  ASSERT_TRUE(std::equal(rgb.begin(), rgb.end(), image.getImageBuffer()->begin()));
+
+  fs::path q = fs::path(std::string(BOOST_PP_STRINGIZE(PROJECT_SOURCE_DIR))) / "images" / "TestImageLayout.raw";
+  ASSERT_TRUE(image.writeRaw(q));
+  io::Image raw{};
+  ASSERT_TRUE(raw.read(q));
+  ASSERT_EQ(raw.layout(), io::Layout::kPlanar);
+  image.convert(io::Layout::kPlanar);
+  ASSERT_EQ(*raw.getImageBuffer(), *image.getImageBuffer());
+}
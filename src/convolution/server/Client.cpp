@@ -0,0 +1,143 @@
+#include <convolution/io/Layout.h>
+#include <convolution/server/Client.h>
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace convolution {
+namespace server {
+
+Client::~Client() {
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+/// \brief connect to the server listening on the Unix domain socket at path
+/// \return the client on success, nullptr otherwise
+std::unique_ptr<Client> Client::connect(const fs::path &path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (path.native().size() >= sizeof(address.sun_path)) {
+    spdlog::error("Socket path {} exceeds {} characters.", path.c_str(), sizeof(address.sun_path) - 1);
+    return nullptr;
+  }
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+  int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    spdlog::error("Failed to create socket: {}", std::strerror(errno));
+    return nullptr;
+  }
+  if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0) {
+    spdlog::error("Failed to connect to {}: {}", path.c_str(), std::strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+  return std::unique_ptr<Client>(new Client(fd));
+}
+
+/// \brief convolve the image file at path, which is read by the server
+/// \param path(const fs::path &) path of the image file, relative paths are resolved by the server
+/// \param filterId(const uint32_t) id of a filter registered with the server
+/// \param output(io::Image &) receives the planar output with one channel per output channel of the filter
+/// \return true on success, false otherwise
+bool Client::convolve(const fs::path &path, const uint32_t filterId, io::Image &output) {
+  Request request;
+  request.type = RequestType::kConvolvePath;
+  request.filterId = filterId;
+  if (path.native().size() >= sizeof(request.path)) {
+    spdlog::error("Image path {} exceeds {} characters.", path.c_str(), sizeof(request.path) - 1);
+    return false;
+  }
+  std::strncpy(request.path, path.c_str(), sizeof(request.path) - 1);
+  return submit(request, -1, output);
+}
+
+/// \brief convolve the image, whose planar pixels are passed to the server as shared memory
+/// \param image(const io::Image &) the image to convolve
+/// \param filterId(const uint32_t) id of a filter registered with the server
+/// \param output(io::Image &) receives the planar output with one channel per output channel of the filter
+/// \return true on success, false otherwise
+bool Client::convolve(const io::Image &image, const uint32_t filterId, io::Image &output) {
+  const size_t size = image.pixels() * image.channels();
+  int imageFd = createSharedMemory("convolution-input", size);
+  if (imageFd < 0) {
+    return false;
+  }
+
+  void *pixels = mmap(nullptr, size, PROT_WRITE, MAP_SHARED, imageFd, 0);
+  if (pixels == MAP_FAILED) {
+    spdlog::error("Failed to map the shared memory of the image: {}", std::strerror(errno));
+    close(imageFd);
+    return false;
+  }
+  if (image.layout() == io::Layout::kInterleaved) {
+    io::interleavedToPlanar(image.getImageBuffer()->data(), static_cast<uint8_t *>(pixels), image.pixels(), image.channels(), image.pixels());
+  } else {
+    std::memcpy(pixels, image.getImageBuffer()->data(), size);
+  }
+  munmap(pixels, size);
+
+  Request request;
+  request.type = RequestType::kConvolveShared;
+  request.filterId = filterId;
+  request.width = image.width();
+  request.height = image.height();
+  request.channels = image.channels();
+  const bool success = submit(request, imageFd, output);
+  close(imageFd);
+  return success;
+}
+
+/// send the request and copy the output out of the shared memory of the response
+bool Client::submit(const Request &request, int imageFd, io::Image &output) {
+  Response response;
+  int outputFd = -1;
+  if (!sendMessage(fd, &request, sizeof(request), imageFd) || !receiveMessage(fd, &response, sizeof(response), &outputFd)) {
+    return false;
+  }
+
+  if (response.status != Status::kOk) {
+    spdlog::error("Server failed to convolve the image: {}", response.message);
+    if (outputFd >= 0) {
+      close(outputFd);
+    }
+    return false;
+  }
+
+  const size_t size = static_cast<size_t>(response.width) * response.height * response.channels;
+  struct stat st;
+  if (outputFd < 0 || fstat(outputFd, &st) != 0 || static_cast<size_t>(st.st_size) < size) {
+    spdlog::error("Server returned no output of {}x{}x{} pixels.", response.width, response.height, response.channels);
+    if (outputFd >= 0) {
+      close(outputFd);
+    }
+    return false;
+  }
+
+  void *pixels = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_SHARED, outputFd, 0) : nullptr;
+  close(outputFd);
+  if (pixels == MAP_FAILED) {
+    spdlog::error("Failed to map the shared memory of the output: {}", std::strerror(errno));
+    return false;
+  }
+
+  if (output.width() != response.width || output.height() != response.height || output.channels() != response.channels || output.layout() != io::Layout::kPlanar || !output.getImageBuffer()) {
+    output = io::Image(response.width, response.height, response.channels);
+  }
+  if (size > 0) {
+    std::memcpy(output.getImageBuffer()->data(), pixels, size);
+    munmap(pixels, size);
+  }
+  return true;
+}
+
+}  // namespace server
+}  // namespace convolution
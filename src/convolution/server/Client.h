@@ -0,0 +1,40 @@
+#ifndef CONVOLUTION_SERVER_CLIENT_H
+#define CONVOLUTION_SERVER_CLIENT_H
+
+#include <convolution/core/logging.h>
+#include <convolution/io/Image.h>
+#include <convolution/server/Protocol.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+namespace fs = std::filesystem;
+
+namespace convolution {
+namespace server {
+
+/// \class Client
+/// \brief connection to a convolution Server, the requests of a connection are processed in order
+class Client {
+ private:
+  int fd = -1;  ///< connected socket
+
+  explicit Client(int fd) : fd(fd) {}
+  bool submit(const Request &request, int imageFd, io::Image &output);
+
+ public:
+  Client(const Client &rhs) = delete;
+  Client &operator=(const Client &rhs) = delete;
+  ~Client();
+
+  static std::unique_ptr<Client> connect(const fs::path &path);
+
+  bool convolve(const fs::path &path, const uint32_t filterId, io::Image &output);
+  bool convolve(const io::Image &image, const uint32_t filterId, io::Image &output);
+};
+
+}  // namespace server
+}  // namespace convolution
+
+#endif  // CONVOLUTION_SERVER_CLIENT_H
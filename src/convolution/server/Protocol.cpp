@@ -0,0 +1,110 @@
+#include <convolution/server/Protocol.h>
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace convolution {
+namespace server {
+
+/// \brief send a message and optionally pass a file descriptor over a Unix domain socket
+/// The sockets use SOCK_SEQPACKET, so that every message is received as a whole.
+/// \param socket(int) connected socket
+/// \param message(const void *) message to send
+/// \param size(const size_t) size of the message in bytes
+/// \param fd(int) file descriptor passed along with the message, -1 to send the message only
+/// \return true on success, false otherwise
+bool sendMessage(int socket, const void *message, const size_t size, int fd) {
+  iovec iov{const_cast<void *>(message), size};
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+  if (fd >= 0) {
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+  }
+
+  ssize_t result;
+  do {
+    result = sendmsg(socket, &msg, MSG_NOSIGNAL);
+  } while (result < 0 && errno == EINTR);
+  if (result != static_cast<ssize_t>(size)) {
+    spdlog::error("Failed to send message: {}", result < 0 ? std::strerror(errno) : "truncated");
+    return false;
+  }
+  return true;
+}
+
+/// \brief receive a message and a file descriptor passed along with it
+/// \param socket(int) connected socket
+/// \param message(void *) receives the message
+/// \param size(const size_t) expected size of the message in bytes
+/// \param fd(int *) receives the file descriptor, -1 if none has been passed, the caller closes the descriptor
+/// \return true if a message of the expected size has been received, false at the end of the connection or on error
+bool receiveMessage(int socket, void *message, const size_t size, int *fd) {
+  iovec iov{message, size};
+  msghdr msg{};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  ssize_t result;
+  do {
+    result = recvmsg(socket, &msg, MSG_CMSG_CLOEXEC);
+  } while (result < 0 && errno == EINTR);
+
+  int received = -1;
+  for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+      std::memcpy(&received, CMSG_DATA(cmsg), sizeof(int));
+    }
+  }
+
+  if (result != static_cast<ssize_t>(size) || (msg.msg_flags & (MSG_TRUNC | MSG_CTRUNC))) {
+    if (received >= 0) {
+      close(received);
+    }
+    if (result != 0) {
+      spdlog::error("Failed to receive message: {}", result < 0 ? std::strerror(errno) : "unexpected size");
+    }
+    return false;
+  }
+
+  if (fd) {
+    *fd = received;
+  } else if (received >= 0) {
+    close(received);
+  }
+  return true;
+}
+
+/// \brief create an anonymous shared memory file of size bytes, which is passed to the peer as file descriptor
+/// \return the file descriptor on success, -1 otherwise
+int createSharedMemory(const char *name, const size_t size) {
+  int fd = memfd_create(name, MFD_CLOEXEC);
+  if (fd < 0) {
+    spdlog::error("Failed to create shared memory {}: {}", name, std::strerror(errno));
+    return -1;
+  }
+  if (ftruncate(fd, size) != 0) {
+    spdlog::error("Failed to resize shared memory {} to {} Byte: {}", name, size, std::strerror(errno));
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+}  // namespace server
+}  // namespace convolution
@@ -0,0 +1,60 @@
+#ifndef CONVOLUTION_SERVER_PROTOCOL_H
+#define CONVOLUTION_SERVER_PROTOCOL_H
+
+#include <convolution/core/logging.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace convolution {
+namespace server {
+
+/// \brief jobs accepted by the server
+enum class RequestType : uint32_t {
+  kConvolvePath = 1,    ///< convolve the image file at Request::path
+  kConvolveShared = 2,  ///< convolve the planar 8Bit pixels in the shared memory file descriptor attached to the request
+};
+
+/// \brief result of a job
+enum class Status : uint32_t {
+  kOk = 0,              ///< the planar output is attached to the response as shared memory file descriptor
+  kInvalidRequest = 1,  ///< the request is malformed
+  kUnknownFilter = 2,   ///< the filter id has not been registered with the server
+  kInvalidImage = 3,    ///< the image can't be read or doesn't match the filter
+  kFailed = 4,          ///< the convolution or the transfer of the output failed
+};
+
+/// \brief job sent by the client, optionally followed by a file descriptor of a shared memory buffer
+/// The server and the client run on the same host, all fields use the native byte order.
+struct Request {
+  static constexpr char kMagic[4] = {'C', 'N', 'V', 'J'};
+  static constexpr uint32_t kVersion = 1;
+
+  char magic[4] = {kMagic[0], kMagic[1], kMagic[2], kMagic[3]};  ///< identifies the protocol
+  uint32_t version = kVersion;                                    ///< version of the protocol
+  RequestType type = RequestType::kConvolvePath;                  ///< job to perform
+  uint32_t filterId = 0;                                          ///< id of a filter registered with the server
+  uint32_t width = 0;                                             ///< width of the shared memory image in pixels
+  uint32_t height = 0;                                            ///< height of the shared memory image in pixels
+  uint32_t channels = 0;                                          ///< number of channels of the shared memory image
+  char path[512] = {};                                            ///< null terminated path of the image file
+};
+
+/// \brief result sent by the server, followed by a shared memory file descriptor of the planar output on success
+struct Response {
+  Status status = Status::kOk;  ///< result of the job
+  uint32_t width = 0;           ///< width of the output in pixels
+  uint32_t height = 0;          ///< height of the output in pixels
+  uint32_t channels = 0;        ///< number of output channels
+  char message[256] = {};       ///< null terminated description of an error
+};
+
+bool sendMessage(int socket, const void *message, const size_t size, int fd = -1);
+bool receiveMessage(int socket, void *message, const size_t size, int *fd);
+
+int createSharedMemory(const char *name, const size_t size);
+
+}  // namespace server
+}  // namespace convolution
+
+#endif  // CONVOLUTION_SERVER_PROTOCOL_H
@@ -0,0 +1,280 @@
+#include <convolution/server/Server.h>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace convolution {
+namespace server {
+
+Server::Server(const fs::path &path, int fd, const int wake[2], const FilterMap &filters, const uint32_t threads)
+    : socketPath(path), listenFd(fd), wakeFds{wake[0], wake[1]}, filters(filters), numThreads(threads) {}
+
+Server::~Server() {
+  close(listenFd);
+  close(wakeFds[0]);
+  close(wakeFds[1]);
+  unlink(socketPath.c_str());
+}
+
+/// \brief create a server listening on a Unix domain socket, an existing socket file is replaced
+/// \param path(const fs::path &) path of the socket in the filesystem
+/// \param filters(const FilterMap &) filters served by their id, with column buffers aligned to kAlignment
+/// \param threads(const uint32_t) number of worker threads, 0 uses one thread per hardware thread
+/// \return the server on success, nullptr otherwise
+std::unique_ptr<Server> Server::create(const fs::path &path, const FilterMap &filters, const uint32_t threads) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (path.native().size() >= sizeof(address.sun_path)) {
+    spdlog::error("Socket path {} exceeds {} characters.", path.c_str(), sizeof(address.sun_path) - 1);
+    return nullptr;
+  }
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+  int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    spdlog::error("Failed to create socket: {}", std::strerror(errno));
+    return nullptr;
+  }
+
+  unlink(path.c_str());
+  if (bind(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+    spdlog::error("Failed to listen on {}: {}", path.c_str(), std::strerror(errno));
+    close(fd);
+    return nullptr;
+  }
+
+  int wake[2];
+  if (pipe2(wake, O_CLOEXEC | O_NONBLOCK) != 0) {
+    spdlog::error("Failed to create pipe: {}", std::strerror(errno));
+    close(fd);
+    unlink(path.c_str());
+    return nullptr;
+  }
+
+  const uint32_t numThreads = threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+  spdlog::info("Listening on {} with {} filters and {} workers.", path.c_str(), filters.size(), numThreads);
+  return std::unique_ptr<Server>(new Server(path, fd, wake, filters, numThreads));
+}
+
+/// \brief accept and serve connections until the server is stopped
+/// Connections being served when the server is stopped are shut down, their current job is completed.
+/// \return true if the server has been stopped, false on error
+bool Server::run() {
+  std::vector<Worker> workers(numThreads);
+  for (Worker &worker : workers) {
+    for (const auto &[id, filter] : filters) {
+      worker.convolvers[id] = std::make_unique<ConvolverT>(filter);
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for (Worker &worker : workers) {
+    threads.emplace_back(&Server::work, this, std::ref(worker));
+  }
+
+  bool success = true;
+  while (true) {
+    pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      spdlog::error("Failed to wait for connections: {}", std::strerror(errno));
+      success = false;
+      break;
+    }
+    if (fds[1].revents) {
+      break;
+    }
+
+    int connection = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (connection < 0) {
+      if (errno != EINTR && errno != EAGAIN && errno != ECONNABORTED) {
+        spdlog::warn("Failed to accept connection: {}", std::strerror(errno));
+      }
+      continue;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    pending.push_back(connection);
+    cv.notify_one();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+    for (int connection : active) {
+      shutdown(connection, SHUT_RDWR);
+    }
+    for (int connection : pending) {
+      close(connection);
+    }
+    pending.clear();
+    cv.notify_all();
+  }
+
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  spdlog::info("Stopped serving {} after {} jobs.", socketPath.c_str(), jobs.load());
+  return success;
+}
+
+/// \brief stop the server, may be called from any thread and from signal handlers
+void Server::stop() {
+  const char byte = 0;
+  [[maybe_unused]] const ssize_t result = write(wakeFds[1], &byte, 1);
+}
+
+/// serve pending connections until the server is stopped
+void Server::work(Worker &worker) {
+  while (true) {
+    int connection = -1;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cv.wait(lock, [this]() { return stopping || !pending.empty(); });
+      if (stopping) {
+        return;
+      }
+      connection = pending.front();
+      pending.pop_front();
+      active.insert(connection);
+    }
+
+    serve(worker, connection);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    active.erase(connection);
+    close(connection);
+  }
+}
+
+/// process the requests of a connection until the client closes it
+void Server::serve(Worker &worker, int connection) {
+  Request request;
+  int fd = -1;
+  while (receiveMessage(connection, &request, sizeof(request), &fd)) {
+    int outputFd = -1;
+    Response response;
+    try {
+      response = process(worker, request, fd, &outputFd);
+    } catch (...) {
+      // e.g. an overflow of the accumulators or an image too large to allocate, the connection stays open
+      response = Response();
+      response.status = Status::kFailed;
+      std::snprintf(response.message, sizeof(response.message), "The convolution failed with an exception.");
+      spdlog::warn("Job failed: {}", response.message);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+    const bool sent = sendMessage(connection, &response, sizeof(response), outputFd);
+    if (outputFd >= 0) {
+      close(outputFd);
+    }
+    if (!sent) {
+      return;
+    }
+  }
+}
+
+/// convolve the image of the request and return its output in a new shared memory buffer
+Response Server::process(Worker &worker, const Request &request, int fd, int *outputFd) {
+  Response response;
+  auto fail = [&response](const Status status, const auto &...args) {
+    response.status = status;
+    std::snprintf(response.message, sizeof(response.message), args...);
+    spdlog::warn("Job failed: {}", response.message);
+    return response;
+  };
+
+  if (std::memcmp(request.magic, Request::kMagic, sizeof(request.magic)) != 0 || request.version != Request::kVersion) {
+    return fail(Status::kInvalidRequest, "Request is not of protocol version %u.", Request::kVersion);
+  }
+
+  auto it = worker.convolvers.find(request.filterId);
+  if (it == worker.convolvers.end()) {
+    return fail(Status::kUnknownFilter, "Filter %u is not registered.", request.filterId);
+  }
+  ConvolverT &conv = *it->second;
+  const FilterPtr &filter = filters.at(request.filterId);
+
+  io::Image image;
+  if (request.type == RequestType::kConvolvePath) {
+    const char *path = request.path;
+    if (strnlen(path, sizeof(request.path)) == sizeof(request.path) || !image.read(path)) {
+      return fail(Status::kInvalidImage, "Failed to read the image file.");
+    }
+  } else if (request.type == RequestType::kConvolveShared) {
+    // the pixels are copied into the input buffer of the worker, the client may reuse its buffer right away
+    const size_t size = static_cast<size_t>(request.width) * request.height * request.channels;
+    struct stat st;
+    if (fd < 0 || size == 0 || fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < size) {
+      return fail(Status::kInvalidImage, "Shared memory doesn't contain an image of %ux%ux%u pixels.", request.width, request.height, request.channels);
+    }
+    if (worker.input.width() != request.width || worker.input.height() != request.height || worker.input.channels() != request.channels) {
+      worker.input = io::Image(request.width, request.height, request.channels);
+    }
+    void *pixels = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (pixels == MAP_FAILED) {
+      return fail(Status::kInvalidImage, "Failed to map the shared memory: %s", std::strerror(errno));
+    }
+    std::memcpy(worker.input.getImageBuffer()->data(), pixels, size);
+    munmap(pixels, size);
+    image = worker.input;
+  } else {
+    return fail(Status::kInvalidRequest, "Request type %u is not supported.", static_cast<uint32_t>(request.type));
+  }
+
+  if (image.channels() != filter->numInputChannels() * filter->numGroups()) {
+    return fail(Status::kInvalidImage, "Image has %u channels, filter %u expects %u.", image.channels(), request.filterId, filter->numInputChannels() * filter->numGroups());
+  }
+
+  conv.setImage(image);
+  if (!conv.convolve()) {
+    return fail(Status::kFailed, "Failed to convolve the image.");
+  }
+
+  const uint32_t numOutputChannels = filter->numOutputChannels();
+  if (worker.output.width() != image.width() || worker.output.height() != image.height() || worker.output.channels() != numOutputChannels) {
+    worker.output = io::Image(image.width(), image.height(), numOutputChannels);
+  }
+  if (!conv.store(worker.output, 0, 0)) {
+    return fail(Status::kFailed, "Failed to store the output.");
+  }
+
+  const size_t size = worker.output.pixels() * numOutputChannels;
+  int fdOut = createSharedMemory("convolution-output", size);
+  if (fdOut < 0) {
+    return fail(Status::kFailed, "Failed to create the shared memory of the output.");
+  }
+  void *pixels = mmap(nullptr, size, PROT_WRITE, MAP_SHARED, fdOut, 0);
+  if (pixels == MAP_FAILED) {
+    close(fdOut);
+    return fail(Status::kFailed, "Failed to map the shared memory of the output: %s", std::strerror(errno));
+  }
+  std::memcpy(pixels, worker.output.getImageBuffer()->data(), size);
+  munmap(pixels, size);
+
+  *outputFd = fdOut;
+  response.width = worker.output.width();
+  response.height = worker.output.height();
+  response.channels = numOutputChannels;
+  ++jobs;
+  return response;
+}
+
+}  // namespace server
+}  // namespace convolution
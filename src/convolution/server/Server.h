@@ -0,0 +1,83 @@
+#ifndef CONVOLUTION_SERVER_SERVER_H
+#define CONVOLUTION_SERVER_SERVER_H
+
+#include <convolution/core/Convolver.h>
+#include <convolution/core/Filter.h>
+#include <convolution/core/logging.h>
+#include <convolution/io/Image.h>
+#include <convolution/server/Protocol.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace fs = std::filesystem;
+
+namespace convolution {
+namespace server {
+
+/// alignment of the filters served, the column buffers of the registered filters must use the same alignment
+constexpr uint32_t kAlignment = 4;
+
+/// \class Server
+/// \brief long-running convolution service listening on a Unix domain socket
+///
+///  The filters are registered when the server is created and packed once. Each worker thread owns a convolver per
+///  filter, whose column and transform buffers are kept between jobs, so that a job only pays for the convolution.
+///  Every connection is served by a single worker, which processes its requests in order: the image is read from a
+///  file or from a shared memory buffer passed along with the request, and the planar output is returned as a shared
+///  memory file descriptor, so that no pixels are copied through the socket.
+class Server {
+ public:
+  using ConvolverT = core::Convolver<kAlignment, uint8_t, uint8_t>;  ///< the convolver used by the workers
+  using FilterPtr = std::shared_ptr<core::IFilter<uint8_t>>;         ///< filter registered with the server
+  using FilterMap = std::map<uint32_t, FilterPtr>;                   ///< filters by their id
+
+ private:
+  /// \brief state of a worker thread, which is kept between jobs
+  struct Worker {
+    std::map<uint32_t, std::unique_ptr<ConvolverT>> convolvers;  ///< convolver of each filter
+    io::Image input;                                             ///< buffer of the images received as shared memory
+    io::Image output;                                            ///< buffer of the output
+  };
+
+  fs::path socketPath;            ///< path of the socket in the filesystem
+  int listenFd = -1;              ///< listening socket
+  int wakeFds[2] = {-1, -1};      ///< pipe waking up the accept loop when the server is stopped
+  FilterMap filters;              ///< filters by their id
+  uint32_t numThreads = 0;        ///< number of worker threads
+  std::mutex mutex;               ///< protects the connections and the stopping flag
+  std::condition_variable cv;     ///< signals pending connections to the workers
+  std::deque<int> pending;        ///< accepted connections waiting for a worker
+  std::set<int> active;           ///< connections being served by a worker
+  bool stopping = false;          ///< the server is shutting down
+  std::atomic<uint64_t> jobs{0};  ///< number of jobs completed successfully
+
+  Server(const fs::path &path, int fd, const int wake[2], const FilterMap &filters, const uint32_t threads);
+  void work(Worker &worker);
+  void serve(Worker &worker, int connection);
+  Response process(Worker &worker, const Request &request, int fd, int *outputFd);
+
+ public:
+  Server(const Server &rhs) = delete;
+  Server &operator=(const Server &rhs) = delete;
+  ~Server();
+
+  static std::unique_ptr<Server> create(const fs::path &path, const FilterMap &filters, const uint32_t threads = 0);
+
+  bool run();
+  void stop();
+
+  uint64_t numJobs() const { return jobs; }  ///< returns the number of jobs completed successfully
+};
+
+}  // namespace server
+}  // namespace convolution
+
+#endif  // CONVOLUTION_SERVER_SERVER_H
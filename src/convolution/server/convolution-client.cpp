@@ -0,0 +1,39 @@
+#include <convolution/core/logging.h>
+#include <convolution/io/Image.h>
+#include <convolution/server/Client.h>
+
+#include <cstdlib>
+#include <cstring>
+
+using namespace convolution;
+
+int main(int argc, char **argv) {
+  const bool shared = argc == 6 && std::strcmp(argv[5], "--shared") == 0;
+  if (argc != 5 && !shared) {
+    spdlog::error("Usage: {} <socket> <filter id> <image> <output.raw> [--shared]", argv[0]);
+    spdlog::error("  the image is read by the server, or by the client and passed as shared memory with --shared");
+    return EXIT_FAILURE;
+  }
+
+  auto client = server::Client::connect(argv[1]);
+  if (!client) {
+    return EXIT_FAILURE;
+  }
+
+  const uint32_t filterId = std::atoi(argv[2]);
+  io::Image output;
+  if (shared) {
+    io::Image image;
+    if (!image.read(argv[3]) || !client->convolve(image, filterId, output)) {
+      return EXIT_FAILURE;
+    }
+  } else if (!client->convolve(fs::absolute(argv[3]), filterId, output)) {
+    return EXIT_FAILURE;
+  }
+
+  if (!output.writeRaw(argv[4])) {
+    return EXIT_FAILURE;
+  }
+  spdlog::info("Convolved {} with filter {} into {} {}x{}x{}", argv[3], filterId, argv[4], output.width(), output.height(), output.channels());
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,50 @@
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/GroupedFilter.h>
+#include <convolution/core/logging.h>
+#include <convolution/server/Server.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <vector>
+
+using namespace convolution;
+
+namespace {
+
+server::Server *instance = nullptr;  ///< server stopped by SIGINT and SIGTERM
+
+void handleSignal(int) {
+  if (instance) {
+    instance->stop();
+  }
+}
+
+/// filters served by the daemon, 0 passes the color channels through, 1 and 2 are box filters of each channel
+server::Server::FilterMap createFilters() {
+  server::Server::FilterMap filters;
+  filters[0] = std::make_shared<core::DynamicFilter<uint8_t, server::kAlignment>>(1, 1, 3, 3, std::vector<uint8_t>{1, 0, 0, 0, 1, 0, 0, 0, 1});
+  filters[1] = core::GroupedFilter<uint8_t, server::kAlignment>::depthwise(3, 3, 3, std::vector<uint8_t>(3 * 3 * 3, 1));
+  filters[2] = core::GroupedFilter<uint8_t, server::kAlignment>::depthwise(5, 5, 3, std::vector<uint8_t>(5 * 5 * 3, 1));
+  return filters;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2 || argc > 3) {
+    spdlog::error("Usage: {} <socket> [threads]", argv[0]);
+    return EXIT_FAILURE;
+  }
+
+  auto server = server::Server::create(argv[1], createFilters(), argc > 2 ? std::atoi(argv[2]) : 0);
+  if (!server) {
+    return EXIT_FAILURE;
+  }
+
+  instance = server.get();
+  std::signal(SIGINT, handleSignal);
+  std::signal(SIGTERM, handleSignal);
+  const bool success = server->run();
+  instance = nullptr;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,153 @@
+#include <convolution/core/DynamicFilter.h>
+#include <convolution/core/GroupedFilter.h>
+#include <convolution/core/logging.h>
+#include <convolution/core/tests/TestResources.h>
+#include <convolution/io/Image.h>
+#include <convolution/server/Client.h>
+#include <convolution/server/Server.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace convolution;
+
+namespace {
+
+using FilterPtr = server::Server::FilterPtr;
+
+/// runs a server with three filters in a background thread
+class ServerTest : public ::testing::Test {
+ protected:
+  fs::path socketPath = fs::temp_directory_path() / ("ServerTest_" + std::to_string(getpid()) + ".sock");
+  server::Server::FilterMap filters;
+  std::unique_ptr<server::Server> server;
+  std::thread thread;
+  bool stopped = false;
+
+  void SetUp() override {
+    spdlog::set_level(spdlog::level::warn);
+    filters[1] = core::test::createFilter<server::kAlignment>(3, 3, 2, 23);
+    filters[7] = core::GroupedFilter<uint8_t, server::kAlignment>::depthwise(5, 5, 3, std::vector<uint8_t>(5 * 5 * 3, 1));
+    filters[9] = std::make_shared<core::DynamicFilter<uint8_t, server::kAlignment>>(3, 3, 3, 1, std::vector<uint8_t>(3 * 3 * 3, 255));
+    server = server::Server::create(socketPath, filters, 2);
+    ASSERT_TRUE(server);
+    thread = std::thread([this]() { stopped = server->run(); });
+  }
+
+  void TearDown() override {
+    server->stop();
+    thread.join();
+    ASSERT_TRUE(stopped);
+    server.reset();
+    ASSERT_FALSE(fs::exists(socketPath));
+  }
+};
+
+}  // namespace
+
+TEST_F(ServerTest, SharedMemory) {
+  auto client = server::Client::connect(socketPath);
+  ASSERT_TRUE(client);
+
+  // the connection is reused for several jobs of different sizes and filters
+  for (uint32_t i = 0; i < 3; ++i) {
+    const io::Image image = core::test::createImage(30 + i, 20 + 2 * i, 3, i);
+    io::Image output;
+    ASSERT_TRUE(client->convolve(image, 1, output));
+    ASSERT_EQ(output.channels(), 2u);
+    ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<server::kAlignment>(image, filters[1]));
+
+    ASSERT_TRUE(client->convolve(image, 7, output));
+    ASSERT_EQ(output.channels(), 3u);
+    ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<server::kAlignment>(image, filters[7]));
+  }
+
+  // interleaved images are passed as planar images
+  io::Image interleaved = core::test::createImage(17, 9, 3, 5);
+  const std::vector<uint8_t> expected = core::test::convolveImage<server::kAlignment>(interleaved, filters[1]);
+  interleaved.convert(io::Layout::kInterleaved);
+  io::Image output;
+  ASSERT_TRUE(client->convolve(interleaved, 1, output));
+  ASSERT_EQ(core::test::toVector(output), expected);
+  ASSERT_EQ(server->numJobs(), 7u);
+}
+
+TEST_F(ServerTest, ImageFile) {
+  const fs::path path = fs::temp_directory_path() / "ServerTest_image.raw";
+  const io::Image image = core::test::createImage(41, 13, 3, 9);
+  ASSERT_TRUE(image.writeRaw(path));
+
+  auto client = server::Client::connect(socketPath);
+  ASSERT_TRUE(client);
+  io::Image output;
+  ASSERT_TRUE(client->convolve(path, 1, output));
+  ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<server::kAlignment>(image, filters[1]));
+  fs::remove(path);
+
+  ASSERT_FALSE(client->convolve(path, 1, output));
+}
+
+TEST_F(ServerTest, InvalidJobs) {
+  auto client = server::Client::connect(socketPath);
+  ASSERT_TRUE(client);
+
+  io::Image output;
+  ASSERT_FALSE(client->convolve(core::test::createImage(8, 8, 3, 1), 2, output));
+  ASSERT_FALSE(client->convolve(core::test::createImage(8, 8, 1, 1), 1, output));
+
+  // the accumulators overflow for the largest weights on a bright image
+  io::Image bright(8, 8, 3);
+  std::fill(bright.getImageBuffer()->begin(), bright.getImageBuffer()->end(), 255);
+  ASSERT_FALSE(client->convolve(bright, 9, output));
+
+  // the connection remains usable after failed jobs
+  const io::Image image = core::test::createImage(8, 8, 3, 1);
+  ASSERT_TRUE(client->convolve(image, 1, output));
+  ASSERT_EQ(core::test::toVector(output), core::test::convolveImage<server::kAlignment>(image, filters[1]));
+  ASSERT_EQ(server->numJobs(), 1u);
+}
+
+TEST_F(ServerTest, ConcurrentClients) {
+  constexpr uint32_t numClients = 4;
+  constexpr uint32_t numJobs = 5;
+  const io::Image image = core::test::createImage(64, 48, 3, 3);
+  const std::vector<uint8_t> expected = core::test::convolveImage<server::kAlignment>(image, filters[7]);
+
+  std::vector<std::thread> threads;
+  std::vector<uint32_t> matches(numClients, 0);
+  for (uint32_t c = 0; c < numClients; ++c) {
+    threads.emplace_back([&, c]() {
+      auto client = server::Client::connect(socketPath);
+      if (!client) {
+        return;
+      }
+      io::Image output;
+      for (uint32_t j = 0; j < numJobs; ++j) {
+        if (client->convolve(image, 7, output) && core::test::toVector(output) == expected) {
+          ++matches[c];
+        }
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(matches, std::vector<uint32_t>(numClients, numJobs));
+  ASSERT_EQ(server->numJobs(), numClients * numJobs);
+}
+
+TEST_F(ServerTest, StopWithOpenConnection) {
+  // an idle connection doesn't block the shutdown of the server
+  auto client = server::Client::connect(socketPath);
+  ASSERT_TRUE(client);
+  io::Image output;
+  ASSERT_TRUE(client->convolve(core::test::createImage(8, 8, 3, 1), 1, output));
+}